@@ -73,7 +73,8 @@ endif
 
 $(TEST_OUTPUT)_SRC += \
 	tests/test_common/main.cpp \
-	$(QUANTUM_PATH)/logging/print.c
+	$(QUANTUM_PATH)/logging/print.c \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/gpio.c
 
 ifneq ($(strip $(INTROSPECTION_KEYMAP_C)),)
 $(TEST_OUTPUT)_DEFS += -DINTROSPECTION_KEYMAP_C=\"$(strip $(INTROSPECTION_KEYMAP_C))\"
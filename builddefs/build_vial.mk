@@ -9,6 +9,8 @@ endif
 COMBO_ENABLE ?= yes
 KEY_OVERRIDE_ENABLE ?= yes
 SRC += $(QUANTUM_DIR)/vial.c
+# Snapshot packets are checksummed
+CRC_ENABLE := yes
 OPT_DEFS += -DVIAL_ENABLE -DNO_DEBUG -DSERIAL_NUMBER=\"vial:f64c2b3c\"
 
 ifeq ($(strip $(VIAL_INSECURE)), yes)
@@ -351,6 +351,7 @@ ifeq ($(strip $(LED_MATRIX_ENABLE)), yes)
     COMMON_VPATH += $(QUANTUM_DIR)/led_matrix
     COMMON_VPATH += $(QUANTUM_DIR)/led_matrix/animations
     COMMON_VPATH += $(QUANTUM_DIR)/led_matrix/animations/runners
+    COMMON_VPATH += $(DRIVER_PATH)/led
     POST_CONFIG_H += $(QUANTUM_DIR)/led_matrix/post_config.h
     SRC += $(QUANTUM_DIR)/process_keycode/process_backlight.c
     SRC += $(QUANTUM_DIR)/led_matrix/led_matrix.c
@@ -451,6 +452,7 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix
     COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix/animations
     COMMON_VPATH += $(QUANTUM_DIR)/rgb_matrix/animations/runners
+    COMMON_VPATH += $(DRIVER_PATH)/led
     POST_CONFIG_H += $(QUANTUM_DIR)/rgb_matrix/post_config.h
     SRC += $(QUANTUM_DIR)/color.c
     SRC += $(QUANTUM_DIR)/rgb_matrix/rgb_matrix.c
@@ -459,6 +461,14 @@ ifeq ($(strip $(RGB_MATRIX_ENABLE)), yes)
     CIE1931_CURVE := yes
     RGB_KEYCODES_ENABLE := yes
 
+    ifeq ($(strip $(RGB_MATRIX_ASYNC_FLUSH)), yes)
+        ifeq ($(filter $(PLATFORM_KEY),chibios test),)
+            $(call CATASTROPHIC_ERROR,Invalid RGB_MATRIX_ASYNC_FLUSH,RGB_MATRIX_ASYNC_FLUSH is not supported on this platform)
+        endif
+        OPT_DEFS += -DRGB_MATRIX_ASYNC_FLUSH
+        BACKGROUND_WORKER_REQUIRED = yes
+    endif
+
     ifeq ($(strip $(RGB_MATRIX_DRIVER)), aw20216s)
         SPI_DRIVER_REQUIRED = yes
         COMMON_VPATH += $(DRIVER_PATH)/led
@@ -572,6 +582,10 @@ ifeq ($(strip $(SLEEP_LED_ENABLE)), yes)
     NO_SUSPEND_POWER_DOWN := yes
 endif
 
+ifeq ($(strip $(IDLE_SLEEP_ENABLE)), yes)
+    SRC += $(PLATFORM_COMMON_DIR)/idle_sleep.c
+endif
+
 VALID_BACKLIGHT_TYPES := pwm timer software custom
 
 BACKLIGHT_ENABLE ?= no
@@ -691,7 +705,10 @@ ifeq ($(strip $(SPLIT_KEYBOARD)), yes)
         endif
 
         OPT_DEFS += -DSERIAL_DRIVER_$(strip $(shell echo $(SERIAL_DRIVER) | tr '[:lower:]' '[:upper:]'))
-        ifeq ($(strip $(SERIAL_DRIVER)), bitbang)
+        ifeq ($(strip $(PLATFORM_KEY)), test)
+            # Simulated link to an in-process slave half
+            QUANTUM_SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/split_sim.c
+        else ifeq ($(strip $(SERIAL_DRIVER)), bitbang)
             QUANTUM_LIB_SRC += serial.c
         else
             QUANTUM_LIB_SRC += serial_protocol.c
@@ -947,15 +964,29 @@ endif
 
 ifeq ($(strip $(I2C_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_I2C=TRUE
-    QUANTUM_LIB_SRC += i2c_master.c
+    ifeq ($(strip $(PLATFORM_KEY)), test)
+        # Transaction counting mock, there is no bus to talk to
+        QUANTUM_SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/i2c_master.c
+    else
+        QUANTUM_LIB_SRC += i2c_master.c
+    endif
 endif
 
 ifeq ($(strip $(SPI_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_SPI=TRUE
-    QUANTUM_LIB_SRC += spi_master.c
+    ifeq ($(strip $(PLATFORM_KEY)), test)
+        # Transaction recording mock, there is no bus to talk to
+        QUANTUM_SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/$(DRIVER_DIR)/spi_master.c
+    else
+        QUANTUM_LIB_SRC += spi_master.c
+    endif
 endif
 
 ifeq ($(strip $(UART_DRIVER_REQUIRED)), yes)
     OPT_DEFS += -DHAL_USE_SERIAL=TRUE
     QUANTUM_LIB_SRC += uart.c
 endif
+
+ifeq ($(strip $(BACKGROUND_WORKER_REQUIRED)), yes)
+    SRC += $(PLATFORM_PATH)/$(PLATFORM_KEY)/background_worker.c
+endif
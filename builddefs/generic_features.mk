@@ -33,8 +33,10 @@ GENERIC_FEATURES = \
     DYNAMIC_TAPPING_TERM \
     GRAVE_ESC \
     HAPTIC \
+    IDLE_SLEEP \
     KEY_LOCK \
     KEY_OVERRIDE \
+    LATENCY_TRACING \
     LEADER \
     MAGIC \
     MOUSEKEY \
@@ -48,6 +50,7 @@ GENERIC_FEATURES = \
     SPACE_CADET \
     SWAP_HANDS \
     TAP_DANCE \
+    TASK_PROFILING \
     TRI_LAYER \
     VIA \
     VIRTSER \
@@ -20,3 +20,13 @@
 
 void eeprom_driver_init(void);
 void eeprom_driver_erase(void);
+
+#if defined(EEPROM_WEAR_LEVELING) && (defined(WEAR_LEVELING_WRITEBACK_ENABLE) || defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION))
+// Logs data held back by the wear-leveling write-back cache once writes have been idle for a while, and performs
+// a step of any incremental consolidation
+void eeprom_driver_task(void);
+#endif
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITEBACK_ENABLE)
+// Logs data held back by the wear-leveling write-back cache immediately
+void eeprom_driver_flush(void);
+#endif
@@ -6,6 +6,17 @@
 #include "eeprom_driver.h"
 #include "wear_leveling.h"
 
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+#    include "timer.h"
+
+// How long writes have to stop before the held back data is logged
+#    ifndef WEAR_LEVELING_WRITEBACK_IDLE_MS
+#        define WEAR_LEVELING_WRITEBACK_IDLE_MS 2000
+#    endif
+
+static uint32_t last_write = 0;
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
+
 void eeprom_driver_init(void) {
     wear_leveling_init();
 }
@@ -20,4 +31,29 @@ void eeprom_read_block(void *buf, const void *addr, size_t len) {
 
 void eeprom_write_block(const void *buf, void *addr, size_t len) {
     wear_leveling_write((uint32_t)addr, buf, len);
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+    last_write = timer_read32();
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
+}
+
+#if defined(WEAR_LEVELING_WRITEBACK_ENABLE) || defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION)
+void eeprom_driver_task(void) {
+#    ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+    if (wear_leveling_sync_pending() && timer_elapsed32(last_write) >= (WEAR_LEVELING_WRITEBACK_IDLE_MS)) {
+        if (wear_leveling_sync() == WEAR_LEVELING_FAILED) {
+            // Back off rather than retrying every scan
+            last_write = timer_read32();
+        }
+        return;
+    }
+#    endif // WEAR_LEVELING_WRITEBACK_ENABLE
+    // One step per loop keeps each iteration short
+    wear_leveling_task();
+}
+#endif
+
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+void eeprom_driver_flush(void) {
+    wear_leveling_sync();
 }
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
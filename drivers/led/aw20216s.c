@@ -18,6 +18,7 @@
 #include "aw20216s.h"
 #include "wait.h"
 #include "spi_master.h"
+#include "led_dirty.h"
 
 #define AW20216S_PWM_REGISTER_COUNT 216
 
@@ -46,7 +47,7 @@
 #endif
 
 uint8_t g_pwm_buffer[AW20216S_DRIVER_COUNT][AW20216S_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[AW20216S_DRIVER_COUNT] = {false};
+uint8_t g_pwm_buffer_dirty[AW20216S_DRIVER_COUNT][LED_DIRTY_BITMAP_SIZE(AW20216S_PWM_REGISTER_COUNT)] = {0};
 
 bool aw20216s_write(pin_t cs_pin, uint8_t page, uint8_t reg, uint8_t* data, uint8_t len) {
     static uint8_t s_spi_transfer_buffer[2] = {0};
@@ -131,13 +132,9 @@ void aw20216s_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     aw20216s_led_t led;
     memcpy_P(&led, (&g_aw20216s_leds[index]), sizeof(led));
 
-    if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
-        return;
-    }
-    g_pwm_buffer[led.driver][led.r]          = red;
-    g_pwm_buffer[led.driver][led.g]          = green;
-    g_pwm_buffer[led.driver][led.b]          = blue;
-    g_pwm_buffer_update_required[led.driver] = true;
+    led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.r, red);
+    led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.g, green);
+    led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.b, blue);
 }
 
 void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
@@ -146,11 +143,13 @@ void aw20216s_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
     }
 }
 
+static bool aw20216s_write_pwm_span(const void *context, uint8_t *buffer, uint16_t start, uint16_t length) {
+    return aw20216s_write(*(const pin_t *)context, AW20216S_PAGE_PWM, start, buffer + start, length);
+}
+
 void aw20216s_update_pwm_buffers(pin_t cs_pin, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
-        aw20216s_write(cs_pin, AW20216S_PAGE_PWM, 0, g_pwm_buffer[index], AW20216S_PWM_REGISTER_COUNT);
-    }
-    g_pwm_buffer_update_required[index] = false;
+    // Only write the runs of registers that changed, each in its own chip select cycle
+    led_dirty_flush(g_pwm_buffer[index], g_pwm_buffer_dirty[index], AW20216S_PWM_REGISTER_COUNT, AW20216S_PWM_REGISTER_COUNT, aw20216s_write_pwm_span, &cs_pin);
 }
 
 void aw20216s_flush(void) {
@@ -20,6 +20,7 @@
 #include "is31fl3733.h"
 #include <string.h>
 #include "i2c_master.h"
+#include "led_dirty.h"
 #include "wait.h"
 
 #define IS31FL3733_PWM_REGISTER_COUNT 192
@@ -72,7 +73,7 @@ uint8_t g_twi_transfer_buffer[20];
 // buffers and the transfers in is31fl3733_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[IS31FL3733_DRIVER_COUNT][IS31FL3733_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[IS31FL3733_DRIVER_COUNT] = {false};
+uint8_t g_pwm_buffer_dirty[IS31FL3733_DRIVER_COUNT][LED_DIRTY_BITMAP_SIZE(IS31FL3733_PWM_REGISTER_COUNT)] = {0};
 
 uint8_t g_led_control_registers[IS31FL3733_DRIVER_COUNT][IS31FL3733_LED_CONTROL_REGISTER_COUNT] = {0};
 bool    g_led_control_registers_update_required[IS31FL3733_DRIVER_COUNT]                        = {false};
@@ -96,31 +97,37 @@ bool is31fl3733_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
+static bool is31fl3733_write_pwm_span(uint8_t addr, uint8_t *pwm_buffer, uint8_t start, uint8_t length) {
+    // Assumes PG1 is already selected.
+    // Device will auto-increment register for data after the first byte.
+    // g_twi_transfer_buffer[] is 20 bytes, so length must not exceed 16.
+    g_twi_transfer_buffer[0] = start;
+    memcpy(g_twi_transfer_buffer + 1, pwm_buffer + start, length);
+
+#if IS31FL3733_I2C_PERSISTENCE > 0
+    for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, IS31FL3733_I2C_TIMEOUT) != 0) {
+            return false;
+        }
+    }
+#else
+    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, IS31FL3733_I2C_TIMEOUT) != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+
 bool is31fl3733_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     // Assumes PG1 is already selected.
     // If any of the transactions fails function returns false.
     // Transmit PWM registers in 12 transfers of 16 bytes.
-    // g_twi_transfer_buffer[] is 20 bytes
 
     // Iterate over the pwm_buffer contents at 16 byte intervals.
     for (int i = 0; i < IS31FL3733_PWM_REGISTER_COUNT; i += 16) {
-        g_twi_transfer_buffer[0] = i;
-        // Copy the data from i to i+15.
-        // Device will auto-increment register for data after the first byte
-        // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
-        memcpy(g_twi_transfer_buffer + 1, pwm_buffer + i, 16);
-
-#if IS31FL3733_I2C_PERSISTENCE > 0
-        for (uint8_t i = 0; i < IS31FL3733_I2C_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, IS31FL3733_I2C_TIMEOUT) != 0) {
-                return false;
-            }
-        }
-#else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 17, IS31FL3733_I2C_TIMEOUT) != 0) {
+        if (!is31fl3733_write_pwm_span(addr, pwm_buffer, i, 16)) {
             return false;
         }
-#endif
     }
     return true;
 }
@@ -206,13 +213,9 @@ void is31fl3733_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < IS31FL3733_LED_COUNT) {
         memcpy_P(&led, (&g_is31fl3733_leds[index]), sizeof(led));
 
-        if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
-            return;
-        }
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.r, red);
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.g, green);
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.b, blue);
     }
 }
 
@@ -252,18 +255,22 @@ void is31fl3733_set_led_control_register(uint8_t index, bool red, bool green, bo
     g_led_control_registers_update_required[led.driver] = true;
 }
 
+static bool is31fl3733_flush_pwm_span(const void *context, uint8_t *buffer, uint16_t start, uint16_t length) {
+    return is31fl3733_write_pwm_span(*(const uint8_t *)context, buffer, start, length);
+}
+
 void is31fl3733_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+    if (led_dirty_any(g_pwm_buffer_dirty[index], IS31FL3733_PWM_REGISTER_COUNT)) {
         // Firstly we need to unlock the command register and select PG1.
         is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND_WRITE_LOCK, IS31FL3733_COMMAND_WRITE_LOCK_MAGIC);
         is31fl3733_write_register(addr, IS31FL3733_REG_COMMAND, IS31FL3733_COMMAND_PWM);
 
+        // Only write the runs of registers that changed, at most 16 bytes at a time.
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
-        if (!is31fl3733_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        if (!led_dirty_flush(g_pwm_buffer[index], g_pwm_buffer_dirty[index], IS31FL3733_PWM_REGISTER_COUNT, 16, is31fl3733_flush_pwm_span, &addr)) {
             g_led_control_registers_update_required[index] = true;
         }
-        g_pwm_buffer_update_required[index] = false;
     }
 }
 
@@ -20,6 +20,7 @@
 
 #include "is31flcommon.h"
 #include "i2c_master.h"
+#include "led_dirty.h"
 #include "wait.h"
 #include <string.h>
 
@@ -37,7 +38,7 @@ uint8_t g_twi_transfer_buffer[20];
 // These buffers match the PWM & scaling registers.
 // Storing them like this is optimal for I2C transfers to the registers.
 uint8_t g_pwm_buffer[DRIVER_COUNT][ISSI_MAX_LEDS];
-bool    g_pwm_buffer_update_required[DRIVER_COUNT] = {false};
+uint8_t g_pwm_buffer_dirty[DRIVER_COUNT][LED_DIRTY_BITMAP_SIZE(ISSI_MAX_LEDS)] = {0};
 
 uint8_t g_scaling_buffer[DRIVER_COUNT][ISSI_SCALING_SIZE];
 bool    g_scaling_buffer_update_required[DRIVER_COUNT] = {false};
@@ -120,14 +121,16 @@ void IS31FL_common_init(uint8_t addr, uint8_t ssr) {
     wait_ms(10);
 }
 
+// Hands off a run of changed registers to IS31FL_write_multi_registers as a single transfer
+static bool IS31FL_write_pwm_span(const void *context, uint8_t *buffer, uint16_t start, uint16_t length) {
+    return IS31FL_write_multi_registers(*(const uint8_t *)context, buffer + start, length, length, ISSI_PWM_REG_1ST + start);
+}
+
 void IS31FL_common_update_pwm_register(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+    if (led_dirty_any(g_pwm_buffer_dirty[index], ISSI_MAX_LEDS)) {
         // Queue up the correct page
         IS31FL_unlock_register(addr, ISSI_PAGE_PWM);
-        // Hand off the update to IS31FL_write_multi_registers
-        IS31FL_write_multi_registers(addr, g_pwm_buffer[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, ISSI_PWM_REG_1ST);
-        // Update flags that pwm_buffer has been updated
-        g_pwm_buffer_update_required[index] = false;
+        led_dirty_flush(g_pwm_buffer[index], g_pwm_buffer_dirty[index], ISSI_MAX_LEDS, ISSI_PWM_TRF_SIZE, IS31FL_write_pwm_span, &addr);
     }
 }
 
@@ -229,10 +232,9 @@ void IS31FL_RGB_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.r, red);
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.g, green);
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.b, blue);
     }
 }
 
@@ -317,8 +319,7 @@ void IS31FL_simple_set_brightness(int index, uint8_t value) {
         is31_led led;
         memcpy_P(&led, (&g_is31_leds[index]), sizeof(led));
 
-        g_pwm_buffer[led.driver][led.v] = value;
-        g_pwm_buffer_update_required[led.driver] = true;
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.v, value);
     }
 }
 
@@ -0,0 +1,109 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * Dirty register tracking shared by the LED drivers.
+ *
+ * Each chip keeps one bit per PWM register, set whenever the buffered value changes. A flush walks the bitmap and only
+ * writes the contiguous runs of changed registers, relying on the register address auto-increment of the chip.
+ *
+ * Every extra transfer costs the device address and the start register on the bus, so runs separated by no more than
+ * LED_DIRTY_MERGE_GAP unchanged registers are merged and written as one.
+ */
+
+#ifndef LED_DIRTY_MERGE_GAP
+#    define LED_DIRTY_MERGE_GAP 2
+#endif
+
+#define LED_DIRTY_BITMAP_SIZE(count) (((count) + 7) / 8)
+
+static inline void led_dirty_mark(uint8_t *bitmap, uint16_t reg) {
+    bitmap[reg / 8] |= (1 << (reg % 8));
+}
+
+static inline bool led_dirty_is_marked(const uint8_t *bitmap, uint16_t reg) {
+    return bitmap[reg / 8] & (1 << (reg % 8));
+}
+
+// Updates a buffered register, marking it dirty only if the value actually changed
+static inline void led_dirty_set(uint8_t *buffer, uint8_t *bitmap, uint16_t reg, uint8_t value) {
+    if (buffer[reg] != value) {
+        buffer[reg] = value;
+        led_dirty_mark(bitmap, reg);
+    }
+}
+
+static inline void led_dirty_mark_all(uint8_t *bitmap, uint16_t count) {
+    memset(bitmap, 0xFF, LED_DIRTY_BITMAP_SIZE(count));
+}
+
+// Clears the registers of a span once it has been written, anything not written stays dirty for the next flush
+static inline void led_dirty_clear_span(uint8_t *bitmap, uint16_t start, uint16_t length) {
+    for (uint16_t reg = start; reg < start + length; reg++) {
+        bitmap[reg / 8] &= ~(1 << (reg % 8));
+    }
+}
+
+static inline bool led_dirty_any(const uint8_t *bitmap, uint16_t count) {
+    for (uint16_t i = 0; i < LED_DIRTY_BITMAP_SIZE(count); i++) {
+        if (bitmap[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Finds the next run of dirty registers at or after `*start`, no longer than `max_length`.
+ *
+ * On success `*start` and `*length` describe the run, and the caller continues the search from `*start + *length`.
+ * Returns false once no dirty registers remain.
+ */
+static inline bool led_dirty_next_span(const uint8_t *bitmap, uint16_t count, uint16_t *start, uint16_t *length, uint16_t max_length) {
+    uint16_t first = *start;
+    while (first < count && !led_dirty_is_marked(bitmap, first)) {
+        // Skip whole bytes of clean registers at a time
+        first = bitmap[first / 8] ? first + 1 : (first | 7) + 1;
+    }
+    if (first >= count) {
+        return false;
+    }
+
+    uint16_t last = first;
+    for (uint16_t reg = first + 1; reg < count && reg - first < max_length && reg - last <= LED_DIRTY_MERGE_GAP + 1; reg++) {
+        if (led_dirty_is_marked(bitmap, reg)) {
+            last = reg;
+        }
+    }
+
+    *start  = first;
+    *length = last - first + 1;
+    return true;
+}
+
+// Writes `length` registers of `buffer` from `start` onwards to the chip described by `context`
+typedef bool (*led_dirty_write_t)(const void *context, uint8_t *buffer, uint16_t start, uint16_t length);
+
+/**
+ * Writes every dirty run of `buffer`, at most `max_length` registers at a time, and clears each run once written.
+ *
+ * Stops at the first failed write and returns false. The runs not yet written stay dirty for the next flush.
+ */
+static inline bool led_dirty_flush(uint8_t *buffer, uint8_t *bitmap, uint16_t count, uint16_t max_length, led_dirty_write_t write, const void *context) {
+    uint16_t start = 0;
+    uint16_t length;
+    while (led_dirty_next_span(bitmap, count, &start, &length, max_length)) {
+        if (!write(context, buffer, start, length)) {
+            return false;
+        }
+        led_dirty_clear_span(bitmap, start, length);
+        start += length;
+    }
+    return true;
+}
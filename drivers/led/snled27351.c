@@ -16,6 +16,7 @@
 
 #include "snled27351.h"
 #include "i2c_master.h"
+#include "led_dirty.h"
 
 #define SNLED27351_PWM_REGISTER_COUNT 192
 #define SNLED27351_LED_CONTROL_REGISTER_COUNT 24
@@ -47,7 +48,7 @@ uint8_t g_twi_transfer_buffer[65];
 // buffers and the transfers in snled27351_write_pwm_buffer() but it's
 // probably not worth the extra complexity.
 uint8_t g_pwm_buffer[SNLED27351_DRIVER_COUNT][SNLED27351_PWM_REGISTER_COUNT];
-bool    g_pwm_buffer_update_required[SNLED27351_DRIVER_COUNT] = {false};
+uint8_t g_pwm_buffer_dirty[SNLED27351_DRIVER_COUNT][LED_DIRTY_BITMAP_SIZE(SNLED27351_PWM_REGISTER_COUNT)] = {0};
 
 uint8_t g_led_control_registers[SNLED27351_DRIVER_COUNT][SNLED27351_LED_CONTROL_REGISTER_COUNT] = {0};
 bool    g_led_control_registers_update_required[SNLED27351_DRIVER_COUNT]                        = {false};
@@ -71,6 +72,29 @@ bool snled27351_write_register(uint8_t addr, uint8_t reg, uint8_t data) {
     return true;
 }
 
+static bool snled27351_write_pwm_span(uint8_t addr, uint8_t *pwm_buffer, uint8_t start, uint8_t length) {
+    // Assumes PG1 is already selected.
+    // Device will auto-increment register for data after the first byte.
+    // g_twi_transfer_buffer[] is 65 bytes, so length must not exceed 64.
+    g_twi_transfer_buffer[0] = start;
+    for (uint8_t j = 0; j < length; j++) {
+        g_twi_transfer_buffer[1 + j] = pwm_buffer[start + j];
+    }
+
+#if SNLED27351_I2C_PERSISTENCE > 0
+    for (uint8_t i = 0; i < SNLED27351_I2C_PERSISTENCE; i++) {
+        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, SNLED27351_I2C_TIMEOUT) != 0) {
+            return false;
+        }
+    }
+#else
+    if (i2c_transmit(addr << 1, g_twi_transfer_buffer, length + 1, SNLED27351_I2C_TIMEOUT) != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+
 bool snled27351_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
     // Assumes PG1 is already selected.
     // If any of the transactions fails function returns false.
@@ -78,25 +102,9 @@ bool snled27351_write_pwm_buffer(uint8_t addr, uint8_t *pwm_buffer) {
 
     // Iterate over the pwm_buffer contents at 64 byte intervals.
     for (uint8_t i = 0; i < SNLED27351_PWM_REGISTER_COUNT; i += 64) {
-        g_twi_transfer_buffer[0] = i;
-        // Copy the data from i to i+63.
-        // Device will auto-increment register for data after the first byte
-        // Thus this sets registers 0x00-0x0F, 0x10-0x1F, etc. in one transfer.
-        for (uint8_t j = 0; j < 64; j++) {
-            g_twi_transfer_buffer[1 + j] = pwm_buffer[i + j];
-        }
-
-#if SNLED27351_I2C_PERSISTENCE > 0
-        for (uint8_t i = 0; i < SNLED27351_I2C_PERSISTENCE; i++) {
-            if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 65, SNLED27351_I2C_TIMEOUT) != 0) {
-                return false;
-            }
-        }
-#else
-        if (i2c_transmit(addr << 1, g_twi_transfer_buffer, 65, SNLED27351_I2C_TIMEOUT) != 0) {
+        if (!snled27351_write_pwm_span(addr, pwm_buffer, i, 64)) {
             return false;
         }
-#endif
     }
     return true;
 }
@@ -182,13 +190,9 @@ void snled27351_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
     if (index >= 0 && index < SNLED27351_LED_COUNT) {
         memcpy_P(&led, (&g_snled27351_leds[index]), sizeof(led));
 
-        if (g_pwm_buffer[led.driver][led.r] == red && g_pwm_buffer[led.driver][led.g] == green && g_pwm_buffer[led.driver][led.b] == blue) {
-            return;
-        }
-        g_pwm_buffer[led.driver][led.r]          = red;
-        g_pwm_buffer[led.driver][led.g]          = green;
-        g_pwm_buffer[led.driver][led.b]          = blue;
-        g_pwm_buffer_update_required[led.driver] = true;
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.r, red);
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.g, green);
+        led_dirty_set(g_pwm_buffer[led.driver], g_pwm_buffer_dirty[led.driver], led.b, blue);
     }
 }
 
@@ -228,17 +232,21 @@ void snled27351_set_led_control_register(uint8_t index, bool red, bool green, bo
     g_led_control_registers_update_required[led.driver] = true;
 }
 
+static bool snled27351_flush_pwm_span(const void *context, uint8_t *buffer, uint16_t start, uint16_t length) {
+    return snled27351_write_pwm_span(*(const uint8_t *)context, buffer, start, length);
+}
+
 void snled27351_update_pwm_buffers(uint8_t addr, uint8_t index) {
-    if (g_pwm_buffer_update_required[index]) {
+    if (led_dirty_any(g_pwm_buffer_dirty[index], SNLED27351_PWM_REGISTER_COUNT)) {
         snled27351_write_register(addr, SNLED27351_REG_COMMAND, SNLED27351_COMMAND_PWM);
 
+        // Only write the runs of registers that changed, at most 64 bytes at a time.
         // If any of the transactions fail we risk writing dirty PG0,
         // refresh page 0 just in case.
-        if (!snled27351_write_pwm_buffer(addr, g_pwm_buffer[index])) {
+        if (!led_dirty_flush(g_pwm_buffer[index], g_pwm_buffer_dirty[index], SNLED27351_PWM_REGISTER_COUNT, 64, snled27351_flush_pwm_span, &addr)) {
             g_led_control_registers_update_required[index] = true;
         }
     }
-    g_pwm_buffer_update_required[index] = false;
 }
 
 void snled27351_update_led_control_registers(uint8_t addr, uint8_t index) {
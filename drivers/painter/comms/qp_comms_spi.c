@@ -6,6 +6,10 @@
 #    include "spi_master.h"
 #    include "qp_comms_spi.h"
 
+#    ifdef QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+#        include "background_worker.h"
+#    endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Base SPI support
 
@@ -30,7 +34,7 @@ bool qp_comms_spi_start(painter_device_t device) {
     return spi_start(comms_config->chip_select_pin, comms_config->lsb_first, comms_config->mode, comms_config->divisor);
 }
 
-uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
+static uint32_t qp_comms_spi_transmit(const void *data, uint32_t byte_count) {
     uint32_t       bytes_remaining = byte_count;
     const uint8_t *p               = (const uint8_t *)data;
     const uint32_t max_msg_length  = 1024;
@@ -45,6 +49,35 @@ uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint3
     return byte_count - bytes_remaining;
 }
 
+uint32_t qp_comms_spi_send_data(painter_device_t device, const void *data, uint32_t byte_count) {
+    return qp_comms_spi_transmit(data, byte_count);
+}
+
+#    ifdef QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+
+// The transfer handed to the background worker. Quantum Painter waits for it before touching the bus again, so
+// there is only ever one.
+static const void *async_data;
+static uint32_t    async_byte_count;
+
+static void qp_comms_spi_async_job(void) {
+    qp_comms_spi_transmit(async_data, async_byte_count);
+}
+
+bool qp_comms_spi_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    background_worker_wait();
+    async_data       = data;
+    async_byte_count = byte_count;
+    background_worker_start(qp_comms_spi_async_job);
+    return true;
+}
+
+void qp_comms_spi_wait(painter_device_t device) {
+    background_worker_wait();
+}
+
+#    endif // QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+
 void qp_comms_spi_stop(painter_device_t device) {
     painter_driver_t *     driver       = (painter_driver_t *)device;
     qp_comms_spi_config_t *comms_config = (qp_comms_spi_config_t *)driver->comms_config;
@@ -57,6 +90,10 @@ const painter_comms_vtable_t spi_comms_vtable = {
     .comms_start = qp_comms_spi_start,
     .comms_send  = qp_comms_spi_send_data,
     .comms_stop  = qp_comms_spi_stop,
+#    ifdef QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+    .comms_send_async = qp_comms_spi_send_data_async,
+    .comms_wait       = qp_comms_spi_wait,
+#    endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -97,6 +134,16 @@ uint32_t qp_comms_spi_dc_reset_send_data(painter_device_t device, const void *da
     return qp_comms_spi_send_data(device, data, byte_count);
 }
 
+#        ifdef QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+bool qp_comms_spi_dc_reset_send_data_async(painter_device_t device, const void *data, uint32_t byte_count) {
+    painter_driver_t *              driver       = (painter_driver_t *)device;
+    qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
+    background_worker_wait();
+    writePinHigh(comms_config->dc_pin);
+    return qp_comms_spi_send_data_async(device, data, byte_count);
+}
+#        endif // QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+
 void qp_comms_spi_dc_reset_send_command(painter_device_t device, uint8_t cmd) {
     painter_driver_t *              driver       = (painter_driver_t *)device;
     qp_comms_spi_dc_reset_config_t *comms_config = (qp_comms_spi_dc_reset_config_t *)driver->comms_config;
@@ -135,6 +182,10 @@ const painter_comms_with_command_vtable_t spi_comms_with_dc_vtable = {
             .comms_start = qp_comms_spi_start,
             .comms_send  = qp_comms_spi_dc_reset_send_data,
             .comms_stop  = qp_comms_spi_stop,
+#        ifdef QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+            .comms_send_async = qp_comms_spi_dc_reset_send_data_async,
+            .comms_wait       = qp_comms_spi_wait,
+#        endif
         },
     .send_command          = qp_comms_spi_dc_reset_send_command,
     .bulk_command_sequence = qp_comms_spi_dc_reset_bulk_command_sequence,
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
 
+#include "color.h"
 #include "qp_internal.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -21,6 +22,22 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_RECTS
+/**
+ * @def This controls the number of separate dirty rectangles each surface keeps track of. Changes in different parts
+ *      of the surface are sent as separate rectangles, up to this many; beyond that, the closest ones are merged.
+ */
+#    define SURFACE_DIRTY_RECTS 4
+#endif
+
+#ifndef SURFACE_DIRTY_MERGE_DISTANCE
+/**
+ * @def Changes closer than this many pixels to a dirty rectangle are merged into it, rather than being tracked as
+ *      a rectangle of their own. Each extra rectangle costs a viewport command when drawing to the target.
+ */
+#    define SURFACE_DIRTY_MERGE_DISTANCE 8
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -64,4 +81,27 @@ painter_device_t qp_make_mono1bpp_surface(uint16_t panel_width, uint16_t panel_h
  */
 bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y, bool entire_surface);
 
+// A surface stacked with others by qp_surface_draw_layers()
+typedef struct qp_surface_layer_t {
+    painter_device_t surface;               // RGB565 surface holding the layer's content
+    uint16_t         x;                     // location of the surface's top-left corner on the target
+    uint16_t         y;
+    bool             has_transparent_color; // whether pixels of `transparent_color` show the layers underneath
+    HSV              transparent_color;
+} qp_surface_layer_t;
+
+/**
+ * Helper method to draw a stack of RGB565 surfaces to the target device, compositing them on the way.
+ *
+ * Only the areas where any layer has changed are sent. Layers are listed bottom-most first. Where no layer has an
+ * opaque pixel, black is drawn. After successful completion, the dirty areas of all layers are reset.
+ *
+ * @param target[in] the target device to draw into
+ * @param layers[in] the layers to composite, bottom-most first
+ * @param layer_count[in] the number of layers
+ * @param entire_area[in] whether the entire area covered by the layers should be drawn, instead of just the dirty regions
+ * @return whether the draw operation completed successfully
+ */
+bool qp_surface_draw_layers(painter_device_t target, const qp_surface_layer_t *layers, uint8_t layer_count, bool entire_area);
+
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
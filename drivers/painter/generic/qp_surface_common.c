@@ -29,24 +29,110 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
-void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
-    // Maintain dirty region
-    if (dirty->l > x) {
-        dirty->l        = x;
-        dirty->is_dirty = true;
-    }
-    if (dirty->r < x) {
-        dirty->r        = x;
-        dirty->is_dirty = true;
+static inline bool dirty_rect_contains(const surface_dirty_rect_t *rect, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    return rect->l <= l && rect->t <= t && rect->r >= r && rect->b >= b;
+}
+
+// Whether the two areas overlap, or come within SURFACE_DIRTY_MERGE_DISTANCE of each other
+static inline bool dirty_rect_near(const surface_dirty_rect_t *rect, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    return (uint32_t)l <= (uint32_t)rect->r + SURFACE_DIRTY_MERGE_DISTANCE && (uint32_t)rect->l <= (uint32_t)r + SURFACE_DIRTY_MERGE_DISTANCE && (uint32_t)t <= (uint32_t)rect->b + SURFACE_DIRTY_MERGE_DISTANCE && (uint32_t)rect->t <= (uint32_t)b + SURFACE_DIRTY_MERGE_DISTANCE;
+}
+
+static inline void dirty_rect_union(surface_dirty_rect_t *rect, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    rect->l = QP_MIN(rect->l, l);
+    rect->t = QP_MIN(rect->t, t);
+    rect->r = QP_MAX(rect->r, r);
+    rect->b = QP_MAX(rect->b, b);
+}
+
+// The number of pixels the rectangle would gain by growing to include the area
+static uint32_t dirty_rect_growth(const surface_dirty_rect_t *rect, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    surface_dirty_rect_t grown = *rect;
+    dirty_rect_union(&grown, l, t, r, b);
+    uint32_t before = (uint32_t)(rect->r - rect->l + 1) * (rect->b - rect->t + 1);
+    uint32_t after  = (uint32_t)(grown.r - grown.l + 1) * (grown.b - grown.t + 1);
+    return after - before;
+}
+
+void qp_surface_reset_dirty(surface_dirty_data_t *dirty) {
+    dirty->l = dirty->t = UINT16_MAX;
+    dirty->r = dirty->b = 0;
+    dirty->rect_count   = 0;
+    dirty->last_rect    = 0;
+    dirty->is_dirty     = false;
+}
+
+void qp_surface_update_dirty_rect(surface_dirty_data_t *dirty, uint16_t l, uint16_t t, uint16_t r, uint16_t b) {
+    // Most changes land next to the previous one, inside the rectangle that was grown for it
+    if (dirty->rect_count > 0 && dirty_rect_contains(&dirty->rects[dirty->last_rect], l, t, r, b)) {
+        return;
     }
-    if (dirty->t > y) {
-        dirty->t        = y;
-        dirty->is_dirty = true;
+
+    // Maintain the bounding box
+    dirty->l        = QP_MIN(dirty->l, l);
+    dirty->t        = QP_MIN(dirty->t, t);
+    dirty->r        = QP_MAX(dirty->r, r);
+    dirty->b        = QP_MAX(dirty->b, b);
+    dirty->is_dirty = true;
+
+    // Grow a rectangle the change is close to, preferring the one grown last
+    uint8_t index = dirty->rect_count;
+    if (dirty->rect_count > 0 && dirty_rect_near(&dirty->rects[dirty->last_rect], l, t, r, b)) {
+        index = dirty->last_rect;
+    } else {
+        for (uint8_t i = 0; i < dirty->rect_count; ++i) {
+            if (dirty_rect_near(&dirty->rects[i], l, t, r, b)) {
+                index = i;
+                break;
+            }
+        }
     }
-    if (dirty->b < y) {
-        dirty->b        = y;
-        dirty->is_dirty = true;
+
+    if (index == dirty->rect_count) {
+        // Far from everything else, so it gets a rectangle of its own if there is one left
+        if (dirty->rect_count < SURFACE_DIRTY_RECTS) {
+            dirty->rects[index] = (surface_dirty_rect_t){.l = l, .t = t, .r = r, .b = b};
+            dirty->last_rect    = index;
+            dirty->rect_count++;
+            return;
+        }
+
+        // Otherwise the rectangle that grows the least takes it
+        uint32_t least_growth = UINT32_MAX;
+        for (uint8_t i = 0; i < dirty->rect_count; ++i) {
+            uint32_t growth = dirty_rect_growth(&dirty->rects[i], l, t, r, b);
+            if (growth < least_growth) {
+                least_growth = growth;
+                index        = i;
+            }
+        }
     }
+    dirty_rect_union(&dirty->rects[index], l, t, r, b);
+
+    // The grown rectangle may now reach others, which get folded into it so that no pixel is sent twice
+    bool merged;
+    do {
+        merged = false;
+        for (uint8_t i = 0; i < dirty->rect_count; ++i) {
+            surface_dirty_rect_t *other = &dirty->rects[i];
+            if (i != index && dirty_rect_near(&dirty->rects[index], other->l, other->t, other->r, other->b)) {
+                dirty_rect_union(&dirty->rects[index], other->l, other->t, other->r, other->b);
+                // Fill the gap with the last rectangle
+                dirty->rect_count--;
+                dirty->rects[i] = dirty->rects[dirty->rect_count];
+                if (index == dirty->rect_count) {
+                    index = i;
+                }
+                merged = true;
+                break;
+            }
+        }
+    } while (merged);
+    dirty->last_rect = index;
+}
+
+void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
+    qp_surface_update_dirty_rect(dirty, x, y, x, y);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -57,11 +143,8 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
     memset(surface->buffer, 0, SURFACE_REQUIRED_BUFFER_BYTE_SIZE(driver->panel_width, driver->panel_height, driver->native_bits_per_pixel));
 
-    surface->dirty.l        = 0;
-    surface->dirty.t        = 0;
-    surface->dirty.r        = surface->base.panel_width - 1;
-    surface->dirty.b        = surface->base.panel_height - 1;
-    surface->dirty.is_dirty = true;
+    qp_surface_reset_dirty(&surface->dirty);
+    qp_surface_update_dirty_rect(&surface->dirty, 0, 0, surface->base.panel_width - 1, surface->base.panel_height - 1);
 
     return true;
 }
@@ -80,9 +163,7 @@ bool qp_surface_clear(painter_device_t device) {
 bool qp_surface_flush(painter_device_t device) {
     painter_driver_t *        driver  = (painter_driver_t *)device;
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
-    surface->dirty.l = surface->dirty.t = UINT16_MAX;
-    surface->dirty.r = surface->dirty.b = 0;
-    surface->dirty.is_dirty             = false;
+    qp_surface_reset_dirty(&surface->dirty);
     return true;
 }
 
@@ -122,9 +203,15 @@ bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t
         return false;
     }
 
-    // Offload to the pixdata transfer function
+    // Offload each dirty rectangle to the pixdata transfer function
     surface_painter_driver_vtable_t *vtable = (surface_painter_driver_vtable_t *)surface_driver->driver_vtable;
-    bool                             ok     = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, entire_surface);
+    surface_dirty_rect_t             whole  = {.l = 0, .t = 0, .r = surface_driver->panel_width - 1, .b = surface_driver->panel_height - 1};
+    const surface_dirty_rect_t *     rects  = entire_surface ? &whole : surface_handle->dirty.rects;
+    uint8_t                          count  = entire_surface ? 1 : surface_handle->dirty.rect_count;
+    bool                             ok     = true;
+    for (uint8_t i = 0; ok && i < count; ++i) {
+        ok = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, &rects[i]);
+    }
     if (!ok) {
         qp_dprintf("qp_surface_draw: fail (could not transfer pixel data)\n");
         return false;
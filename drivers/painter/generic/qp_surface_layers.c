@@ -0,0 +1,141 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+
+#    include "qp_comms.h"
+#    include "qp_draw.h"
+#    include "qp_surface_internal.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Compositing of stacked RGB565 surfaces
+
+extern const surface_painter_driver_vtable_t rgb565_surface_driver_vtable;
+
+// The visible pixel at the target location, from the top-most layer that is opaque there
+static inline uint16_t composite_pixel(const qp_surface_layer_t *layers, const uint16_t *transparent, uint8_t layer_count, uint16_t x, uint16_t y) {
+    for (uint8_t i = layer_count; i-- > 0;) {
+        const qp_surface_layer_t *layer   = &layers[i];
+        surface_painter_device_t *surface = (surface_painter_device_t *)layer->surface;
+        if (x < layer->x || y < layer->y) {
+            continue;
+        }
+        uint16_t lx = x - layer->x;
+        uint16_t ly = y - layer->y;
+        if (lx >= surface->base.panel_width || ly >= surface->base.panel_height) {
+            continue;
+        }
+        uint16_t pixel = surface->u16buffer[ly * surface->base.panel_width + lx];
+        if (!layer->has_transparent_color || pixel != transparent[i]) {
+            return pixel;
+        }
+    }
+    return 0;
+}
+
+static bool composite_rect(painter_device_t target, const qp_surface_layer_t *layers, const uint16_t *transparent, uint8_t layer_count, const surface_dirty_rect_t *rect) {
+    if (!qp_viewport(target, rect->l, rect->t, rect->r, rect->b)) {
+        qp_dprintf("qp_surface_draw_layers: fail (could not set target viewport)\n");
+        return false;
+    }
+
+    // Keep the target's comms running for the whole rectangle, so that it can send one buffer while the next is filled
+    if (!qp_comms_start(target)) {
+        qp_dprintf("qp_surface_draw_layers: fail (could not start comms)\n");
+        return false;
+    }
+
+    bool      ok                = true;
+    uint32_t  total_pixel_count = QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE / sizeof(uint16_t);
+    uint32_t  pixel_counter     = 0;
+    uint16_t *target_buffer     = (uint16_t *)qp_internal_global_pixdata_buffer;
+    for (uint16_t y = rect->t; ok && y <= rect->b; ++y) {
+        for (uint16_t x = rect->l; ok && x <= rect->r; ++x) {
+            target_buffer[pixel_counter++] = composite_pixel(layers, transparent, layer_count, x, y);
+            if (pixel_counter == total_pixel_count) {
+                ok            = qp_internal_flush_pixdata(target, pixel_counter);
+                pixel_counter = 0;
+                target_buffer = (uint16_t *)qp_internal_global_pixdata_buffer;
+            }
+        }
+    }
+    if (ok && pixel_counter > 0) {
+        ok = qp_internal_flush_pixdata(target, pixel_counter);
+    }
+
+    qp_comms_stop(target);
+    if (!ok) {
+        qp_dprintf("qp_surface_draw_layers: fail (could not stream pixdata to target)\n");
+    }
+    return ok;
+}
+
+bool qp_surface_draw_layers(painter_device_t target, const qp_surface_layer_t *layers, uint8_t layer_count, bool entire_area) {
+    painter_driver_t *target_driver = (painter_driver_t *)target;
+    if (!target_driver || !target_driver->validate_ok || target_driver->native_bits_per_pixel != 16) {
+        qp_dprintf("qp_surface_draw_layers: fail (target needs to be a valid 16bpp device)\n");
+        return false;
+    }
+    if (layer_count == 0) {
+        qp_dprintf("qp_surface_draw_layers: ok (no layers)\n");
+        return true;
+    }
+
+    // Gather the changes of every layer, in target coordinates, merging them as a single surface would
+    surface_dirty_data_t dirty;
+    qp_surface_reset_dirty(&dirty);
+    uint16_t transparent[layer_count];
+    for (uint8_t i = 0; i < layer_count; ++i) {
+        const qp_surface_layer_t *layer   = &layers[i];
+        surface_painter_device_t *surface = (surface_painter_device_t *)layer->surface;
+        if (!surface || surface->base.driver_vtable != (const painter_driver_vtable_t *)&rgb565_surface_driver_vtable) {
+            qp_dprintf("qp_surface_draw_layers: fail (layer %d is not an RGB565 surface)\n", (int)i);
+            return false;
+        }
+
+        if (entire_area) {
+            qp_surface_update_dirty_rect(&dirty, layer->x, layer->y, layer->x + surface->base.panel_width - 1, layer->y + surface->base.panel_height - 1);
+        } else {
+            for (uint8_t j = 0; j < surface->dirty.rect_count; ++j) {
+                const surface_dirty_rect_t *rect = &surface->dirty.rects[j];
+                qp_surface_update_dirty_rect(&dirty, layer->x + rect->l, layer->y + rect->t, layer->x + rect->r, layer->y + rect->b);
+            }
+        }
+
+        qp_pixel_t color = {.hsv888 = {.h = layer->transparent_color.h, .s = layer->transparent_color.s, .v = layer->transparent_color.v}};
+        surface->base.driver_vtable->palette_convert(layer->surface, 1, &color);
+        transparent[i] = color.rgb565;
+    }
+
+    if (!dirty.is_dirty) {
+        qp_dprintf("qp_surface_draw_layers: ok (not dirty, skipping)\n");
+        return true;
+    }
+
+    // Only the part of each rectangle that is on the target can be drawn
+    uint16_t width, height;
+    qp_get_geometry(target, &width, &height, NULL, NULL, NULL);
+    for (uint8_t i = 0; i < dirty.rect_count; ++i) {
+        surface_dirty_rect_t rect = dirty.rects[i];
+        if (rect.l >= width || rect.t >= height) {
+            continue;
+        }
+        rect.r = QP_MIN(rect.r, width - 1);
+        rect.b = QP_MIN(rect.b, height - 1);
+        if (!composite_rect(target, layers, transparent, layer_count, &rect)) {
+            return false;
+        }
+    }
+
+    // Clear the dirty info for every layer
+    for (uint8_t i = 0; i < layer_count; ++i) {
+        if (!qp_flush(layers[i].surface)) {
+            qp_dprintf("qp_surface_draw_layers: fail (could not flush layer %d)\n", (int)i);
+            return false;
+        }
+    }
+    qp_dprintf("qp_surface_draw_layers: ok\n");
+    return true;
+}
+
+#endif // QUANTUM_PAINTER_SURFACE_ENABLE
@@ -4,6 +4,7 @@
 #ifdef QUANTUM_PAINTER_SURFACE_ENABLE
 
 #    include "color.h"
+#    include "qp_comms.h"
 #    include "qp_draw.h"
 #    include "qp_surface_internal.h"
 #    include "qp_comms_dummy.h"
@@ -68,13 +69,13 @@ static bool qp_surface_append_pixels_rgb565(painter_device_t device, uint8_t *ta
     return true;
 }
 
-static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface) {
+static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, const surface_dirty_rect_t *rect) {
     surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
 
-    uint16_t l = entire_surface ? 0 : surface_handle->dirty.l;
-    uint16_t t = entire_surface ? 0 : surface_handle->dirty.t;
-    uint16_t r = entire_surface ? (surface_handle->base.panel_width - 1) : surface_handle->dirty.r;
-    uint16_t b = entire_surface ? (surface_handle->base.panel_height - 1) : surface_handle->dirty.b;
+    uint16_t l = rect->l;
+    uint16_t t = rect->t;
+    uint16_t r = rect->r;
+    uint16_t b = rect->b;
 
     // Set the target drawing area
     bool ok = qp_viewport((painter_device_t)target_driver, x + l, y + t, x + r, y + b);
@@ -83,40 +84,43 @@ static bool rgb565_target_pixdata_transfer(painter_driver_t *surface_driver, pai
         return false;
     }
 
+    // Keep the target's comms running for the whole transfer, so that it can send one buffer while the next is filled
+    if (!qp_comms_start((painter_device_t)target_driver)) {
+        qp_dprintf("rgb565_target_pixdata_transfer: fail (could not start comms)\n");
+        return false;
+    }
+
     // Housekeeping of the amount of pixels to transfer
     uint32_t  total_pixel_count = (8 * QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE) / surface_driver->native_bits_per_pixel;
     uint32_t  pixel_counter     = 0;
     uint16_t *target_buffer     = (uint16_t *)qp_internal_global_pixdata_buffer;
 
     // Fill the global pixdata area so that we can start transferring to the panel
-    for (uint16_t y = t; y <= b; ++y) {
-        for (uint16_t x = l; x <= r; ++x) {
+    for (uint16_t y = t; ok && y <= b; ++y) {
+        for (uint16_t x = l; ok && x <= r; ++x) {
             // Update the target buffer
             target_buffer[pixel_counter++] = surface_handle->u16buffer[y * surface_handle->base.panel_width + x];
 
             // If we've accumulated enough data, send it
             if (pixel_counter == total_pixel_count) {
-                ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
-                if (!ok) {
-                    qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
-                    return false;
-                }
-                // Reset the counter
+                ok = qp_internal_flush_pixdata((painter_device_t)target_driver, pixel_counter);
+                // Reset the counter, carrying on in whichever buffer is free now
                 pixel_counter = 0;
+                target_buffer = (uint16_t *)qp_internal_global_pixdata_buffer;
             }
         }
     }
 
     // If there's any leftover data, send it
-    if (pixel_counter > 0) {
-        ok = qp_pixdata((painter_device_t)target_driver, qp_internal_global_pixdata_buffer, pixel_counter);
-        if (!ok) {
-            qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
-            return false;
-        }
+    if (ok && pixel_counter > 0) {
+        ok = qp_internal_flush_pixdata((painter_device_t)target_driver, pixel_counter);
     }
 
-    return true;
+    qp_comms_stop((painter_device_t)target_driver);
+    if (!ok) {
+        qp_dprintf("rgb565_target_pixdata_transfer: fail (could not stream pixdata to target)\n");
+    }
+    return ok;
 }
 
 static bool qp_surface_append_pixdata_rgb565(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
@@ -81,8 +81,7 @@ bool qp_tft_panel_viewport(painter_device_t device, uint16_t left, uint16_t top,
 // Stream pixel data to the current write position in GRAM
 bool qp_tft_panel_pixdata(painter_device_t device, const void *pixel_data, uint32_t native_pixel_count) {
     painter_driver_t *driver = (painter_driver_t *)device;
-    qp_comms_send(device, pixel_data, native_pixel_count * driver->native_bits_per_pixel / 8);
-    return true;
+    return qp_comms_send_async(device, pixel_data, native_pixel_count * driver->native_bits_per_pixel / 8);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -41,6 +41,16 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_partial(uint32_t address, uint32_t *erased_length) {
+    _Static_assert(((WEAR_LEVELING_BACKING_SIZE) / 2) % (EXTERNAL_FLASH_SECTOR_SIZE) == 0, "Bank size must be a multiple of EXTERNAL_FLASH_SECTOR_SIZE");
+
+    flash_status_t status = flash_erase_sector((WEAR_LEVELING_EXTERNAL_FLASH_BLOCK_OFFSET) * (EXTERNAL_FLASH_BLOCK_SIZE) + address);
+    *erased_length        = (EXTERNAL_FLASH_SECTOR_SIZE);
+    return status == FLASH_STATUS_SUCCESS;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return backing_store_write_bulk(address, &value, 1);
 }
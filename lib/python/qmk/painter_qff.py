@@ -51,7 +51,7 @@ class QFFFontDescriptor:
         self.header = QGFBlockHeader()
         self.header.type_id = QFFFontDescriptor.type_id
         self.header.length = QFFFontDescriptor.length
-        self.version = 1
+        self.version = 2  # v2: unicode glyph table is sorted by code point
         self.total_file_size = 0
         self.line_height = 0
         self.has_ascii_table = False
@@ -136,6 +136,7 @@ class QFFUnicodeGlyphTableV1:
         self.header.length = len(self.glyphs.keys()) * 6
         self.header.write(fp)
 
+        # Sorted by code point, as QFF v2 readers binary search this table
         for n in sorted(self.glyphs.keys()):
             self.glyphs[n].write(fp, True)
 
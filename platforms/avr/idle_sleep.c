@@ -0,0 +1,31 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <avr/sleep.h>
+#include <avr/interrupt.h>
+
+#include "idle_sleep.h"
+
+// Pin change interrupts are only available on some pins, so the matrix pins are not armed.
+bool idle_sleep_pins_share_event(pin_t a, pin_t b) {
+    return false;
+}
+
+void idle_sleep_pin_enable(pin_t pin) {}
+
+void idle_sleep_pin_disable(pin_t pin) {}
+
+/** \brief Idles until the next interrupt, at the latest the next 1ms timer tick
+ *
+ * duration_ms is not honoured: with the matrix pins unarmed, the tick is the only
+ * chance to notice a key press, so the main loop has to scan again after each one.
+ */
+void idle_sleep_wait(uint32_t duration_ms) {
+    (void)duration_ms;
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    cli();
+    sleep_enable();
+    sei();
+    sleep_cpu();
+    sleep_disable();
+}
@@ -134,6 +134,32 @@ inline uint32_t timer_elapsed32(uint32_t last) {
     return TIMER_DIFF_32(t, last);
 }
 
+/** \brief timer read raw32
+ *
+ * Counts TIMER_RAW ticks (TIMER_RAW_FREQ per second), wrapping at 32 bits.
+ */
+uint32_t timer_read_raw32(void) {
+    uint32_t t;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        t   = timer_count;
+        raw = TIMER_RAW;
+        // The counter may have wrapped with the interrupt still pending
+#if defined(__AVR_ATmega32A__)
+        if ((TIFR & _BV(OCF0)) && raw < TIMER_RAW_TOP) {
+#elif defined(__AVR_ATtiny85__)
+        if ((TIFR & _BV(OCF0A)) && raw < TIMER_RAW_TOP) {
+#else
+        if ((TIFR0 & _BV(OCF0A)) && raw < TIMER_RAW_TOP) {
+#endif
+            t++;
+        }
+    }
+
+    return t * (TIMER_RAW_TOP + 1) + raw;
+}
+
 // excecuted once per 1ms.(excess for just timer count?)
 #ifndef __AVR_ATmega32A__
 #    define TIMER_INTERRUPT_VECTOR TIMER0_COMPA_vect
@@ -37,3 +37,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #if (TIMER_RAW_TOP > 255)
 #    error "Timer0 can't count 1ms at this clock freq. Use larger prescaler."
 #endif
+
+/* TIMER_RAW extended with the millisecond count, so that it doesn't wrap every millisecond */
+uint32_t timer_read_raw32(void);
@@ -0,0 +1,34 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Runs one job at a time off the main loop.
+ *
+ * Meant for work that mostly waits on a peripheral, such as pushing a frame out over I2C or SPI. While the job waits
+ * for its transfers to complete, the main loop keeps scanning. The job must not touch state the main loop modifies.
+ *
+ * There is a single worker, shared by RGB Matrix and Quantum Painter. When both hand it jobs, they run one after
+ * another, so starting a job may wait for the other feature's transfer to finish.
+ */
+
+typedef void (*background_worker_job_t)(void);
+
+/**
+ * @brief Hand a job to the worker. Waits for the previous job to finish first, so check
+ * `background_worker_busy()` beforehand to avoid blocking.
+ */
+void background_worker_start(background_worker_job_t job);
+
+/**
+ * @brief Whether a job is still running.
+ */
+bool background_worker_busy(void);
+
+/**
+ * @brief Block until the running job, if any, has finished.
+ */
+void background_worker_wait(void);
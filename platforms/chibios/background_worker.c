@@ -0,0 +1,54 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+
+#include "background_worker.h"
+
+#ifndef BACKGROUND_WORKER_STACK_SIZE
+#    define BACKGROUND_WORKER_STACK_SIZE 512
+#endif
+
+static BSEMAPHORE_DECL(job_ready, true);
+static BSEMAPHORE_DECL(job_idle, false);
+
+static volatile background_worker_job_t pending_job = NULL;
+static thread_t                        *worker      = NULL;
+
+/**
+ * @brief Runs above the main loop's priority, so a job starts straight away and the main loop
+ * only resumes once the job blocks on its peripheral.
+ */
+static THD_WORKING_AREA(waBackgroundWorker, BACKGROUND_WORKER_STACK_SIZE);
+static THD_FUNCTION(BackgroundWorker, arg) {
+    (void)arg;
+    chRegSetThreadName("background_worker");
+
+    while (true) {
+        chBSemWait(&job_ready);
+        pending_job();
+        chBSemSignal(&job_idle);
+    }
+}
+
+void background_worker_start(background_worker_job_t job) {
+    if (worker == NULL) {
+        worker = chThdCreateStatic(waBackgroundWorker, sizeof(waBackgroundWorker), NORMALPRIO + 1, BackgroundWorker, NULL);
+    }
+
+    chBSemWait(&job_idle);
+    pending_job = job;
+    chBSemSignal(&job_ready);
+}
+
+bool background_worker_busy(void) {
+    chSysLock();
+    bool busy = chBSemGetStateI(&job_idle);
+    chSysUnlock();
+    return busy;
+}
+
+void background_worker_wait(void) {
+    chBSemWait(&job_idle);
+    chBSemSignal(&job_idle);
+}
@@ -32,6 +32,11 @@
 #include <ch.h>
 #include <hal.h>
 
+// The LED driver is flushed from a background thread, which shares the bus with the main loop
+#if defined(RGB_MATRIX_ASYNC_FLUSH) && !defined(RGB_MATRIX_AW20216S) && !defined(RGB_MATRIX_WS2812) && I2C_USE_MUTUAL_EXCLUSION != TRUE
+#    error "RGB_MATRIX_ASYNC_FLUSH requires I2C_USE_MUTUAL_EXCLUSION to be TRUE in halconf.h"
+#endif
+
 #ifndef I2C1_SCL_PIN
 #    define I2C1_SCL_PIN B6
 #endif
@@ -109,6 +114,14 @@ static const I2CConfig i2cconfig = {
 #endif
 };
 
+// Transactions can come from more than one thread, for example when the LED
+// drivers are flushed in the background, so each one holds the bus.
+static inline void i2c_acquire(void) {
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+    i2cAcquireBus(&I2C_DRIVER);
+#endif
+}
+
 /**
  * @brief Handles any I2C error condition by stopping the I2C peripheral and
  * aborting any ongoing transactions. Furthermore ChibiOS status codes are
@@ -118,15 +131,20 @@ static const I2CConfig i2cconfig = {
  * @return i2c_status_t QMK specific I2C status code
  */
 static i2c_status_t i2c_epilogue(const msg_t status) {
-    if (status == MSG_OK) {
-        return I2C_STATUS_SUCCESS;
+    if (status != MSG_OK) {
+        // From ChibiOS HAL: "After a timeout the driver must be stopped and
+        // restarted because the bus is in an uncertain state." We also issue that
+        // hard stop in case of any error.
+        i2c_stop();
     }
 
-    // From ChibiOS HAL: "After a timeout the driver must be stopped and
-    // restarted because the bus is in an uncertain state." We also issue that
-    // hard stop in case of any error.
-    i2c_stop();
+#if I2C_USE_MUTUAL_EXCLUSION == TRUE
+    i2cReleaseBus(&I2C_DRIVER);
+#endif
 
+    if (status == MSG_OK) {
+        return I2C_STATUS_SUCCESS;
+    }
     return status == MSG_TIMEOUT ? I2C_STATUS_TIMEOUT : I2C_STATUS_ERROR;
 }
 
@@ -157,6 +175,7 @@ i2c_status_t i2c_start(uint8_t address) {
 }
 
 i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, 0, 0, TIME_MS2I(timeout));
@@ -164,6 +183,7 @@ i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length,
 }
 
 i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = address;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterReceiveTimeout(&I2C_DRIVER, (i2c_address >> 1), data, length, TIME_MS2I(timeout));
@@ -171,6 +191,7 @@ i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16
 }
 
 i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -185,6 +206,7 @@ i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data,
 }
 
 i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
 
@@ -200,6 +222,7 @@ i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* da
 }
 
 i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     msg_t status = i2cMasterTransmitTimeout(&I2C_DRIVER, (i2c_address >> 1), &regaddr, 1, data, length, TIME_MS2I(timeout));
@@ -207,6 +230,7 @@ i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16
 }
 
 i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_acquire();
     i2c_address = devaddr;
     i2cStart(&I2C_DRIVER, &i2cconfig);
     uint8_t register_packet[2] = {regaddr >> 8, regaddr & 0xFF};
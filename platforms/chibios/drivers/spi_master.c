@@ -18,6 +18,11 @@
 
 #include "timer.h"
 
+// The LED driver is flushed from a background thread, which shares the bus with the main loop
+#if defined(RGB_MATRIX_ASYNC_FLUSH) && defined(RGB_MATRIX_AW20216S) && SPI_USE_MUTUAL_EXCLUSION != TRUE
+#    error "RGB_MATRIX_ASYNC_FLUSH requires SPI_USE_MUTUAL_EXCLUSION to be TRUE in halconf.h"
+#endif
+
 static bool spiStarted = false;
 
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
@@ -26,6 +31,13 @@ static pin_t currentSlavePin;
 
 static SPIConfig spiConfig;
 
+#if SPI_USE_MUTUAL_EXCLUSION == TRUE
+// Transactions can come from more than one thread, for example when the LED
+// drivers are flushed in the background, so each one holds the bus from
+// spi_start() until spi_stop().
+static thread_t *spiOwner = NULL;
+#endif
+
 __attribute__((weak)) void spi_init(void) {
     static bool is_initialised = false;
     if (!is_initialised) {
@@ -63,7 +75,7 @@ __attribute__((weak)) void spi_init(void) {
     }
 }
 
-bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+static bool spi_start_locked(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
     if (spiStarted) {
         return false;
     }
@@ -315,6 +327,24 @@ spi_status_t spi_receive(uint8_t *data, uint16_t length) {
     return SPI_STATUS_SUCCESS;
 }
 
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+#if SPI_USE_MUTUAL_EXCLUSION == TRUE
+    // Starting twice from the same thread is a caller error, not something to wait on
+    if (spiStarted && spiOwner == chThdGetSelfX()) {
+        return false;
+    }
+    spiAcquireBus(&SPI_DRIVER);
+    if (!spi_start_locked(slavePin, lsbFirst, mode, divisor)) {
+        spiReleaseBus(&SPI_DRIVER);
+        return false;
+    }
+    spiOwner = chThdGetSelfX();
+    return true;
+#else
+    return spi_start_locked(slavePin, lsbFirst, mode, divisor);
+#endif
+}
+
 void spi_stop(void) {
     if (spiStarted) {
 #if SPI_SELECT_MODE == SPI_SELECT_MODE_NONE
@@ -325,5 +355,9 @@ void spi_stop(void) {
         spiUnselect(&SPI_DRIVER);
         spiStop(&SPI_DRIVER);
         spiStarted = false;
+#if SPI_USE_MUTUAL_EXCLUSION == TRUE
+        spiOwner = NULL;
+        spiReleaseBus(&SPI_DRIVER);
+#endif
     }
 }
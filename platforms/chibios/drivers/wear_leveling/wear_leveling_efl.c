@@ -120,6 +120,32 @@ bool backing_store_erase(void) {
     return ret;
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_partial(uint32_t address, uint32_t *erased_length) {
+    // Only whole sectors can be erased, so the address has to be at the start of one
+    for (flash_sector_t i = 0; i < sector_count; ++i) {
+        if (flashGetSectorOffset(flash, first_sector + i) != base_offset + address) {
+            continue;
+        }
+
+        flash_error_t status = flashStartEraseSector(flash, first_sector + i);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            return false;
+        }
+        status = flashWaitErase(flash);
+        if (status != FLASH_NO_ERROR && status != FLASH_BUSY_ERASING) {
+            return false;
+        }
+
+        *erased_length = flashGetSectorSize(flash, first_sector + i);
+        return true;
+    }
+
+    bs_dprintf("Address 0x%08lX is not at the start of a sector\n", (unsigned long)address);
+    return false;
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 bool backing_store_write(uint32_t address, backing_store_int_t value) {
     uint32_t offset = (base_offset + address);
     bs_dprintf("Write ");
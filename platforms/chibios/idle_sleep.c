@@ -0,0 +1,48 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <ch.h>
+#include <hal.h>
+
+#include "idle_sleep.h"
+
+#if !PAL_USE_CALLBACKS
+#    error "IDLE_SLEEP_ENABLE requires PAL_USE_CALLBACKS to be set to TRUE in halconf.h"
+#endif
+
+static thread_reference_t sleeping_thread = NULL;
+static bool               wakeup_pending  = false;
+
+static void idle_sleep_wakeup_cb(void *arg) {
+    (void)arg;
+    osalSysLockFromISR();
+    wakeup_pending = true;
+    osalThreadResumeI(&sleeping_thread, MSG_OK);
+    osalSysUnlockFromISR();
+}
+
+// On STM32 each EXTI line serves the same pad number on every port, so A0 and B0 can't both
+// be armed. Other ports number their pads uniquely, so the same check holds there too.
+bool idle_sleep_pins_share_event(pin_t a, pin_t b) {
+    return PAL_PAD(a) == PAL_PAD(b);
+}
+
+void idle_sleep_pin_enable(pin_t pin) {
+    palEnableLineEvent(pin, PAL_EVENT_MODE_BOTH_EDGES);
+    palSetLineCallback(pin, idle_sleep_wakeup_cb, NULL);
+}
+
+void idle_sleep_pin_disable(pin_t pin) {
+    palDisableLineEvent(pin);
+}
+
+void idle_sleep_wait(uint32_t duration_ms) {
+    osalSysLock();
+    // An edge between arming and here has already fired the callback
+    if (!wakeup_pending) {
+        // The idle thread halts the core until the line event or the timeout
+        osalThreadSuspendTimeoutS(&sleeping_thread, TIME_MS2I(duration_ms));
+    }
+    wakeup_pending = false;
+    osalSysUnlock();
+}
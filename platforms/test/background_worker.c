@@ -0,0 +1,52 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "background_worker_sim.h"
+
+#include <stddef.h>
+#include "timer.h"
+
+void advance_time(uint32_t ms);
+
+static background_worker_job_t pending_job = NULL;
+static uint32_t                started     = 0;
+static uint32_t                latency     = 0;
+static uint32_t                jobs_run    = 0;
+
+void background_worker_sim_set_latency(uint32_t ms) {
+    latency = ms;
+}
+
+uint32_t background_worker_sim_jobs_run(void) {
+    return jobs_run;
+}
+
+static void run_pending_job(void) {
+    background_worker_job_t job = pending_job;
+    pending_job                 = NULL;
+    job();
+    jobs_run++;
+}
+
+void background_worker_start(background_worker_job_t job) {
+    background_worker_wait();
+    pending_job = job;
+    started     = timer_read32();
+}
+
+bool background_worker_busy(void) {
+    if (pending_job != NULL && timer_elapsed32(started) >= latency) {
+        run_pending_job();
+    }
+    return pending_job != NULL;
+}
+
+void background_worker_wait(void) {
+    if (pending_job != NULL) {
+        uint32_t elapsed = timer_elapsed32(started);
+        if (elapsed < latency) {
+            advance_time(latency - elapsed);
+        }
+        run_pending_job();
+    }
+}
@@ -0,0 +1,17 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Background worker for the test platform.
+
+    A job is held back until the simulated clock has moved on by the configured latency, standing
+    in for the time its transfers would take, and then runs the next time the worker is polled.
+    Waiting on the worker advances the clock by whatever latency is left.
+*/
+
+#include <stdint.h>
+#include "background_worker.h"
+
+void     background_worker_sim_set_latency(uint32_t ms);
+uint32_t background_worker_sim_jobs_run(void);
@@ -0,0 +1,91 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_master.h"
+
+#include <string.h>
+
+static i2c_mock_stats_t    stats;
+static i2c_mock_write_cb_t write_callback = NULL;
+static bool                failing        = false;
+
+void i2c_mock_reset(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void i2c_mock_get_stats(i2c_mock_stats_t* out) {
+    *out = stats;
+}
+
+void i2c_mock_set_write_callback(i2c_mock_write_cb_t callback) {
+    write_callback = callback;
+}
+
+void i2c_mock_set_failing(bool fail) {
+    failing = fail;
+}
+
+static void count(uint16_t length) {
+    stats.transactions++;
+    stats.bytes += 1 + length;
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_start(uint8_t address) {
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    if (failing) {
+        return I2C_STATUS_ERROR;
+    }
+    count(length);
+    if (write_callback) {
+        write_callback(address, data, length);
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout) {
+    if (failing) {
+        return I2C_STATUS_ERROR;
+    }
+    count(length);
+    memset(data, 0, length);
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    uint8_t buffer[length + 1];
+    buffer[0] = regaddr;
+    memcpy(buffer + 1, data, length);
+    return i2c_transmit(devaddr, buffer, length + 1, timeout);
+}
+
+i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    uint8_t buffer[length + 2];
+    buffer[0] = regaddr >> 8;
+    buffer[1] = regaddr & 0xFF;
+    memcpy(buffer + 2, data, length);
+    return i2c_transmit(devaddr, buffer, length + 2, timeout);
+}
+
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_status_t status = i2c_transmit(devaddr, &regaddr, 1, timeout);
+    if (status == I2C_STATUS_SUCCESS) {
+        status = i2c_receive(devaddr, data, length, timeout);
+    }
+    return status;
+}
+
+i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout) {
+    uint8_t address[2] = {regaddr >> 8, regaddr & 0xFF};
+    i2c_status_t status = i2c_transmit(devaddr, address, 2, timeout);
+    if (status == I2C_STATUS_SUCCESS) {
+        status = i2c_receive(devaddr, data, length, timeout);
+    }
+    return status;
+}
+
+void i2c_stop(void) {}
@@ -0,0 +1,43 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    I2C master for the test platform.
+
+    Nothing is attached to the bus; every transaction succeeds and is counted, so tests can
+    measure the bus traffic of a driver. A device model can be attached to observe writes,
+    and the bus can be made to fail every transaction until told otherwise.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_start(uint8_t address);
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_receive(uint8_t address, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_writeReg(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_writeReg16(uint8_t devaddr, uint16_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_readReg(uint8_t devaddr, uint8_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
+i2c_status_t i2c_readReg16(uint8_t devaddr, uint16_t regaddr, uint8_t* data, uint16_t length, uint16_t timeout);
+void         i2c_stop(void);
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes; // on the wire, including the device address of each transaction
+} i2c_mock_stats_t;
+
+/* Called for every write with the 8-bit device address and the bytes that followed it. */
+typedef void (*i2c_mock_write_cb_t)(uint8_t address, const uint8_t* data, uint16_t length);
+
+void i2c_mock_reset(void);
+void i2c_mock_get_stats(i2c_mock_stats_t* stats);
+void i2c_mock_set_write_callback(i2c_mock_write_cb_t callback);
+void i2c_mock_set_failing(bool fail);
@@ -0,0 +1,93 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "is31fl3733_sim.h"
+
+#include <string.h>
+#include "i2c_master.h"
+#include "is31fl3733.h"
+#include "rgb_matrix.h"
+#include "progmem.h"
+
+#define IS31FL3733_SIM_PWM_REGISTER_COUNT 192
+
+_Static_assert(IS31FL3733_LED_COUNT == 40, "The simulated board has 40 LEDs");
+
+// Red, green and blue on consecutive SW lines sharing a CS line, 16 LEDs per group of three
+#define LED(i) \
+    { 0, ((i) / 16 * 3 + 0) * 16 + (i) % 16, ((i) / 16 * 3 + 1) * 16 + (i) % 16, ((i) / 16 * 3 + 2) * 16 + (i) % 16 }
+
+// clang-format off
+const is31fl3733_led_t PROGMEM g_is31fl3733_leds[IS31FL3733_LED_COUNT] = {
+    LED(0),  LED(1),  LED(2),  LED(3),  LED(4),  LED(5),  LED(6),  LED(7),  LED(8),  LED(9),
+    LED(10), LED(11), LED(12), LED(13), LED(14), LED(15), LED(16), LED(17), LED(18), LED(19),
+    LED(20), LED(21), LED(22), LED(23), LED(24), LED(25), LED(26), LED(27), LED(28), LED(29),
+    LED(30), LED(31), LED(32), LED(33), LED(34), LED(35), LED(36), LED(37), LED(38), LED(39),
+};
+
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {
+        {0, 0},  {24, 0},  {48, 0},  {72, 0},  {96, 0},  {120, 0},  {144, 0},  {168, 0},  {192, 0},  {224, 0},
+        {0, 21}, {24, 21}, {48, 21}, {72, 21}, {96, 21}, {120, 21}, {144, 21}, {168, 21}, {192, 21}, {224, 21},
+        {0, 42}, {24, 42}, {48, 42}, {72, 42}, {96, 42}, {120, 42}, {144, 42}, {168, 42}, {192, 42}, {224, 42},
+        {0, 64}, {24, 64}, {48, 64}, {72, 64}, {96, 64}, {120, 64}, {144, 64}, {168, 64}, {192, 64}, {224, 64},
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    },
+};
+// clang-format on
+
+static struct {
+    uint8_t  page;
+    uint8_t  pwm[IS31FL3733_SIM_PWM_REGISTER_COUNT];
+    uint32_t flushes;
+} chip;
+
+static void is31fl3733_sim_write(uint8_t address, const uint8_t *data, uint16_t length) {
+    if (address != IS31FL3733_I2C_ADDRESS_1 << 1 || length < 2) {
+        return;
+    }
+    if (data[0] == IS31FL3733_REG_COMMAND) {
+        chip.page = data[1];
+        if (chip.page == IS31FL3733_COMMAND_PWM) {
+            chip.flushes++;
+        }
+        return;
+    }
+    if (data[0] == IS31FL3733_REG_COMMAND_WRITE_LOCK || chip.page != IS31FL3733_COMMAND_PWM) {
+        return;
+    }
+    for (uint16_t i = 1; i < length && data[0] + i - 1 < IS31FL3733_SIM_PWM_REGISTER_COUNT; i++) {
+        chip.pwm[data[0] + i - 1] = data[i];
+    }
+}
+
+void is31fl3733_sim_attach(void) {
+    i2c_mock_set_write_callback(is31fl3733_sim_write);
+}
+
+uint8_t is31fl3733_sim_read_pwm(uint8_t reg) {
+    return reg < IS31FL3733_SIM_PWM_REGISTER_COUNT ? chip.pwm[reg] : 0;
+}
+
+bool is31fl3733_sim_pwm_matches(const uint8_t *buffer) {
+    return memcmp(chip.pwm, buffer, sizeof(chip.pwm)) == 0;
+}
+
+uint32_t is31fl3733_sim_flushes(void) {
+    return chip.flushes;
+}
+
+void is31fl3733_sim_reset_flushes(void) {
+    chip.flushes = 0;
+}
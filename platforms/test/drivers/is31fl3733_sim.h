@@ -0,0 +1,25 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    An IS31FL3733 on the test platform's I2C bus, shared by the RGB Matrix test suites.
+
+    Enough of the chip to follow page selection and PWM register writes. The LED map and
+    g_led_config wire up a 4x10 board with one RGB LED per key, so suites using this model
+    need RGB_MATRIX_LED_COUNT set to 40 and the chip at IS31FL3733_I2C_ADDRESS_1.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Routes the mock bus writes to the chip */
+void is31fl3733_sim_attach(void);
+
+uint8_t is31fl3733_sim_read_pwm(uint8_t reg);
+/* Whether the chip's PWM page holds the same values as the driver buffer */
+bool is31fl3733_sim_pwm_matches(const uint8_t *buffer);
+
+/* Number of times the PWM page was selected, which the driver does once per flush */
+uint32_t is31fl3733_sim_flushes(void);
+void     is31fl3733_sim_reset_flushes(void);
@@ -0,0 +1,74 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "spi_master.h"
+
+#include <string.h>
+
+static spi_mock_stats_t    stats;
+static spi_mock_write_cb_t write_callback = NULL;
+static pin_t               current_slave_pin;
+static bool                started = false;
+
+void spi_mock_reset(void) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void spi_mock_get_stats(spi_mock_stats_t* out) {
+    *out = stats;
+}
+
+void spi_mock_set_write_callback(spi_mock_write_cb_t callback) {
+    write_callback = callback;
+}
+
+void spi_init(void) {}
+
+bool spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor) {
+    if (started) {
+        return false;
+    }
+    started           = true;
+    current_slave_pin = slavePin;
+    stats.transactions++;
+    writePinLow(slavePin);
+    return true;
+}
+
+spi_status_t spi_transmit(const uint8_t* data, uint16_t length) {
+    if (!started) {
+        return SPI_STATUS_ERROR;
+    }
+    stats.bytes += length;
+    if (write_callback) {
+        write_callback(current_slave_pin, data, length);
+    }
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_write(uint8_t data) {
+    spi_status_t status = spi_transmit(&data, 1);
+    return status == SPI_STATUS_SUCCESS ? data : status;
+}
+
+spi_status_t spi_receive(uint8_t* data, uint16_t length) {
+    if (!started) {
+        return SPI_STATUS_ERROR;
+    }
+    stats.bytes += length;
+    memset(data, 0, length);
+    return SPI_STATUS_SUCCESS;
+}
+
+spi_status_t spi_read(void) {
+    uint8_t data;
+    spi_status_t status = spi_receive(&data, 1);
+    return status == SPI_STATUS_SUCCESS ? data : status;
+}
+
+void spi_stop(void) {
+    if (started) {
+        writePinHigh(current_slave_pin);
+        started = false;
+    }
+}
@@ -0,0 +1,44 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    SPI master for the test platform.
+
+    Nothing is attached to the bus; every transfer succeeds and is counted, so tests can
+    measure the bus traffic of a driver. A device model can be attached to observe writes.
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "gpio.h"
+
+typedef int16_t spi_status_t;
+
+#define SPI_STATUS_SUCCESS (0)
+#define SPI_STATUS_ERROR (-1)
+#define SPI_STATUS_TIMEOUT (-2)
+
+#define SPI_TIMEOUT_IMMEDIATE (0)
+#define SPI_TIMEOUT_INFINITE (0xFFFF)
+
+void         spi_init(void);
+bool         spi_start(pin_t slavePin, bool lsbFirst, uint8_t mode, uint16_t divisor);
+spi_status_t spi_write(uint8_t data);
+spi_status_t spi_read(void);
+spi_status_t spi_transmit(const uint8_t* data, uint16_t length);
+spi_status_t spi_receive(uint8_t* data, uint16_t length);
+void         spi_stop(void);
+
+typedef struct {
+    uint32_t transactions; // spi_start() to spi_stop()
+    uint32_t bytes;
+} spi_mock_stats_t;
+
+/* Called for every write with the chip select pin of the current transaction and the bytes written. */
+typedef void (*spi_mock_write_cb_t)(pin_t slave_pin, const uint8_t* data, uint16_t length);
+
+void spi_mock_reset(void);
+void spi_mock_get_stats(spi_mock_stats_t* stats);
+void spi_mock_set_write_callback(spi_mock_write_cb_t callback);
@@ -0,0 +1,14 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gpio.h"
+
+static bool levels[256];
+
+void gpio_sim_write_pin(pin_t pin, bool level) {
+    levels[pin] = level;
+}
+
+bool gpio_sim_read_pin(pin_t pin) {
+    return levels[pin];
+}
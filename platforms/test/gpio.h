@@ -0,0 +1,21 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// There is no GPIO to drive. Output levels are remembered, so tests can observe pins such as a display's D/C line.
+// Inputs are left to the tests to mock.
+typedef uint8_t pin_t;
+
+void gpio_sim_write_pin(pin_t pin, bool level);
+bool gpio_sim_read_pin(pin_t pin);
+
+#define setPinOutputPushPull(pin) ((void)(pin))
+#define setPinOutputOpenDrain(pin) ((void)(pin))
+#define setPinOutput(pin) setPinOutputPushPull(pin)
+
+#define writePinHigh(pin) gpio_sim_write_pin(pin, true)
+#define writePinLow(pin) gpio_sim_write_pin(pin, false)
+#define writePin(pin, level) gpio_sim_write_pin(pin, level)
@@ -0,0 +1,20 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "idle_sleep.h"
+
+void advance_time(uint32_t ms);
+
+// Modelled on STM32, where pins 16 apart (the same pad on another port) share an event line
+bool idle_sleep_pins_share_event(pin_t a, pin_t b) {
+    return a % 16 == b % 16;
+}
+
+void idle_sleep_pin_enable(pin_t pin) {}
+
+void idle_sleep_pin_disable(pin_t pin) {}
+
+// Nothing can interrupt the simulated clock, so sleeping runs it to the deadline
+void idle_sleep_wait(uint32_t duration_ms) {
+    advance_time(duration_ms);
+}
@@ -0,0 +1,180 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "split_sim.h"
+
+#include <string.h>
+#include "serial.h"
+#include "transactions.h"
+#include "action_layer.h"
+#include "action_util.h"
+
+void advance_time(uint32_t ms);
+
+static split_sim_link_t      sim_link;
+static split_sim_stats_t     stats;
+static split_shared_memory_t slave_memory;
+static matrix_row_t          slave_mirror[(MATRIX_ROWS) / 2]; // the slave's copy of the master half
+static bool                  in_slave        = false;
+static uint32_t              elapsed_us      = 0;
+static uint32_t              random_state    = 1;
+static uint32_t              byte_time_carry = 0;
+
+// Globals the slave handlers overwrite, put back once the slave is done with them
+static struct {
+#ifndef NO_ACTION_LAYER
+    layer_state_t layer_state;
+    layer_state_t default_layer_state;
+#endif
+    uint8_t mods;
+    uint8_t weak_mods;
+    uint8_t oneshot_mods;
+} master_state;
+
+bool is_keyboard_master(void) {
+    return !in_slave;
+}
+
+bool is_keyboard_left(void) {
+    return !in_slave;
+}
+
+static void link_elapse(uint32_t us) {
+    elapsed_us += us;
+    if (elapsed_us >= 1000) {
+        advance_time(elapsed_us / 1000);
+        elapsed_us %= 1000;
+    }
+}
+
+// xorshift32, so a given seed always produces the same sequence of link faults
+static bool link_chance(uint32_t ppm) {
+    if (ppm == 0) {
+        return false;
+    }
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return (random_state % 1000000) < ppm;
+}
+
+static bool link_transfer(uint8_t *destination, const uint8_t *source, uint16_t length) {
+    for (uint16_t i = 0; i < length; i++) {
+        stats.bytes++;
+        if (sim_link.bytes_per_second) {
+            // Carry the sub-microsecond remainder so that short transfers still add up
+            byte_time_carry += 1000000;
+            link_elapse(byte_time_carry / sim_link.bytes_per_second);
+            byte_time_carry %= sim_link.bytes_per_second;
+        }
+        if (link_chance(sim_link.drop_ppm)) {
+            stats.dropped++;
+            link_elapse(sim_link.timeout_us);
+            return false;
+        }
+        uint8_t data = source ? source[i] : 0;
+        if (link_chance(sim_link.corrupt_ppm)) {
+            stats.corrupted++;
+            data ^= 1 << (random_state & 7);
+            // A corrupted handshake is caught by the protocol itself
+            if (!destination) {
+                return false;
+            }
+        }
+        if (destination) {
+            destination[i] = data;
+        }
+    }
+    return true;
+}
+
+static void swap_shared_memory(void) {
+    split_shared_memory_t temp;
+    memcpy(&temp, split_shmem, sizeof(split_shared_memory_t));
+    memcpy(split_shmem, &slave_memory, sizeof(split_shared_memory_t));
+    memcpy(&slave_memory, &temp, sizeof(split_shared_memory_t));
+}
+
+// While the slave runs, split_shmem holds the slave's copy and the master's is set aside
+static void enter_slave(void) {
+#ifndef NO_ACTION_LAYER
+    master_state.layer_state         = layer_state;
+    master_state.default_layer_state = default_layer_state;
+#endif
+    master_state.mods         = get_mods();
+    master_state.weak_mods    = get_weak_mods();
+    master_state.oneshot_mods = get_oneshot_mods();
+    swap_shared_memory();
+    in_slave = true;
+}
+
+static void leave_slave(void) {
+    in_slave = false;
+    swap_shared_memory();
+#ifndef NO_ACTION_LAYER
+    layer_state         = master_state.layer_state;
+    default_layer_state = master_state.default_layer_state;
+#endif
+    set_mods(master_state.mods);
+    set_weak_mods(master_state.weak_mods);
+    set_oneshot_mods(master_state.oneshot_mods);
+}
+
+void soft_serial_initiator_init(void) {}
+
+void soft_serial_target_init(void) {}
+
+bool soft_serial_transaction(int index) {
+    split_transaction_desc_t *trans  = &split_transaction_table[index];
+    uint8_t                  *master = (uint8_t *)split_shmem;
+    uint8_t                  *slave  = (uint8_t *)&slave_memory;
+
+    stats.transactions++;
+    link_elapse(sim_link.latency_us);
+
+    // Transaction ID out, handshake back, then the buffers in the same order as serial_protocol.c
+    bool okay = link_transfer(NULL, NULL, 2);
+    if (okay && trans->initiator2target_buffer_size) {
+        okay = link_transfer(slave + trans->initiator2target_offset, master + trans->initiator2target_offset, trans->initiator2target_buffer_size);
+    }
+    if (okay && trans->slave_callback) {
+        enter_slave();
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+        leave_slave();
+    }
+    if (okay && trans->target2initiator_buffer_size) {
+        okay = link_transfer(master + trans->target2initiator_offset, slave + trans->target2initiator_offset, trans->target2initiator_buffer_size);
+    }
+
+    if (!okay) {
+        stats.failed++;
+    }
+    return okay;
+}
+
+void split_sim_slave_task(matrix_row_t slave_matrix[]) {
+    enter_slave();
+    transport_slave(slave_mirror, slave_matrix);
+    leave_slave();
+}
+
+split_shared_memory_t *split_sim_slave_shmem(void) {
+    return &slave_memory;
+}
+
+void split_sim_set_link(const split_sim_link_t *new_link) {
+    sim_link     = *new_link;
+    random_state = sim_link.seed ? sim_link.seed : 1;
+}
+
+void split_sim_get_stats(split_sim_stats_t *out) {
+    *out = stats;
+}
+
+void split_sim_reset(void) {
+    memset(&sim_link, 0, sizeof(sim_link));
+    memset(&stats, 0, sizeof(stats));
+    random_state    = 1;
+    elapsed_us      = 0;
+    byte_time_carry = 0;
+}
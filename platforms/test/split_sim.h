@@ -0,0 +1,48 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Split keyboard simulator for the test platform.
+
+    Both halves run in the same process. The master half is the keyboard under test; the
+    slave half is driven by split_sim_slave_task() and keeps its own copy of the split shared
+    memory. Transactions cross an in-memory serial link that can add latency, limit bandwidth,
+    and drop or corrupt bytes. Time spent on the link advances the simulated clock.
+
+    Feature state that the firmware keeps in globals exists once for both halves. Layer state
+    and modifiers applied by the slave are put back when it returns, so that a corrupted
+    transfer cannot leak into the master; check what the slave received through
+    split_sim_slave_shmem() instead.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrix.h"
+#include "transport.h"
+
+typedef struct {
+    uint32_t latency_us;       // turnaround cost of each transaction
+    uint32_t bytes_per_second; // 0 for unlimited
+    uint32_t drop_ppm;         // chance per million that a byte is lost, failing the transaction
+    uint32_t corrupt_ppm;      // chance per million that a byte arrives with a flipped bit
+    uint32_t timeout_us;       // time the master waits before giving up on a lost byte
+    uint32_t seed;
+} split_sim_link_t;
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t failed;
+    uint32_t bytes; // in both directions, including the transaction handshake
+    uint32_t dropped;
+    uint32_t corrupted;
+} split_sim_stats_t;
+
+void split_sim_reset(void);
+void split_sim_set_link(const split_sim_link_t *link);
+void split_sim_get_stats(split_sim_stats_t *stats);
+
+/* Runs one scan of the slave half with the given physical matrix state. */
+void split_sim_slave_task(matrix_row_t slave_matrix[]);
+
+split_shared_memory_t *split_sim_slave_shmem(void);
@@ -27,6 +27,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "action_tapping.h"
 #include "action_util.h"
 #include "action.h"
+#include "latency_tracing.h"
 #include "wait.h"
 #include "qmk_settings.h"
 #include "keycode_config.h"
@@ -272,17 +273,23 @@ void process_record(keyrecord_t *record) {
         return;
     }
 
+#ifdef LATENCY_TRACING_ENABLE
+    latency_tracing_begin_record(record);
+#endif
+
     if (!process_record_quantum(record)) {
 #ifndef NO_ACTION_ONESHOT
         if (is_oneshot_layer_active() && record->event.pressed && keymap_config.oneshot_enable) {
             clear_oneshot_layer_state(ONESHOT_OTHER_KEY_PRESSED);
         }
 #endif
+        LATENCY_TRACING_END();
         return;
     }
 
     process_record_handler(record);
     post_process_record_quantum(record);
+    LATENCY_TRACING_END();
 }
 
 void process_record_handler(keyrecord_t *record) {
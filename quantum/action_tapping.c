@@ -6,6 +6,7 @@
 #include "action_tapping.h"
 #include "keycode.h"
 #include "timer.h"
+#include "latency_tracing.h"
 
 #ifndef NO_ACTION_TAPPING
 
@@ -99,7 +100,10 @@ void action_tapping_process(keyrecord_t record) {
         ac_dprintf("---- action_exec: process waiting_buffer -----\n");
     }
     for (; waiting_buffer_tail != waiting_buffer_head; waiting_buffer_tail = (waiting_buffer_tail + 1) % WAITING_BUFFER_SIZE) {
-        if (process_tapping(&waiting_buffer[waiting_buffer_tail])) {
+        LATENCY_TRACING_BEGIN(waiting_buffer[waiting_buffer_tail].event.time, LATENCY_PATH_TAP_HOLD);
+        bool processed = process_tapping(&waiting_buffer[waiting_buffer_tail]);
+        LATENCY_TRACING_END();
+        if (processed) {
             ac_dprintf("processed: waiting_buffer[%u] =", waiting_buffer_tail);
             debug_record(waiting_buffer[waiting_buffer_tail]);
             ac_dprintf("\n\n");
@@ -112,6 +116,14 @@ void action_tapping_process(keyrecord_t record) {
     }
 }
 
+/** \brief Whether a tap-hold key is undecided or keys are held back waiting for one
+ *
+ * Both are resolved by a later event or by the tapping term expiring on a tick event.
+ */
+bool is_tapping_pending(void) {
+    return IS_EVENT(tapping_key.event) || waiting_buffer_head != waiting_buffer_tail;
+}
+
 /* Some conditionally defined helper macros to keep process_tapping more
  * readable. The conditional definition of tapping_keycode and all the
  * conditional uses of it are hidden inside macros named TAP_...
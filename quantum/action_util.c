@@ -22,6 +22,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "timer.h"
 #include "keycode_config.h"
 #include "qmk_settings.h"
+#include "latency_tracing.h"
 #include <string.h>
 
 extern keymap_config_t keymap_config;
@@ -325,6 +326,9 @@ uint8_t get_mods(void) {
  * FIXME: needs doc
  */
 void add_mods(uint8_t mods) {
+#ifdef LATENCY_TRACING_ENABLE
+    latency_tracing_mods_added(mods & ~real_mods);
+#endif
     real_mods |= mods;
 }
 /** \brief del mods
@@ -361,6 +365,9 @@ uint8_t get_weak_mods(void) {
  * FIXME: needs doc
  */
 void add_weak_mods(uint8_t mods) {
+#ifdef LATENCY_TRACING_ENABLE
+    latency_tracing_mods_added(mods & ~weak_mods);
+#endif
     weak_mods |= mods;
 }
 /** \brief del weak mods
@@ -19,9 +19,13 @@
         PROFILE_CALL_NAMED(1000, "matrix_task", {
             matrix_task();
         });
+
+    For continuous per-task histograms instead of periodic averages, see task_profiling.h.
 */
 
-#if defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
+#if defined(TIMESTAMP_GETTER)
+// Supplied by the keyboard (or test harness)
+#elif defined(PROTOCOL_LUFA) || defined(PROTOCOL_VUSB)
 #    define TIMESTAMP_GETTER TCNT0
 #elif defined(PROTOCOL_CHIBIOS)
 #    define TIMESTAMP_GETTER chSysGetRealtimeCounterX()
@@ -150,6 +150,26 @@ void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count,
     }
 }
 
+uint32_t deferred_exec_advanced_next_delay(deferred_executor_t *table, size_t table_count) {
+    uint32_t now   = timer_read32();
+    uint32_t delay = UINT32_MAX;
+
+    for (int i = 0; i < table_count; ++i) {
+        deferred_executor_t *entry = &table[i];
+        if (entry->token != INVALID_DEFERRED_TOKEN) {
+            int32_t remaining = (int32_t)TIMER_DIFF_32(entry->trigger_time, now);
+            if (remaining <= 0) {
+                return 0;
+            }
+            if ((uint32_t)remaining < delay) {
+                delay = remaining;
+            }
+        }
+    }
+
+    return delay;
+}
+
 //------------------------------------
 // Basic API: used by user-mode code, guaranteed to not collide with core deferred execution
 //
@@ -169,3 +189,6 @@ bool cancel_deferred_exec(deferred_token token) {
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
+uint32_t deferred_exec_next_delay(void) {
+    return deferred_exec_advanced_next_delay(basic_executors, MAX_DEFERRED_EXECUTORS);
+}
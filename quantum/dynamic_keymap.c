@@ -132,6 +132,122 @@ _Static_assert(DYNAMIC_KEYMAP_EEPROM_MAX_ADDR >= DYNAMIC_KEYMAP_MACRO_EEPROM_ADD
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+// Number of macro bytes fetched from EEPROM at a time when sending a macro
+#ifndef DYNAMIC_KEYMAP_MACRO_READ_BLOCK_SIZE
+#    define DYNAMIC_KEYMAP_MACRO_READ_BLOCK_SIZE 16
+#endif
+
+// Keep a RAM copy of the keymap so that lookups never have to go through the
+// EEPROM driver. Boards short on SRAM can opt out with DYNAMIC_KEYMAP_NO_CACHE.
+#if !defined(DYNAMIC_KEYMAP_NO_CACHE) && !defined(__AVR__)
+#    define DYNAMIC_KEYMAP_CACHE_ENABLE
+#endif
+
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+// Native endian, same layer/row/column order as the EEPROM buffer
+static uint16_t dynamic_keymap_cache[DYNAMIC_KEYMAP_LAYER_COUNT][MATRIX_ROWS][MATRIX_COLS];
+
+static void dynamic_keymap_cache_load(void) {
+    uint16_t *entry = &dynamic_keymap_cache[0][0][0];
+    eeprom_read_block(entry, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, sizeof(dynamic_keymap_cache));
+    // Data in EEPROM is big endian, convert in place
+    for (uint16_t i = 0; i < DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS; i++) {
+        uint8_t *bytes = (uint8_t *)&entry[i];
+        entry[i]       = (bytes[0] << 8) | bytes[1];
+    }
+}
+
+static void dynamic_keymap_cache_update_byte(uint16_t offset, uint8_t value) {
+    uint16_t *entry = &dynamic_keymap_cache[0][0][0] + (offset / 2);
+    if (offset % 2 == 0) {
+        *entry = (*entry & 0x00FF) | (value << 8);
+    } else {
+        *entry = (*entry & 0xFF00) | value;
+    }
+}
+#endif // DYNAMIC_KEYMAP_CACHE_ENABLE
+
+// Start of each macro within the macro buffer, so sending macro N does not
+// have to walk the buffer counting null terminators first.
+#define DYNAMIC_KEYMAP_MACRO_OFFSET_INVALID 0xFFFF
+
+static uint16_t dynamic_keymap_macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT];
+static bool     dynamic_keymap_macro_offsets_valid = false;
+
+typedef struct {
+    uint16_t offset; // offset of buffer[0] within the macro buffer
+    uint16_t position;
+    uint16_t length;
+    uint8_t  buffer[DYNAMIC_KEYMAP_MACRO_READ_BLOCK_SIZE];
+} dynamic_keymap_macro_reader_t;
+
+static void dynamic_keymap_macro_reader_init(dynamic_keymap_macro_reader_t *reader, uint16_t offset) {
+    reader->offset   = offset;
+    reader->position = 0;
+    reader->length   = 0;
+}
+
+// Returns the next byte of the macro buffer, or 0 once past its end
+static uint8_t dynamic_keymap_macro_reader_next(dynamic_keymap_macro_reader_t *reader) {
+    if (reader->position == reader->length) {
+        reader->offset += reader->length;
+        if (reader->offset >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+            reader->length = 0;
+            return 0;
+        }
+        uint16_t remaining = DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - reader->offset;
+        reader->length     = remaining < sizeof(reader->buffer) ? remaining : sizeof(reader->buffer);
+        reader->position   = 0;
+        eeprom_read_block(reader->buffer, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + reader->offset, reader->length);
+    }
+    return reader->buffer[reader->position++];
+}
+
+static void dynamic_keymap_macro_rebuild_offsets(void) {
+    dynamic_keymap_macro_offsets_valid = false;
+
+    // Check the last byte of the buffer.
+    // If it's not zero, then we are in the middle
+    // of buffer writing, possibly an aborted buffer
+    // write. Leave the index invalid so nothing gets sent.
+    if (eeprom_read_byte(((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1) != 0) {
+        return;
+    }
+
+    // Macro N starts right after the Nth null terminator. If there are
+    // fewer than DYNAMIC_KEYMAP_MACRO_COUNT strings in the buffer, the
+    // remaining macros are marked as missing.
+    dynamic_keymap_macro_reader_t reader;
+    dynamic_keymap_macro_reader_init(&reader, 0);
+    uint8_t id                       = 0;
+    dynamic_keymap_macro_offsets[id] = 0;
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE && id + 1 < DYNAMIC_KEYMAP_MACRO_COUNT; offset++) {
+        if (dynamic_keymap_macro_reader_next(&reader) == 0) {
+            dynamic_keymap_macro_offsets[++id] = offset + 1;
+        }
+    }
+    while (++id < DYNAMIC_KEYMAP_MACRO_COUNT) {
+        dynamic_keymap_macro_offsets[id] = DYNAMIC_KEYMAP_MACRO_OFFSET_INVALID;
+    }
+
+    dynamic_keymap_macro_offsets_valid = true;
+}
+
+// Number of bytes of a host transfer at offset that lie within a buffer of buffer_size bytes
+static uint16_t dynamic_keymap_buffer_length(uint16_t buffer_size, uint16_t offset, uint16_t size) {
+    if (offset >= buffer_size) {
+        return 0;
+    }
+    return (buffer_size - offset) < size ? (buffer_size - offset) : size;
+}
+
+void dynamic_keymap_init(void) {
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    dynamic_keymap_cache_load();
+#endif
+    dynamic_keymap_macro_rebuild_offsets();
+}
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -143,15 +259,22 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    return dynamic_keymap_cache[layer][row][column];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    dynamic_keymap_cache[layer][row][column] = keycode;
+#endif
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
@@ -186,7 +309,7 @@ uint8_t dynamic_keymap_get_qmk_settings(uint16_t offset) {
     if (offset >= VIAL_QMK_SETTINGS_SIZE)
         return 0;
 
-    void *address = (void*)(VIAL_QMK_SETTINGS_EEPROM_ADDR + offset);
+    void *address = ((void *)VIAL_QMK_SETTINGS_EEPROM_ADDR) + offset;
     return eeprom_read_byte(address);
 }
 
@@ -194,7 +317,7 @@ void dynamic_keymap_set_qmk_settings(uint16_t offset, uint8_t value) {
     if (offset >= VIAL_QMK_SETTINGS_SIZE)
         return;
 
-    void *address = (void*)(VIAL_QMK_SETTINGS_EEPROM_ADDR + offset);
+    void *address = ((void *)VIAL_QMK_SETTINGS_EEPROM_ADDR) + offset;
     eeprom_update_byte(address, value);
 }
 #endif
@@ -204,7 +327,7 @@ int dynamic_keymap_get_tap_dance(uint8_t index, vial_tap_dance_entry_t *entry) {
     if (index >= VIAL_TAP_DANCE_ENTRIES)
         return -1;
 
-    void *address = (void*)(VIAL_TAP_DANCE_EEPROM_ADDR + index * sizeof(vial_tap_dance_entry_t));
+    void *address = ((void *)VIAL_TAP_DANCE_EEPROM_ADDR) + index * sizeof(vial_tap_dance_entry_t);
     eeprom_read_block(entry, address, sizeof(vial_tap_dance_entry_t));
 
     return 0;
@@ -214,7 +337,7 @@ int dynamic_keymap_set_tap_dance(uint8_t index, const vial_tap_dance_entry_t *en
     if (index >= VIAL_TAP_DANCE_ENTRIES)
         return -1;
 
-    void *address = (void*)(VIAL_TAP_DANCE_EEPROM_ADDR + index * sizeof(vial_tap_dance_entry_t));
+    void *address = ((void *)VIAL_TAP_DANCE_EEPROM_ADDR) + index * sizeof(vial_tap_dance_entry_t);
     eeprom_write_block(entry, address, sizeof(vial_tap_dance_entry_t));
 
     return 0;
@@ -226,7 +349,7 @@ int dynamic_keymap_get_combo(uint8_t index, vial_combo_entry_t *entry) {
     if (index >= VIAL_COMBO_ENTRIES)
         return -1;
 
-    void *address = (void*)(VIAL_COMBO_EEPROM_ADDR + index * sizeof(vial_combo_entry_t));
+    void *address = ((void *)VIAL_COMBO_EEPROM_ADDR) + index * sizeof(vial_combo_entry_t);
     eeprom_read_block(entry, address, sizeof(vial_combo_entry_t));
 
     return 0;
@@ -236,7 +359,7 @@ int dynamic_keymap_set_combo(uint8_t index, const vial_combo_entry_t *entry) {
     if (index >= VIAL_COMBO_ENTRIES)
         return -1;
 
-    void *address = (void*)(VIAL_COMBO_EEPROM_ADDR + index * sizeof(vial_combo_entry_t));
+    void *address = ((void *)VIAL_COMBO_EEPROM_ADDR) + index * sizeof(vial_combo_entry_t);
     eeprom_write_block(entry, address, sizeof(vial_combo_entry_t));
 
     return 0;
@@ -248,7 +371,7 @@ int dynamic_keymap_get_key_override(uint8_t index, vial_key_override_entry_t *en
     if (index >= VIAL_KEY_OVERRIDE_ENTRIES)
         return -1;
 
-    void *address = (void*)(VIAL_KEY_OVERRIDE_EEPROM_ADDR + index * sizeof(vial_key_override_entry_t));
+    void *address = ((void *)VIAL_KEY_OVERRIDE_EEPROM_ADDR) + index * sizeof(vial_key_override_entry_t);
     eeprom_read_block(entry, address, sizeof(vial_key_override_entry_t));
 
     return 0;
@@ -258,7 +381,7 @@ int dynamic_keymap_set_key_override(uint8_t index, const vial_key_override_entry
     if (index >= VIAL_KEY_OVERRIDE_ENTRIES)
         return -1;
 
-    void *address = (void*)(VIAL_KEY_OVERRIDE_EEPROM_ADDR + index * sizeof(vial_key_override_entry_t));
+    void *address = ((void *)VIAL_KEY_OVERRIDE_EEPROM_ADDR) + index * sizeof(vial_key_override_entry_t);
     eeprom_write_block(entry, address, sizeof(vial_key_override_entry_t));
 
     return 0;
@@ -313,6 +436,9 @@ void dynamic_keymap_reset(void) {
 #endif
 
 #ifdef VIAL_ENABLE
+    /* refresh the RAM copies of tap dance, combo and key override entries */
+    vial_init();
+
     /* re-lock the keyboard */
     vial_unlocked = vial_unlocked_prev;
 #endif
@@ -320,23 +446,14 @@ void dynamic_keymap_reset(void) {
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t length                     = dynamic_keymap_buffer_length(dynamic_keymap_eeprom_size, offset, size);
+    eeprom_read_block(data, ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset, length);
+    memset(data + length, 0x00, size - length);
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
     uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
+    void *   target                     = ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset;
 
 #ifdef VIAL_ENABLE
     /* ensure the writes are bounded */
@@ -382,12 +499,14 @@ void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
 #endif
 #endif
 
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t length = dynamic_keymap_buffer_length(dynamic_keymap_eeprom_size, offset, size);
+#ifdef DYNAMIC_KEYMAP_CACHE_ENABLE
+    for (uint16_t i = 0; i < length; i++) {
+        dynamic_keymap_cache_update_byte(offset + i, data[i]);
+    }
+#endif
+    if (length > 0) {
+        eeprom_update_block(data, target, length);
     }
 }
 
@@ -407,6 +526,23 @@ uint16_t keycode_at_encodermap_location(uint8_t layer_num, uint8_t encoder_idx,
 }
 #endif // ENCODER_MAP_ENABLE
 
+uint16_t dynamic_keymap_get_state_buffer_size(void) {
+    return DYNAMIC_KEYMAP_EEPROM_MAX_ADDR - DYNAMIC_KEYMAP_EEPROM_ADDR + 1;
+}
+
+void dynamic_keymap_get_state_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t length = dynamic_keymap_buffer_length(dynamic_keymap_get_state_buffer_size(), offset, size);
+    eeprom_read_block(data, ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset, length);
+    memset(data + length, 0x00, size - length);
+}
+
+void dynamic_keymap_set_state_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
+    uint16_t length = dynamic_keymap_buffer_length(dynamic_keymap_get_state_buffer_size(), offset, size);
+    if (length > 0) {
+        eeprom_update_block(data, ((void *)DYNAMIC_KEYMAP_EEPROM_ADDR) + offset, length);
+    }
+}
+
 uint8_t dynamic_keymap_macro_get_count(void) {
     return DYNAMIC_KEYMAP_MACRO_COUNT;
 }
@@ -416,86 +552,87 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *target = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            *target = eeprom_read_byte(source);
-        } else {
-            *target = 0x00;
-        }
-        source++;
-        target++;
-    }
+    uint16_t length = dynamic_keymap_buffer_length(DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE, offset, size);
+    eeprom_read_block(data, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset, length);
+    memset(data + length, 0x00, size - length);
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
-    uint8_t *source = data;
-    for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
-            eeprom_update_byte(target, *source);
-        }
-        source++;
-        target++;
+    uint16_t length = dynamic_keymap_buffer_length(DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE, offset, size);
+    if (length > 0) {
+        eeprom_update_block(data, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset, length);
+    }
+
+    // Hosts finish a buffer write by clearing the last byte, so only
+    // re-index once that has been written; any other write just drops the
+    // current index until then.
+    if (offset + size >= DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        dynamic_keymap_macro_rebuild_offsets();
+    } else {
+        dynamic_keymap_macro_offsets_valid = false;
     }
 }
 
 void dynamic_keymap_macro_reset(void) {
-    void *p   = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (p != end) {
-        eeprom_update_byte(p, 0);
-        ++p;
+    uint8_t zeros[DYNAMIC_KEYMAP_MACRO_READ_BLOCK_SIZE] = {0};
+    for (uint16_t offset = 0; offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE; offset += sizeof(zeros)) {
+        eeprom_update_block(zeros, ((void *)DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR) + offset, dynamic_keymap_buffer_length(DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE, offset, sizeof(zeros)));
     }
+    dynamic_keymap_macro_rebuild_offsets();
 }
 
+#ifdef VIAL_ENABLE
 static uint16_t decode_keycode(uint16_t kc) {
     /* map 0xFF01 => 0x0100; 0xFF02 => 0x0200, etc */
     if (kc > 0xFF00)
         return (kc & 0xFF) << 8;
     return kc;
 }
+#endif
 
 void dynamic_keymap_macro_send(uint8_t id) {
     if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
         return;
     }
 
-    // Check the last byte of the buffer.
-    // If it's not zero, then we are in the middle
-    // of buffer writing, possibly an aborted buffer
-    // write. So do nothing.
-    void *p = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1);
-    if (eeprom_read_byte(p) != 0) {
-        return;
-    }
-
-    // Skip N null characters
-    // p will then point to the Nth macro
-    p         = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR);
-    void *end = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE);
-    while (id > 0) {
-        // If we are past the end of the buffer, then the buffer
-        // contents are garbage, i.e. there were not DYNAMIC_KEYMAP_MACRO_COUNT
-        // nulls in the buffer.
-        if (p == end) {
+    // The index is invalid while a buffer write is in progress
+    // or was aborted, so do nothing in that case.
+    if (!dynamic_keymap_macro_offsets_valid) {
+        dynamic_keymap_macro_rebuild_offsets();
+        if (!dynamic_keymap_macro_offsets_valid) {
             return;
         }
-        if (eeprom_read_byte(p) == 0) {
-            --id;
-        }
-        ++p;
     }
 
-    // Send the macro string one or three chars at a time
-    // by making temporary 1 or 3 char strings
-    char data[4] = {0, 0, 0, 0};
-    // We already checked there was a null at the end of
-    // the buffer, so this cannot go past the end
+    // If there were not DYNAMIC_KEYMAP_MACRO_COUNT nulls
+    // in the buffer, then this macro does not exist.
+    if (dynamic_keymap_macro_offsets[id] == DYNAMIC_KEYMAP_MACRO_OFFSET_INVALID) {
+        return;
+    }
+
+    dynamic_keymap_macro_reader_t reader;
+    dynamic_keymap_macro_reader_init(&reader, dynamic_keymap_macro_offsets[id]);
+
+    // Plain characters are collected and sent together, magic sequences
+    // are sent as temporary 3 char strings or handled directly
+    char     text[DYNAMIC_KEYMAP_MACRO_READ_BLOCK_SIZE + 1];
+    uint16_t text_length = 0;
+    char     data[4]     = {0, 0, 0, 0};
+    // The reader returns a null past the end of the buffer,
+    // so this cannot go past the end
     while (1) {
-        data[0] = eeprom_read_byte(p++);
-        data[1] = 0;
+        data[0] = dynamic_keymap_macro_reader_next(&reader);
+        if (data[0] != 0 && data[0] != SS_QMK_PREFIX) {
+            text[text_length++] = data[0];
+            if (text_length < sizeof(text) - 1) {
+                continue;
+            }
+        }
+        if (text_length > 0) {
+            text[text_length] = 0;
+            send_string_with_delay(text, DYNAMIC_KEYMAP_MACRO_DELAY);
+            text_length = 0;
+        }
         // Stop at the null terminator of this macro string
         if (data[0] == 0) {
             break;
@@ -503,18 +640,19 @@ void dynamic_keymap_macro_send(uint8_t id) {
         if (data[0] == SS_QMK_PREFIX) {
             // If the char is magic, process it as indicated by the next character
             // (tap, down, up, delay)
-            data[1] = eeprom_read_byte(p++);
+            data[1] = dynamic_keymap_macro_reader_next(&reader);
             if (data[1] == 0)
                 break;
             if (data[1] == SS_TAP_CODE || data[1] == SS_DOWN_CODE || data[1] == SS_UP_CODE) {
                 // For tap, down, up, just stuff it into the array and send_string it
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_macro_reader_next(&reader);
                 if (data[2] != 0)
                     send_string(data);
+#ifdef VIAL_ENABLE
             } else if (data[1] == VIAL_MACRO_EXT_TAP || data[1] == VIAL_MACRO_EXT_DOWN || data[1] == VIAL_MACRO_EXT_UP) {
-                data[2] = eeprom_read_byte(p++);
+                data[2] = dynamic_keymap_macro_reader_next(&reader);
                 if (data[2] != 0) {
-                    data[3] = eeprom_read_byte(p++);
+                    data[3] = dynamic_keymap_macro_reader_next(&reader);
                     if (data[3] != 0) {
                         uint16_t kc;
                         memcpy(&kc, &data[2], sizeof(kc));
@@ -532,19 +670,17 @@ void dynamic_keymap_macro_send(uint8_t id) {
                         }
                     }
                 }
+#endif
             } else if (data[1] == SS_DELAY_CODE) {
                 // For delay, decode the delay and wait_ms for that amount
-                uint8_t d0 = eeprom_read_byte(p++);
-                uint8_t d1 = eeprom_read_byte(p++);
+                uint8_t d0 = dynamic_keymap_macro_reader_next(&reader);
+                uint8_t d1 = dynamic_keymap_macro_reader_next(&reader);
                 if (d0 == 0 || d1 == 0)
                     break;
                 // we cannot use 0 for these, need to subtract 1 and use 255 instead of 256 for delay calculation
                 int ms = (d0 - 1) + (d1 - 1) * 255;
                 while (ms--) wait_ms(1);
             }
-        } else {
-            // If the char wasn't magic, just send it
-            send_string_with_delay(data, DYNAMIC_KEYMAP_MACRO_DELAY);
         }
     }
 }
@@ -30,6 +30,7 @@
 #    define DYNAMIC_KEYMAP_MACRO_COUNT 16
 #endif
 
+void     dynamic_keymap_init(void);
 uint8_t  dynamic_keymap_get_layer_count(void);
 void *   dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t column);
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column);
@@ -66,6 +67,14 @@ void     dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+// These get/set the raw bytes of everything dynamic_keymap keeps in EEPROM,
+// from the start of the keymap through the end of the macro buffer.
+// dynamic_keymap_set_state_buffer() only writes EEPROM; callers must reload
+// (dynamic_keymap_init() etc.) once the whole state has been written.
+uint16_t dynamic_keymap_get_state_buffer_size(void);
+void     dynamic_keymap_get_state_buffer(uint16_t offset, uint16_t size, uint8_t *data);
+void     dynamic_keymap_set_state_buffer(uint16_t offset, uint16_t size, uint8_t *data);
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -0,0 +1,134 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "idle_sleep.h"
+
+#include "quantum.h"
+#include "qmk_settings.h"
+
+/** \brief Matrices that cannot raise a wakeup interrupt never sleep */
+__attribute__((weak)) bool matrix_wakeup_arm(void) {
+    return false;
+}
+
+__attribute__((weak)) void matrix_wakeup_disarm(void) {}
+
+__attribute__((weak)) bool idle_sleep_allowed_user(void) {
+    return true;
+}
+
+__attribute__((weak)) bool idle_sleep_allowed_kb(void) {
+    return idle_sleep_allowed_user();
+}
+
+/** \brief Whether the main loop has nothing to do until the next key press
+ *
+ * Every key must be released and no feature may be waiting on the tick events
+ * that only a running main loop generates.
+ */
+bool idle_sleep_allowed(void) {
+#ifdef SPLIT_KEYBOARD
+    // The other half is polled over the split transport, which cannot wake us
+    return false;
+#endif
+#if defined(ENCODER_ENABLE) || defined(POINTING_DEVICE_ENABLE)
+    // Only the matrix pins are armed, so turning an encoder or moving the pointer would go unnoticed
+    return false;
+#endif
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix_get_row(row)) {
+            return false;
+        }
+    }
+
+#ifndef NO_ACTION_TAPPING
+    if (is_tapping_pending()) {
+        return false;
+    }
+#endif
+#ifndef NO_ACTION_ONESHOT
+    if (QS_oneshot_timeout > 0 && (get_oneshot_mods() || is_oneshot_layer_active())) {
+        return false;
+    }
+#endif
+#ifdef COMBO_ENABLE
+    if (is_combo_pending()) {
+        return false;
+    }
+#endif
+#ifdef TAP_DANCE_ENABLE
+    if (is_tap_dance_pending()) {
+        return false;
+    }
+#endif
+#ifdef LEADER_ENABLE
+    if (leader_sequence_active()) {
+        return false;
+    }
+#endif
+#if defined(CAPS_WORD_ENABLE) && CAPS_WORD_IDLE_TIMEOUT > 0
+    if (is_caps_word_on()) {
+        return false;
+    }
+#endif
+
+    // Lighting effects are rendered from the main loop
+#ifdef RGB_MATRIX_ENABLE
+    if (rgb_matrix_is_enabled()) {
+        return false;
+    }
+#endif
+#ifdef LED_MATRIX_ENABLE
+    if (led_matrix_is_enabled()) {
+        return false;
+    }
+#endif
+#ifdef RGBLIGHT_ENABLE
+    if (rgblight_is_enabled()) {
+        return false;
+    }
+#endif
+
+    return idle_sleep_allowed_kb();
+}
+
+bool idle_sleep_pins_armable(const pin_t *pins, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        if (pins[i] == NO_PIN) {
+            continue;
+        }
+        for (uint8_t j = i + 1; j < count; j++) {
+            if (pins[j] != NO_PIN && idle_sleep_pins_share_event(pins[i], pins[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/** \brief How long the core may sleep before the next deadline, in milliseconds */
+uint32_t idle_sleep_duration(void) {
+    uint32_t duration = IDLE_SLEEP_MAX_DURATION;
+#ifdef DEFERRED_EXEC_ENABLE
+    uint32_t next_deferred = deferred_exec_next_delay();
+    if (next_deferred < duration) {
+        duration = next_deferred;
+    }
+#endif
+    return duration;
+}
+
+void idle_sleep_task(void) {
+    if (!idle_sleep_allowed()) {
+        return;
+    }
+
+    uint32_t duration = idle_sleep_duration();
+    if (duration == 0 || !matrix_wakeup_arm()) {
+        return;
+    }
+
+    idle_sleep_wait(duration);
+    matrix_wakeup_disarm();
+}
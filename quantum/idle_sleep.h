@@ -0,0 +1,45 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Event-driven idle sleep, enabled with `IDLE_SLEEP_ENABLE = yes`.
+
+    Once every key is released and nothing is waiting on a timer, the main loop stops
+    polling the matrix: the matrix is armed so that any key press raises a pin interrupt,
+    and the core sleeps until that interrupt fires or the next deferred execution is due.
+    The following pass through the main loop scans at full rate again.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "gpio.h"
+
+// Upper bound on a single sleep in milliseconds. Anything the main loop polls without an
+// interrupt of its own (raw HID, console, animations) is serviced at least this often.
+#ifndef IDLE_SLEEP_MAX_DURATION
+#    define IDLE_SLEEP_MAX_DURATION 10
+#endif
+
+bool     idle_sleep_allowed(void);
+bool     idle_sleep_allowed_kb(void);
+bool     idle_sleep_allowed_user(void);
+uint32_t idle_sleep_duration(void);
+void     idle_sleep_task(void);
+
+/* Implemented by the matrix. Drives the matrix so that pressing any key changes an input
+ * with a wakeup event enabled. Returns false, leaving nothing armed, if a key is already down. */
+bool matrix_wakeup_arm(void);
+void matrix_wakeup_disarm(void);
+
+/* Whether every pin can raise its own wakeup event at the same time. Pins set to NO_PIN are
+ * skipped. Matrices must not sleep on pins that fail this check, as one of them would go unheard. */
+bool idle_sleep_pins_armable(const pin_t *pins, uint8_t count);
+
+/* Implemented by the platform */
+bool idle_sleep_pins_share_event(pin_t a, pin_t b);
+void idle_sleep_pin_enable(pin_t pin);
+void idle_sleep_pin_disable(pin_t pin);
+/* Sleeps until an enabled pin changes or duration_ms has passed. Platforms that cannot
+ * tell which interrupt woke them may return after any interrupt, before duration_ms. */
+void idle_sleep_wait(uint32_t duration_ms);
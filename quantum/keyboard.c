@@ -33,6 +33,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "task_profiling.h"
 #ifdef AUDIO_ENABLE
 #    include "audio.h"
 #endif
@@ -99,6 +100,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef ST7565_ENABLE
 #    include "st7565.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
@@ -378,6 +382,9 @@ __attribute__((weak)) void housekeeping_task_user(void) {}
  * Invokes hooks for executing code after QMK is done after each loop iteration.
  */
 void housekeeping_task(void) {
+#if defined(EEPROM_WEAR_LEVELING) && (defined(WEAR_LEVELING_WRITEBACK_ENABLE) || defined(WEAR_LEVELING_INCREMENTAL_CONSOLIDATION))
+    eeprom_driver_task();
+#endif
     housekeeping_task_kb();
     housekeeping_task_user();
 }
@@ -413,6 +420,9 @@ void quantum_init(void) {
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_init();
+#endif
 #ifdef VIA_ENABLE
     via_init();
 #endif
@@ -506,10 +516,26 @@ static inline void generate_tick_event(void) {
     }
 }
 
+#if (MATRIX_COLS <= 16)
+#    define matrix_row_ctz(bits) ((uint8_t)__builtin_ctz(bits))
+#else
+#    define matrix_row_ctz(bits) ((uint8_t)__builtin_ctzl(bits))
+#endif
+
+// Bits beyond MATRIX_COLS that a custom matrix might leave set are never reported as keys
+#define MATRIX_COLS_MASK ((matrix_row_t)(~(matrix_row_t)0) >> (sizeof(matrix_row_t) * 8 - MATRIX_COLS))
+
+#define CHANGED_ROW_WORDS ((MATRIX_ROWS + 31) / 32)
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
  *
+ * Each row is read once into a scratch buffer while building a bitmap of the
+ * rows that changed. Events are then extracted by stepping through the set
+ * bits of the bitmap and of each row's changes, lowest first, which keeps the
+ * row-major, ascending column order of a plain nested loop.
+ *
  * @return true Matrix did change
  * @return false Matrix didn't change
  */
@@ -522,9 +548,16 @@ static bool matrix_task(void) {
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
     matrix_scan();
-    bool matrix_changed = false;
-    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
-        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
+
+    matrix_row_t matrix_current[MATRIX_ROWS];
+    uint32_t     changed_rows[CHANGED_ROW_WORDS] = {0};
+    bool         matrix_changed                  = false;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        matrix_current[row] = matrix_get_row(row);
+        if (matrix_current[row] != matrix_previous[row]) {
+            changed_rows[row / 32] |= (uint32_t)1 << (row % 32);
+            matrix_changed = true;
+        }
     }
 
     matrix_scan_perf_task();
@@ -541,18 +574,18 @@ static bool matrix_task(void) {
 
     const bool process_keypress = should_process_keypress();
 
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+    for (uint8_t word = 0; word < CHANGED_ROW_WORDS; word++) {
+        for (uint32_t rows = changed_rows[word]; rows; rows &= rows - 1) {
+            const uint8_t      row         = word * 32 + (uint8_t)__builtin_ctzl(rows);
+            const matrix_row_t current_row = matrix_current[row];
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
-            continue;
-        }
+            if (has_ghost_in_row(row, current_row)) {
+                continue;
+            }
 
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+            for (matrix_row_t row_changes = (current_row ^ matrix_previous[row]) & MATRIX_COLS_MASK; row_changes; row_changes &= row_changes - 1) {
+                const uint8_t col         = matrix_row_ctz(row_changes);
+                const bool    key_pressed = current_row & (MATRIX_ROW_SHIFTER << col);
 
                 if (process_keypress) {
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
@@ -560,9 +593,9 @@ static bool matrix_task(void) {
 
                 switch_events(row, col, key_pressed);
             }
-        }
 
-        matrix_previous[row] = current_row;
+            matrix_previous[row] = current_row;
+        }
     }
 
     return matrix_changed;
@@ -603,7 +636,7 @@ void quantum_task(void) {
 #endif
 
 #ifdef KEY_OVERRIDE_ENABLE
-    key_override_task();
+    PROFILE_TASK(PROFILED_TASK_KEY_OVERRIDE, key_override_task());
 #endif
 
 #ifdef SEQUENCER_ENABLE
@@ -611,15 +644,15 @@ void quantum_task(void) {
 #endif
 
 #ifdef TAP_DANCE_ENABLE
-    tap_dance_task();
+    PROFILE_TASK(PROFILED_TASK_TAP_DANCE, tap_dance_task());
 #endif
 
 #ifdef COMBO_ENABLE
-    combo_task();
+    PROFILE_TASK(PROFILED_TASK_COMBO, combo_task());
 #endif
 
 #ifdef LEADER_ENABLE
-    leader_task();
+    PROFILE_TASK(PROFILED_TASK_LEADER, leader_task());
 #endif
 
 #ifdef WPM_ENABLE
@@ -631,11 +664,11 @@ void quantum_task(void) {
 #endif
 
 #ifdef AUTO_SHIFT_ENABLE
-    autoshift_matrix_scan();
+    PROFILE_TASK(PROFILED_TASK_AUTO_SHIFT, autoshift_matrix_scan());
 #endif
 
 #ifdef CAPS_WORD_ENABLE
-    caps_word_task();
+    PROFILE_TASK(PROFILED_TASK_CAPS_WORD, caps_word_task());
 #endif
 
 #ifdef SECURE_ENABLE
@@ -646,26 +679,28 @@ void quantum_task(void) {
 /** \brief Main task that is repeatedly called as fast as possible. */
 void keyboard_task(void) {
     __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
+    bool                         matrix_changed;
+    PROFILE_TASK(PROFILED_TASK_MATRIX, matrix_changed = matrix_task());
+    if (matrix_changed) {
         last_matrix_activity_trigger();
         activity_has_occurred = true;
     }
 
-    quantum_task();
+    PROFILE_TASK(PROFILED_TASK_QUANTUM, quantum_task());
 
 #if defined(SPLIT_WATCHDOG_ENABLE)
     split_watchdog_task();
 #endif
 
 #if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+    PROFILE_TASK(PROFILED_TASK_RGBLIGHT, rgblight_task());
 #endif
 
 #ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+    PROFILE_TASK(PROFILED_TASK_LED_MATRIX, led_matrix_task());
 #endif
 #ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+    PROFILE_TASK(PROFILED_TASK_RGB_MATRIX, rgb_matrix_task());
 #endif
 
 #if defined(BACKLIGHT_ENABLE)
@@ -675,21 +710,25 @@ void keyboard_task(void) {
 #endif
 
 #ifdef ENCODER_ENABLE
-    if (encoder_read()) {
+    bool encoder_changed;
+    PROFILE_TASK(PROFILED_TASK_ENCODER, encoder_changed = encoder_read());
+    if (encoder_changed) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
-    if (pointing_device_task()) {
+    bool pointing_device_changed;
+    PROFILE_TASK(PROFILED_TASK_POINTING_DEVICE, pointing_device_changed = pointing_device_task());
+    if (pointing_device_changed) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
 #endif
 
 #ifdef OLED_ENABLE
-    oled_task();
+    PROFILE_TASK(PROFILED_TASK_OLED, oled_task());
 #    if OLED_TIMEOUT > 0
     // Wake up oled if user is using those fabulous keys or spinning those encoders!
     if (activity_has_occurred) oled_on();
@@ -730,4 +769,8 @@ void keyboard_task(void) {
 #endif
 
     led_task();
+
+#ifdef TASK_PROFILING_ENABLE
+    task_profiling_task();
+#endif
 }
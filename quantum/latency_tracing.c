@@ -0,0 +1,152 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "latency_tracing.h"
+
+#include <string.h>
+#include "action_tapping.h"
+#include "action_util.h"
+#include "keycode.h"
+#include "keycodes.h"
+#include "quantum_keycodes.h"
+#include "report.h"
+#include "timer.h"
+
+#ifndef LATENCY_TRACING_DEPTH
+#    define LATENCY_TRACING_DEPTH 4
+#endif
+
+typedef struct {
+    uint16_t time;
+    uint8_t  path;
+} latency_context_t;
+
+typedef struct {
+    uint8_t  code;
+    uint8_t  path;
+    uint16_t time;
+} latency_pending_t;
+
+typedef struct {
+    uint16_t samples[LATENCY_TRACING_SAMPLES];
+    uint8_t  head;
+    uint8_t  count;
+} latency_ring_t;
+
+_Static_assert(LATENCY_TRACING_SAMPLES <= 255, "LATENCY_TRACING_SAMPLES must fit in a byte");
+
+static latency_context_t context[LATENCY_TRACING_DEPTH];
+static uint8_t           context_depth = 0;
+static latency_pending_t pending[LATENCY_TRACING_PENDING];
+static uint8_t           pending_count = 0;
+static latency_ring_t    rings[LATENCY_PATH_COUNT];
+
+void latency_tracing_begin(uint16_t event_time, latency_path_t path) {
+    if (context_depth < LATENCY_TRACING_DEPTH) {
+        context[context_depth] = (latency_context_t){.time = event_time, .path = path};
+    }
+    context_depth++;
+}
+
+void latency_tracing_begin_record(keyrecord_t *record) {
+    latency_path_t path = LATENCY_PATH_DIRECT;
+#ifdef COMBO_ENABLE
+    if (record->event.type == COMBO_EVENT) {
+        path = LATENCY_PATH_COMBO;
+    }
+#endif
+#ifndef NO_ACTION_TAPPING
+    if (path == LATENCY_PATH_DIRECT) {
+        uint16_t keycode = get_record_keycode(record, false);
+        if (record->tap.count || IS_QK_MOD_TAP(keycode) || IS_QK_LAYER_TAP(keycode)) {
+            path = LATENCY_PATH_TAP_HOLD;
+        }
+    }
+#endif
+    // Plain keys released from a buffer are charged to the feature that held them back
+    if (path == LATENCY_PATH_DIRECT && context_depth > 0 && context_depth <= LATENCY_TRACING_DEPTH) {
+        path = context[context_depth - 1].path;
+    }
+    latency_tracing_begin(record->event.time, path);
+}
+
+void latency_tracing_end(void) {
+    if (context_depth > 0) {
+        context_depth--;
+    }
+}
+
+void latency_tracing_key_added(uint8_t code) {
+    if (context_depth == 0 || context_depth > LATENCY_TRACING_DEPTH || code == KC_NO || pending_count == LATENCY_TRACING_PENDING) {
+        return;
+    }
+    for (uint8_t i = 0; i < pending_count; i++) {
+        if (pending[i].code == code) {
+            return;
+        }
+    }
+    const latency_context_t *current = &context[context_depth - 1];
+    pending[pending_count++]         = (latency_pending_t){.code = code, .path = current->path, .time = current->time};
+}
+
+void latency_tracing_mods_added(uint8_t mods) {
+    for (uint8_t i = 0; i < 8; i++) {
+        if (mods & (1 << i)) {
+            latency_tracing_key_added(KC_LEFT_CTRL + i);
+        }
+    }
+}
+
+static void latency_tracing_sample(latency_path_t path, uint16_t latency) {
+    latency_ring_t *ring        = &rings[path];
+    ring->samples[ring->head]   = latency;
+    ring->head                  = (ring->head + 1) % LATENCY_TRACING_SAMPLES;
+    if (ring->count < LATENCY_TRACING_SAMPLES) {
+        ring->count++;
+    }
+}
+
+void latency_tracing_report_sent(uint8_t mods) {
+    uint16_t now = timer_read();
+    for (uint8_t i = 0; i < pending_count; i++) {
+        uint8_t code    = pending[i].code;
+        bool    present = IS_MODIFIER_KEYCODE(code) ? (mods & MOD_BIT(code)) : is_key_pressed(code);
+        // A stamped key that is not in this report was released before it could be sent
+        if (present) {
+            latency_tracing_sample(pending[i].path, TIMER_DIFF_16(now, pending[i].time));
+        }
+    }
+    pending_count = 0;
+}
+
+void latency_tracing_get_stats(latency_path_t path, latency_stats_t *stats) {
+    memset(stats, 0, sizeof(latency_stats_t));
+    if (path >= LATENCY_PATH_COUNT || rings[path].count == 0) {
+        return;
+    }
+
+    const latency_ring_t *ring = &rings[path];
+    uint16_t              sorted[LATENCY_TRACING_SAMPLES];
+    uint32_t              sum = 0;
+    // Insertion sort, the ring is small and this is only called on demand
+    for (uint8_t i = 0; i < ring->count; i++) {
+        uint16_t value = ring->samples[i];
+        uint8_t  j     = i;
+        for (; j > 0 && sorted[j - 1] > value; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = value;
+        sum += value;
+    }
+
+    stats->count = ring->count;
+    stats->min   = sorted[0];
+    stats->max   = sorted[ring->count - 1];
+    stats->avg   = sum / ring->count;
+    stats->p99   = sorted[(ring->count * 99 + 99) / 100 - 1];
+}
+
+void latency_tracing_reset(void) {
+    memset(rings, 0, sizeof(rings));
+    pending_count = 0;
+}
@@ -0,0 +1,62 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Key-to-report latency tracing, enabled with `LATENCY_TRACING_ENABLE = yes`.
+
+    Every keyrecord carries the timestamp of the scan that produced it in `event.time`.
+    While a record is being processed, keys and modifiers it adds to the keyboard report
+    are stamped with that time. When a report containing a stamped key is sent to the host,
+    the difference is recorded as one sample for the feature path the record took.
+
+    Samples are kept in a ring buffer per path; latency_tracing_get_stats() summarises the
+    samples currently held.
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "action.h"
+
+typedef enum {
+    LATENCY_PATH_DIRECT,
+    LATENCY_PATH_TAP_HOLD,   // tap-hold keys, and keys held back while one was undecided
+    LATENCY_PATH_COMBO,      // combo actions, and keys held back while a combo was pending
+    LATENCY_PATH_AUTO_SHIFT, // keys registered by Auto Shift
+    LATENCY_PATH_COUNT,
+} latency_path_t;
+
+typedef struct {
+    uint16_t count; // samples currently in the ring buffer
+    uint16_t min;
+    uint16_t avg;
+    uint16_t p99;
+    uint16_t max;
+} latency_stats_t;
+
+#ifndef LATENCY_TRACING_SAMPLES
+#    define LATENCY_TRACING_SAMPLES 64
+#endif
+
+// Keys added to the report but not yet seen in a sent report
+#ifndef LATENCY_TRACING_PENDING
+#    define LATENCY_TRACING_PENDING 8
+#endif
+
+#ifdef LATENCY_TRACING_ENABLE
+#    define LATENCY_TRACING_BEGIN(time, path) latency_tracing_begin((time), (path))
+#    define LATENCY_TRACING_END() latency_tracing_end()
+
+void latency_tracing_begin(uint16_t event_time, latency_path_t path);
+void latency_tracing_begin_record(keyrecord_t *record);
+void latency_tracing_end(void);
+void latency_tracing_key_added(uint8_t code);
+void latency_tracing_mods_added(uint8_t mods);
+void latency_tracing_report_sent(uint8_t mods);
+
+void latency_tracing_get_stats(latency_path_t path, latency_stats_t *stats);
+void latency_tracing_reset(void);
+#else
+#    define LATENCY_TRACING_BEGIN(time, path)
+#    define LATENCY_TRACING_END()
+#endif
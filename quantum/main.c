@@ -15,6 +15,11 @@
  */
 
 #include "keyboard.h"
+#include "task_profiling.h"
+
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
 
 void platform_setup(void);
 
@@ -38,7 +43,7 @@ void protocol_task(void) __attribute__((weak));
 void protocol_task(void) {
     protocol_pre_task();
 
-    keyboard_task();
+    PROFILE_TASK(PROFILED_TASK_KEYBOARD, keyboard_task());
 
     protocol_post_task();
 }
@@ -71,6 +76,11 @@ int main(void) {
         deferred_exec_task();
 #endif // DEFERRED_EXEC_ENABLE
 
-        housekeeping_task();
+        PROFILE_TASK(PROFILED_TASK_HOUSEKEEPING, housekeeping_task());
+
+#ifdef IDLE_SLEEP_ENABLE
+        // Sleep until a key is pressed or the next deadline if there is nothing to do
+        idle_sleep_task();
+#endif // IDLE_SLEEP_ENABLE
     }
 }
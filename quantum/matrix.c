@@ -21,6 +21,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "matrix.h"
 #include "debounce.h"
 #include "atomic_util.h"
+#ifdef IDLE_SLEEP_ENABLE
+#    include "idle_sleep.h"
+#endif
 
 #ifdef SPLIT_KEYBOARD
 #    include "split_common/split_util.h"
@@ -270,6 +273,111 @@ __attribute__((weak)) void matrix_read_rows_on_col(matrix_row_t current_matrix[]
 #    error DIODE_DIRECTION is not defined!
 #endif
 
+#ifdef IDLE_SLEEP_ENABLE
+#    ifdef DIRECT_PINS
+
+bool matrix_wakeup_arm(void) {
+    // Inputs sharing an event line can't all be armed, so keep polling instead
+    if (!idle_sleep_pins_armable(&direct_pins[0][0], ROWS_PER_HAND * MATRIX_COLS)) {
+        return false;
+    }
+
+    bool key_down = false;
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            pin_t pin = direct_pins[row][col];
+            if (pin != NO_PIN) {
+                idle_sleep_pin_enable(pin);
+                key_down |= readMatrixPin(pin) == 0;
+            }
+        }
+    }
+    if (key_down) {
+        matrix_wakeup_disarm();
+    }
+    return !key_down;
+}
+
+void matrix_wakeup_disarm(void) {
+    for (uint8_t row = 0; row < ROWS_PER_HAND; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (direct_pins[row][col] != NO_PIN) {
+                idle_sleep_pin_disable(direct_pins[row][col]);
+            }
+        }
+    }
+}
+
+#    elif defined(MATRIX_ROW_PINS) && defined(MATRIX_COL_PINS)
+
+// Select every output at once so that any closed switch pulls its input low. Events are
+// enabled before the inputs are read so that a press in between still wakes the core.
+static bool wakeup_arm_pins(const pin_t *outputs, uint8_t output_count, const pin_t *inputs, uint8_t input_count) {
+    for (uint8_t i = 0; i < output_count; i++) {
+        if (outputs[i] != NO_PIN) {
+            setPinOutput_writeLow(outputs[i]);
+        }
+    }
+    matrix_output_select_delay();
+
+    bool key_down = false;
+    for (uint8_t i = 0; i < input_count; i++) {
+        if (inputs[i] != NO_PIN) {
+            idle_sleep_pin_enable(inputs[i]);
+            key_down |= readMatrixPin(inputs[i]) == 0;
+        }
+    }
+    return !key_down;
+}
+
+static void wakeup_disarm_pins(const pin_t *inputs, uint8_t input_count) {
+    for (uint8_t i = 0; i < input_count; i++) {
+        if (inputs[i] != NO_PIN) {
+            idle_sleep_pin_disable(inputs[i]);
+        }
+    }
+}
+
+#        if (DIODE_DIRECTION == COL2ROW)
+bool matrix_wakeup_arm(void) {
+    // Inputs sharing an event line can't all be armed, so keep polling instead
+    if (!idle_sleep_pins_armable(col_pins, MATRIX_COLS)) {
+        return false;
+    }
+    if (!wakeup_arm_pins(row_pins, ROWS_PER_HAND, col_pins, MATRIX_COLS)) {
+        matrix_wakeup_disarm();
+        return false;
+    }
+    return true;
+}
+
+void matrix_wakeup_disarm(void) {
+    wakeup_disarm_pins(col_pins, MATRIX_COLS);
+    unselect_rows();
+    matrix_output_unselect_delay(0, true);
+}
+#        elif (DIODE_DIRECTION == ROW2COL)
+bool matrix_wakeup_arm(void) {
+    // Inputs sharing an event line can't all be armed, so keep polling instead
+    if (!idle_sleep_pins_armable(row_pins, ROWS_PER_HAND)) {
+        return false;
+    }
+    if (!wakeup_arm_pins(col_pins, MATRIX_COLS, row_pins, ROWS_PER_HAND)) {
+        matrix_wakeup_disarm();
+        return false;
+    }
+    return true;
+}
+
+void matrix_wakeup_disarm(void) {
+    wakeup_disarm_pins(row_pins, ROWS_PER_HAND);
+    unselect_cols();
+    matrix_output_unselect_delay(0, true);
+}
+#        endif
+#    endif
+#endif // IDLE_SLEEP_ENABLE
+
 void matrix_init(void) {
 #ifdef SPLIT_KEYBOARD
     // Set pinout for right half if pinout for that half is defined
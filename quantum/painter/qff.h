@@ -24,7 +24,7 @@
 typedef struct QP_PACKED qff_font_descriptor_v1_t {
     qgf_block_header_v1_t header;              // = { .type_id = 0x00, .neg_type_id = (~0x00), .length = 20 }
     uint32_t              magic : 24;          // constant, equal to 0x464651 ("QFF")
-    uint8_t               qff_version;         // constant, equal to 0x01
+    uint8_t               qff_version;         // 0x01, or 0x02 if the unicode table is sorted by code point
     uint32_t              total_file_size;     // total size of the entire file, starting at offset zero
     uint32_t              neg_total_file_size; // negated value of total_file_size, used for detecting parsing errors
     uint8_t               line_height;         // glyph height in pixels
@@ -40,6 +40,9 @@ _Static_assert(sizeof(qff_font_descriptor_v1_t) == (sizeof(qgf_block_header_v1_t
 
 #define QFF_MAGIC 0x464651
 
+// First version guaranteeing the unicode glyph table is in ascending code point order, so it can be binary searched
+#define QFF_VERSION_SORTED_UNICODE 0x02
+
 /////////////////////////////////////////
 // ASCII glyph table descriptor
 
@@ -85,4 +88,4 @@ typedef struct QP_PACKED qff_unicode_glyph_table_v1_t {
 
 bool     qff_validate_stream(qp_stream_t *stream);
 uint32_t qff_get_total_size(qp_stream_t *stream);
-bool     qff_read_font_descriptor(qp_stream_t *stream, uint8_t *line_height, bool *has_ascii_table, uint16_t *num_unicode_glyphs, uint8_t *bpp, bool *has_palette, bool *is_panel_native, painter_compression_t *compression_scheme, uint32_t *total_bytes);
+bool     qff_read_font_descriptor(qp_stream_t *stream, uint8_t *line_height, bool *has_ascii_table, uint16_t *num_unicode_glyphs, bool *sorted_unicode_table, uint8_t *bpp, bool *has_palette, bool *is_panel_native, painter_compression_t *compression_scheme, uint32_t *total_bytes);
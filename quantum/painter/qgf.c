@@ -127,9 +127,9 @@ bool qgf_read_graphics_descriptor(qp_stream_t *stream, uint16_t *image_width, ui
     return true;
 }
 
-static bool qgf_read_frame_offset(qp_stream_t *stream, uint16_t frame_number, uint32_t *frame_offset) {
-    uint16_t frame_count;
-    if (!qgf_read_graphics_descriptor(stream, NULL, NULL, &frame_count, NULL)) {
+// Reads the graphics descriptor and validates the frame offsets block, leaving the stream at the first frame offset
+static bool qgf_seek_to_frame_offsets(qp_stream_t *stream, uint16_t *frame_count) {
+    if (!qgf_read_graphics_descriptor(stream, NULL, NULL, frame_count, NULL)) {
         return false;
     }
 
@@ -141,7 +141,12 @@ static bool qgf_read_frame_offset(qp_stream_t *stream, uint16_t frame_number, ui
     }
 
     // Make sure this block is valid
-    if (!qgf_validate_block_header(&frame_offsets.header, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, (frame_count * sizeof(uint32_t)))) {
+    return qgf_validate_block_header(&frame_offsets.header, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, (*frame_count * sizeof(uint32_t)));
+}
+
+static bool qgf_read_frame_offset(qp_stream_t *stream, uint16_t frame_number, uint32_t *frame_offset) {
+    uint16_t frame_count;
+    if (!qgf_seek_to_frame_offsets(stream, &frame_count)) {
         return false;
     }
 
@@ -168,6 +173,22 @@ static bool qgf_read_frame_offset(qp_stream_t *stream, uint16_t frame_number, ui
     return true;
 }
 
+uint16_t qgf_read_frame_offsets(qp_stream_t *stream, uint32_t *frame_offsets, uint16_t max_offsets) {
+    uint16_t frame_count;
+    if (!qgf_seek_to_frame_offsets(stream, &frame_count)) {
+        return 0;
+    }
+
+    // Only the leading frames are kept if the table isn't large enough
+    uint16_t count = frame_count < max_offsets ? frame_count : max_offsets;
+    if (count > 0 && qp_stream_read(frame_offsets, sizeof(uint32_t), count, stream) != count) {
+        qp_dprintf("Failed to read frame offsets, expected count was not %d\n", (int)count);
+        return 0;
+    }
+
+    return count;
+}
+
 void qgf_seek_to_frame_descriptor(qp_stream_t *stream, uint16_t frame_number) {
     // Read the offset
     uint32_t offset = 0;
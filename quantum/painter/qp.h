@@ -36,6 +36,25 @@
 #    define QUANTUM_PAINTER_NUM_IMAGES 8
 #endif // QUANTUM_PAINTER_NUM_IMAGES
 
+#ifndef QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS
+/**
+ * @def This controls the number of frame offsets each loaded image keeps in RAM, so that seeking to one of those frames
+ *      needs no reads of the image's frame offset table. Frames beyond this are located by reading the image as
+ *      before. Each entry requires 4 bytes of RAM per image. Set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS 16
+#endif // QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS
+
+#ifndef QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE
+/**
+ * @def This controls the number of converted palettes each loaded image remembers, keyed by the frame's palette, the
+ *      target device and the recolor arguments. Redrawing a frame with a remembered palette skips reading and
+ *      converting the palette again. Only palettes of up to 16 colors are cached; each entry requires roughly 80 bytes
+ *      of RAM per image. Set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE 2
+#endif // QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE
+
 #ifndef QUANTUM_PAINTER_NUM_FONTS
 /**
  * @def This controls the maximum number of fonts that Quantum Painter can load. Fonts can be loaded using
@@ -56,6 +75,15 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE
+/**
+ * @def This controls the number of recently used unicode glyphs each loaded font remembers the location of, saving a
+ *      search of the font's unicode glyph table when they are drawn or measured again. Each entry requires 8 bytes of
+ *      RAM per font. Set to 0 to disable.
+ */
+#    define QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE 8
+#endif // QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
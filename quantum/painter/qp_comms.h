@@ -16,6 +16,11 @@ bool     qp_comms_start(painter_device_t device);
 void     qp_comms_stop(painter_device_t device);
 uint32_t qp_comms_send(painter_device_t device, const void* data, uint32_t byte_count);
 
+// Starts sending `data` and returns without waiting for it to go out, if the comms driver is able to. The data must not
+// be modified until the transfer has completed, which qp_comms_wait() -- or any other comms call -- guarantees.
+bool qp_comms_send_async(painter_device_t device, const void* data, uint32_t byte_count);
+void qp_comms_wait(painter_device_t device);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Comms APIs that use a D/C pin
 
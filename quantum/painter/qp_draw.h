@@ -9,8 +9,13 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter utility functions
 
-// Global variable used for native pixel data streaming.
-extern uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+// Global variable used for native pixel data streaming, QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE bytes long.
+extern uint8_t *qp_internal_global_pixdata_buffer;
+
+// Sends the first `native_pixel_count` pixels of the global pixdata buffer to the device's current viewport. With
+// asynchronous comms the global pixdata buffer then points at a different buffer, as the transfer may still be reading
+// the old one -- anything written before the flush is gone afterwards.
+bool qp_internal_flush_pixdata(painter_device_t device, uint32_t native_pixel_count);
 
 // Check if the supplied bpp is capable of being rendered
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel);
@@ -64,9 +69,10 @@ enum qp_internal_rle_mode_t {
 };
 
 typedef struct qp_internal_byte_input_state_t {
-    painter_device_t device;
-    qp_stream_t*     src_stream;
-    int16_t          curr;
+    painter_device_t      device;
+    qp_stream_t*          src_stream;
+    painter_compression_t compression;
+    int16_t               curr;
     union {
         // RLE-specific
         struct {
@@ -93,3 +99,11 @@ typedef struct qp_internal_byte_output_state_t {
 bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
 
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
+
+// Reads the next byte_count decompressed bytes from the input state in bulk. Returns false if the stream ran out.
+bool qp_internal_read_bytes(qp_internal_byte_input_state_t* input_state, uint8_t* output, uint32_t byte_count);
+
+// Block-oriented equivalents of qp_internal_decode_palette() and qp_internal_send_bytes() writing into the global pixdata
+// buffer, which is sent to the device whenever it fills up. Leftovers are left in the buffer for the caller to send.
+bool qp_internal_decode_palette_to_pixdata(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_state_t* input_state, qp_pixel_t* palette, qp_internal_pixel_output_state_t* output_state);
+bool qp_internal_send_bytes_to_pixdata(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_state_t* input_state, qp_internal_byte_output_state_t* output_state);
@@ -91,37 +91,10 @@ static inline int16_t qp_drawimage_byte_uncompressed_decoder(void* cb_arg) {
 
 static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     qp_internal_byte_input_state_t* state = (qp_internal_byte_input_state_t*)cb_arg;
-
-    // Work out if we're parsing the initial marker byte
-    if (state->rle.mode == MARKER_BYTE) {
-        uint8_t c = qp_stream_get(state->src_stream);
-        if (c >= 128) {
-            state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
-            state->rle.remain = c - 127;
-        } else {
-            state->rle.mode   = REPEATING_RUN; // repeated run
-            state->rle.remain = c;
-        }
-
-        state->curr = qp_stream_get(state->src_stream);
-    }
-
-    // Work out which byte we're returning
-    uint8_t c = state->curr;
-
-    // Decrement the counter of the bytes remaining
-    state->rle.remain--;
-
-    if (state->rle.remain > 0) {
-        // If we're in a non-repeating run, queue up the next byte
-        if (state->rle.mode == NON_REPEATING_RUN) {
-            state->curr = qp_stream_get(state->src_stream);
-        }
-    } else {
-        // Swap back to querying the marker byte mode
-        state->rle.mode = MARKER_BYTE;
+    uint8_t                         c;
+    if (!qp_internal_read_bytes(state, &c, 1)) {
+        return STREAM_EOF;
     }
-
     return c;
 }
 
@@ -135,7 +108,7 @@ bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg
 
     // If we've hit the transmit limit, send out the entire buffer and reset the write position
     if (state->pixel_write_pos == state->max_pixels) {
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
+        if (!qp_internal_flush_pixdata(state->device, state->pixel_write_pos)) {
             return false;
         }
         state->pixel_write_pos = 0;
@@ -155,7 +128,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
     // If we've hit the transmit limit, send out the entire buffer and reset the write position
     if (state->byte_write_pos == state->max_bytes) {
         painter_driver_t* driver = (painter_driver_t*)state->device;
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+        if (!qp_internal_flush_pixdata(state->device, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
             return false;
         }
         state->byte_write_pos = 0;
@@ -165,6 +138,7 @@ bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
 }
 
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
+    input_state->compression = compression;
     switch (compression) {
         case IMAGE_UNCOMPRESSED:
             return qp_drawimage_byte_uncompressed_decoder;
@@ -176,3 +150,128 @@ qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte
             return NULL;
     }
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Bulk pull of bytes, push of pixel spans
+
+// Number of pixels unpacked in one go; a multiple of the pixels in a byte at every bpp, so spans stay byte-aligned
+#define QP_DECODE_SPAN_PIXELS 64
+
+bool qp_internal_read_bytes(qp_internal_byte_input_state_t* input_state, uint8_t* output, uint32_t byte_count) {
+    if (input_state->compression == IMAGE_UNCOMPRESSED) {
+        return qp_stream_read(output, 1, byte_count, input_state->src_stream) == byte_count;
+    }
+
+    // RLE: a marker byte below 128 repeats the following byte that many times, otherwise (marker - 127) bytes follow as-is
+    while (byte_count > 0) {
+        if (input_state->rle.mode == MARKER_BYTE) {
+            int16_t marker = qp_stream_get(input_state->src_stream);
+            if (marker < 0) {
+                return false;
+            }
+            if (marker >= 128) {
+                input_state->rle.mode   = NON_REPEATING_RUN;
+                input_state->rle.remain = marker - 127;
+            } else {
+                input_state->rle.mode   = REPEATING_RUN;
+                input_state->rle.remain = marker;
+                input_state->curr       = qp_stream_get(input_state->src_stream);
+                if (input_state->curr < 0) {
+                    return false;
+                }
+            }
+        }
+
+        uint32_t run_length = input_state->rle.remain < byte_count ? input_state->rle.remain : byte_count;
+        if (input_state->rle.mode == REPEATING_RUN) {
+            memset(output, input_state->curr, run_length);
+        } else if (qp_stream_read(output, 1, run_length, input_state->src_stream) != run_length) {
+            return false;
+        }
+
+        output += run_length;
+        byte_count -= run_length;
+        input_state->rle.remain -= run_length;
+        if (input_state->rle.remain == 0) {
+            input_state->rle.mode = MARKER_BYTE;
+        }
+    }
+    return true;
+}
+
+bool qp_internal_decode_palette_to_pixdata(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_state_t* input_state, qp_pixel_t* palette, qp_internal_pixel_output_state_t* output_state) {
+    painter_driver_t* driver           = (painter_driver_t*)device;
+    const uint8_t     pixel_bitmask    = (1 << bits_per_pixel) - 1;
+    const uint8_t     pixels_per_byte  = 8 / bits_per_pixel;
+    uint32_t          remaining_pixels = pixel_count;
+    uint8_t           packed[QP_DECODE_SPAN_PIXELS];
+    uint8_t           unpacked[QP_DECODE_SPAN_PIXELS];
+    while (remaining_pixels > 0) {
+        uint32_t span_pixels = remaining_pixels < QP_DECODE_SPAN_PIXELS ? remaining_pixels : QP_DECODE_SPAN_PIXELS;
+        uint32_t span_bytes  = (span_pixels + pixels_per_byte - 1) / pixels_per_byte;
+        if (!qp_internal_read_bytes(input_state, packed, span_bytes)) {
+            return false;
+        }
+
+        // Palette indices are packed least significant bits first
+        uint8_t* indices = packed;
+        if (pixels_per_byte > 1) {
+            indices = unpacked;
+            for (uint32_t i = 0; i < span_bytes; ++i) {
+                uint8_t byteval = packed[i];
+                for (uint8_t q = 0; q < pixels_per_byte; ++q) {
+                    unpacked[i * pixels_per_byte + q] = byteval & pixel_bitmask;
+                    byteval >>= bits_per_pixel;
+                }
+            }
+        }
+
+        // Hand the span to the driver, sending the pixdata buffer out whenever it fills up
+        remaining_pixels -= span_pixels;
+        while (span_pixels > 0) {
+            uint32_t space  = output_state->max_pixels - output_state->pixel_write_pos;
+            uint32_t pixels = span_pixels < space ? span_pixels : space;
+            if (!driver->driver_vtable->append_pixels(device, qp_internal_global_pixdata_buffer, palette, output_state->pixel_write_pos, pixels, indices)) {
+                return false;
+            }
+            output_state->pixel_write_pos += pixels;
+            indices += pixels;
+            span_pixels -= pixels;
+
+            if (output_state->pixel_write_pos == output_state->max_pixels) {
+                if (!qp_internal_flush_pixdata(device, output_state->pixel_write_pos)) {
+                    return false;
+                }
+                output_state->pixel_write_pos = 0;
+            }
+        }
+    }
+    return true;
+}
+
+bool qp_internal_send_bytes_to_pixdata(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_state_t* input_state, qp_internal_byte_output_state_t* output_state) {
+    painter_driver_t* driver          = (painter_driver_t*)device;
+    uint32_t          remaining_bytes = byte_count;
+    uint8_t           span[QP_DECODE_SPAN_PIXELS];
+    while (remaining_bytes > 0) {
+        uint32_t span_bytes = remaining_bytes < sizeof(span) ? remaining_bytes : sizeof(span);
+        if (!qp_internal_read_bytes(input_state, span, span_bytes)) {
+            return false;
+        }
+        remaining_bytes -= span_bytes;
+
+        for (uint32_t i = 0; i < span_bytes; ++i) {
+            if (!driver->driver_vtable->append_pixdata(device, qp_internal_global_pixdata_buffer, output_state->byte_write_pos++, span[i])) {
+                return false;
+            }
+
+            if (output_state->byte_write_pos == output_state->max_bytes) {
+                if (!qp_internal_flush_pixdata(device, output_state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+                    return false;
+                }
+                output_state->byte_write_pos = 0;
+            }
+        }
+    }
+    return true;
+}
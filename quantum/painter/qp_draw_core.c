@@ -19,8 +19,14 @@ _Static_assert((QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE > 0) && (QUANTUM_PAINTER_PIX
 //       **** very likely get artifacts rendered to the screen as a result.                                       ****
 //
 
-// Buffer used for transmitting native pixel data to the downstream device.
-__attribute__((__aligned__(4))) uint8_t qp_internal_global_pixdata_buffer[QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+// Buffers used for transmitting native pixel data to the downstream device. With asynchronous comms one is being filled
+// while the other is still going out to the display.
+#ifdef QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[2][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#else
+__attribute__((__aligned__(4))) static uint8_t qp_internal_pixdata_buffers[1][QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE];
+#endif
+uint8_t *qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[0];
 
 // Static buffer to contain a generated color palette
 static bool                                       generated_palette = false;
@@ -47,12 +53,26 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y)
     return driver->driver_vtable->viewport(device, x, y, x, y) && driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, 1);
 }
 
+// Sends the start of the global pixdata buffer to the device, then moves on to the other buffer if the transfer may
+// still be reading from this one.
+bool qp_internal_flush_pixdata(painter_device_t device, uint32_t native_pixel_count) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    bool              ret    = driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, native_pixel_count);
+#ifdef QUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+    qp_internal_global_pixdata_buffer = qp_internal_pixdata_buffers[qp_internal_global_pixdata_buffer == qp_internal_pixdata_buffers[0] ? 1 : 0];
+#endif
+    return ret;
+}
+
 // Fills the global native pixel buffer with equivalent pixels matching the supplied HSV
 void qp_internal_fill_pixdata(painter_device_t device, uint32_t num_pixels, uint8_t hue, uint8_t sat, uint8_t val) {
     painter_driver_t *driver            = (painter_driver_t *)device;
     uint32_t          pixels_in_pixdata = qp_internal_num_pixels_in_buffer(device);
     num_pixels                          = QP_MIN(pixels_in_pixdata, num_pixels);
 
+    // The buffer may still be going out from the last fill
+    qp_comms_wait(device);
+
     // Convert the color to native pixel format
     qp_pixel_t color = {.hsv888 = {.h = hue, .s = sat, .v = val}};
     driver->driver_vtable->palette_convert(device, 1, &color);
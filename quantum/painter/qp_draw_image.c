@@ -10,9 +10,31 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QGF image handles
 
+#if QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+// A palette already converted to the native format of a device. Palettes read from the image are keyed by where the
+// palette lives in the stream, interpolated palettes have no offset and are keyed by their colors instead.
+typedef struct qgf_cached_palette_t {
+    painter_device_t device;
+    uint32_t         palette_offset;
+    qp_pixel_t       fg_hsv888;
+    qp_pixel_t       bg_hsv888;
+    uint8_t          bpp;
+    qp_pixel_t       palette[16];
+} qgf_cached_palette_t;
+#endif // QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+
 typedef struct qgf_image_handle_t {
     painter_image_desc_t base;
     bool                 validate_ok;
+#if QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS > 0
+    uint16_t frame_offset_count;
+    uint32_t frame_offsets[QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS];
+#endif // QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS > 0
+#if QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+    uint8_t              palette_cache_count;
+    uint8_t              palette_cache_next;
+    qgf_cached_palette_t palette_cache[QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE];
+#endif // QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
@@ -59,6 +81,17 @@ static painter_image_handle_t qp_load_image_internal(bool (*stream_factory)(qgf_
     // Fill out the QP image descriptor
     qgf_read_graphics_descriptor(&image->stream, &image->base.width, &image->base.height, &image->base.frame_count, NULL);
 
+#if QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS > 0
+    // Keep the frame offsets around so seeking to a frame doesn't need to read them again
+    image->frame_offset_count = qgf_read_frame_offsets(&image->stream, image->frame_offsets, QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS);
+#endif // QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS > 0
+
+#if QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+    // Nothing converted for this image yet
+    image->palette_cache_count = 0;
+    image->palette_cache_next  = 0;
+#endif // QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+
     // Validation success, we can return the handle
     image->validate_ok = true;
     qp_dprintf("qp_load_image: ok\n");
@@ -124,6 +157,40 @@ typedef struct qgf_frame_info_t {
     uint16_t              delay;
 } qgf_frame_info_t;
 
+static void qp_drawimage_seek_to_frame(qgf_image_handle_t *qgf_image, uint16_t frame_number) {
+#if QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS > 0
+    if (frame_number < qgf_image->frame_offset_count) {
+        qp_stream_setpos(&qgf_image->stream, qgf_image->frame_offsets[frame_number]);
+        return;
+    }
+#endif // QUANTUM_PAINTER_IMAGE_FRAME_OFFSETS > 0
+    qgf_seek_to_frame_descriptor(&qgf_image->stream, frame_number);
+}
+
+#if QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+static qgf_cached_palette_t *qp_drawimage_find_cached_palette(qgf_image_handle_t *qgf_image, const qgf_cached_palette_t *key) {
+    for (uint8_t i = 0; i < qgf_image->palette_cache_count; ++i) {
+        qgf_cached_palette_t *entry = &qgf_image->palette_cache[i];
+        if (entry->device == key->device && entry->palette_offset == key->palette_offset && entry->bpp == key->bpp && entry->fg_hsv888.dummy == key->fg_hsv888.dummy && entry->bg_hsv888.dummy == key->bg_hsv888.dummy) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void qp_drawimage_cache_palette(qgf_image_handle_t *qgf_image, const qgf_cached_palette_t *key, uint16_t palette_entries) {
+    // Fill up the cache first, then replace the oldest entry
+    qgf_cached_palette_t *entry   = &qgf_image->palette_cache[qgf_image->palette_cache_next];
+    qgf_image->palette_cache_next = (qgf_image->palette_cache_next + 1) % QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE;
+    if (qgf_image->palette_cache_count < QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE) {
+        ++qgf_image->palette_cache_count;
+    }
+
+    *entry = *key;
+    memcpy(entry->palette, qp_internal_global_pixel_lookup_table, palette_entries * sizeof(qp_pixel_t));
+}
+#endif // QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+
 static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device, qgf_image_handle_t *qgf_image, uint16_t frame_number, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qgf_frame_info_t *info) {
     painter_driver_t *driver = (painter_driver_t *)device;
 
@@ -134,7 +201,7 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     }
 
     // Seek to the frame
-    qgf_seek_to_frame_descriptor(&qgf_image->stream, frame_number);
+    qp_drawimage_seek_to_frame(qgf_image, frame_number);
 
     // Read the frame descriptor
     qgf_frame_v1_t frame_descriptor;
@@ -160,7 +227,35 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
     // Handle palette if needed
     const uint16_t palette_entries  = 1u << info->bpp;
     bool           needs_pixconvert = false;
-    if (info->has_palette) {
+    bool           palette_cached   = false;
+
+#if QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+    // Reuse the palette if this image has already converted it for this device
+    qgf_cached_palette_t palette_key = {.device = device, .bpp = info->bpp};
+    bool                 cacheable   = (info->has_palette || info->bpp <= 8) && palette_entries <= (sizeof(palette_key.palette) / sizeof(palette_key.palette[0]));
+    if (cacheable) {
+        if (info->has_palette) {
+            palette_key.palette_offset = qp_stream_tell(&qgf_image->stream);
+        } else {
+            palette_key.fg_hsv888 = fg_hsv888;
+            palette_key.bg_hsv888 = bg_hsv888;
+        }
+
+        qgf_cached_palette_t *cached = qp_drawimage_find_cached_palette(qgf_image, &palette_key);
+        if (cached) {
+            memcpy(qp_internal_global_pixel_lookup_table, cached->palette, palette_entries * sizeof(qp_pixel_t));
+            if (info->has_palette) {
+                // Skip over the palette block
+                qp_stream_seek(&qgf_image->stream, sizeof(qgf_palette_v1_t) + palette_entries * sizeof(qgf_palette_entry_v1_t), SEEK_CUR);
+            }
+            palette_cached = true;
+        }
+    }
+#endif // QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+
+    if (palette_cached) {
+        // Already in the device's native format
+    } else if (info->has_palette) {
         // Load the palette from the stream
         if (!qp_internal_load_qgf_palette((qp_stream_t *)&qgf_image->stream, info->bpp)) {
             return false;
@@ -181,6 +276,12 @@ static bool qp_drawimage_prepare_frame_for_stream_read(painter_device_t device,
             qp_comms_stop(device);
             return false;
         }
+
+#if QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
+        if (cacheable) {
+            qp_drawimage_cache_palette(qgf_image, &palette_key, palette_entries);
+        }
+#endif // QUANTUM_PAINTER_IMAGE_PALETTE_CACHE_SIZE > 0
     }
 
     // Handle delta if needed
@@ -255,9 +356,8 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
     }
 
     // Set up the input state
-    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qgf_image->stream};
-    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme);
-    if (input_callback == NULL) {
+    qp_internal_byte_input_state_t input_state = {.device = device, .src_stream = &qgf_image->stream};
+    if (qp_internal_prepare_input_state(&input_state, frame_info->compression_scheme) == NULL) {
         qp_dprintf("qp_drawimage_recolor: fail (invalid image compression scheme)\n");
         qp_comms_stop(device);
         return false;
@@ -269,10 +369,10 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
         qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
         // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, frame_info->bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        ret = qp_internal_decode_palette_to_pixdata(device, pixel_count, frame_info->bpp, &input_state, qp_internal_global_pixel_lookup_table, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
+            ret &= qp_internal_flush_pixdata(device, output_state.pixel_write_pos);
         }
     } else if (frame_info->bpp != driver->native_bits_per_pixel) {
         // Prevent stuff like drawing 24bpp images on 16bpp displays
@@ -284,10 +384,10 @@ static bool qp_drawimage_recolor_impl(painter_device_t device, uint16_t x, uint1
 
         // Stream the raw pixel data to the display
         uint32_t byte_count = pixel_count * frame_info->bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, &input_state, qp_internal_byte_appender, &output_state);
+        ret                 = qp_internal_send_bytes_to_pixdata(device, byte_count, &input_state, &output_state);
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
-            ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+            ret &= qp_internal_flush_pixdata(device, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
         }
     }
 
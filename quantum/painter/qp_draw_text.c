@@ -12,15 +12,28 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // QFF font handles
 
+#if QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+typedef struct qff_glyph_cache_entry_t {
+    uint32_t code_point;
+    uint32_t value; // As per the glyph table, uses QFF_GLYPH_*_(BITS|MASK)
+} qff_glyph_cache_entry_t;
+#endif // QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+
 typedef struct qff_font_handle_t {
     painter_font_desc_t   base;
     bool                  validate_ok;
     bool                  has_ascii_table;
     uint16_t              num_unicode_glyphs;
+    bool                  sorted_unicode_table;
     uint8_t               bpp;
     bool                  has_palette;
     bool                  is_panel_native;
     painter_compression_t compression_scheme;
+    uint32_t              glyph_data_offset; // Where the glyph data starts, past the data block header
+#if QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+    uint8_t                 glyph_cache_count;
+    qff_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE]; // Most recently used first
+#endif // QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
     union {
         qp_stream_t        stream;
         qp_memory_stream_t mem_stream;
@@ -98,7 +111,16 @@ static painter_font_handle_t qp_load_font_internal(bool (*stream_factory)(qff_fo
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
     // Read the info (parsing already successful above, no need to check return value)
-    qff_read_font_descriptor(&font->stream, &font->base.line_height, &font->has_ascii_table, &font->num_unicode_glyphs, &font->bpp, &font->has_palette, &font->is_panel_native, &font->compression_scheme, NULL);
+    qff_read_font_descriptor(&font->stream, &font->base.line_height, &font->has_ascii_table, &font->num_unicode_glyphs, &font->sorted_unicode_table, &font->bpp, &font->has_palette, &font->is_panel_native, &font->compression_scheme, NULL);
+
+    font->glyph_data_offset = sizeof(qff_font_descriptor_v1_t)                                                                                                             // Skip the font descriptor
+                              + (font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                           // Skip the ascii table
+                              + (font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
+                              + (font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                 // Skip the palette
+                              + sizeof(qgf_block_header_v1_t);                                                                                                             // Skip the data block header
+#if QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+    font->glyph_cache_count = 0;
+#endif // QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
 
     if (!qp_internal_bpp_capable(font->bpp)) {
         qp_dprintf("qp_load_font: fail (image bpp too high (%d), check QUANTUM_PAINTER_SUPPORTS_256_PALETTE or QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)\n", (int)font->bpp);
@@ -214,7 +236,98 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     return true;
 }
 
+#if QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+static bool qff_glyph_cache_lookup(qff_font_handle_t *qff_font, uint32_t code_point, uint32_t *value) {
+    for (uint8_t i = 0; i < qff_font->glyph_cache_count; ++i) {
+        if (qff_font->glyph_cache[i].code_point == code_point) {
+            // Move the entry to the front, keeping the rest in order of use
+            qff_glyph_cache_entry_t entry = qff_font->glyph_cache[i];
+            memmove(&qff_font->glyph_cache[1], &qff_font->glyph_cache[0], i * sizeof(qff_glyph_cache_entry_t));
+            qff_font->glyph_cache[0] = entry;
+            *value                   = entry.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void qff_glyph_cache_insert(qff_font_handle_t *qff_font, uint32_t code_point, uint32_t value) {
+    // Evicts the least recently used entry once full
+    if (qff_font->glyph_cache_count < QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE) {
+        qff_font->glyph_cache_count++;
+    }
+    memmove(&qff_font->glyph_cache[1], &qff_font->glyph_cache[0], (qff_font->glyph_cache_count - 1) * sizeof(qff_glyph_cache_entry_t));
+    qff_font->glyph_cache[0] = (qff_glyph_cache_entry_t){.code_point = code_point, .value = value};
+}
+#endif // QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+
+static bool qff_read_unicode_glyph(qff_font_handle_t *qff_font, uint32_t table_offset, uint16_t index, qff_unicode_glyph_v1_t *glyph_info) {
+    if (qp_stream_setpos(&qff_font->stream, table_offset + index * sizeof(qff_unicode_glyph_v1_t)) < 0) {
+        qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
+        return false;
+    }
+
+    if (qp_stream_read(glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
+        qp_dprintf("Failed to read unicode glyph info\n");
+        return false;
+    }
+
+    return true;
+}
+
+// Finds the glyph info for a code point in the unicode table, which may include singular ascii glyphs if full ascii table isn't specified
+static bool qff_find_unicode_glyph(qff_font_handle_t *qff_font, uint32_t code_point, uint32_t *value) {
+    uint32_t table_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
+                            + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
+                            + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
+
+    qff_unicode_glyph_v1_t glyph_info;
+    if (qff_font->sorted_unicode_table) {
+        // Binary search
+        uint16_t low  = 0;
+        uint16_t high = qff_font->num_unicode_glyphs;
+        while (low < high) {
+            uint16_t mid = low + (high - low) / 2;
+            if (!qff_read_unicode_glyph(qff_font, table_offset, mid, &glyph_info)) {
+                return false;
+            }
+
+            if (glyph_info.code_point == code_point) {
+                *value = glyph_info.value;
+                return true;
+            } else if (glyph_info.code_point < code_point) {
+                low = mid + 1;
+            } else {
+                high = mid;
+            }
+        }
+    } else {
+        // Unsorted table from an older font, read through it in order
+        if (qp_stream_setpos(&qff_font->stream, table_offset) < 0) {
+            qp_dprintf("Failed to set stream position while preparing glyph data\n");
+            return false;
+        }
+
+        for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
+            if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
+                qp_dprintf("Failed to read unicode glyph info\n");
+                return false;
+            }
+
+            if (glyph_info.code_point == code_point) {
+                *value = glyph_info.value;
+                return true;
+            }
+        }
+    }
+
+    // Not found
+    qp_dprintf("Failed to find unicode glyph info\n");
+    return false;
+}
+
 static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
+    uint32_t glyph_value;
     if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
         // Do ascii table
         qff_ascii_glyph_v1_t glyph_info;
@@ -231,65 +344,31 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
-        uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-        uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-        uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                               + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                               + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                               + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                               + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                               + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-        if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing ascii glyph data\n");
-            return false;
-        }
-
-        *width = glyph_width;
-        return true;
+        glyph_value = glyph_info.value;
     } else {
-        // Do unicode table, which may include singular ascii glyphs if full ascii table isn't specified
-        uint32_t glyph_info_offset = sizeof(qff_font_descriptor_v1_t)                                       // Skip the font descriptor
-                                     + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
-                                     + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
-
-        if (qp_stream_setpos(&qff_font->stream, glyph_info_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing glyph data\n");
-            return false;
-        }
-
-        qff_unicode_glyph_v1_t glyph_info;
-        for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
-            if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
-                qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
+#if QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+        if (!qff_glyph_cache_lookup(qff_font, code_point, &glyph_value)) {
+            if (!qff_find_unicode_glyph(qff_font, code_point, &glyph_value)) {
                 return false;
             }
-
-            if (glyph_info.code_point == code_point) {
-                uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-                uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-                uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                                       + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                                       + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                                       + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                                       + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                                       + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-                if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
-                    qp_dprintf("Failed to set stream position while preparing unicode glyph data\n");
-                    return false;
-                }
-
-                *width = glyph_width;
-                return true;
-            }
+            qff_glyph_cache_insert(qff_font, code_point, glyph_value);
+        }
+#else  // QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+        if (!qff_find_unicode_glyph(qff_font, code_point, &glyph_value)) {
+            return false;
         }
+#endif // QUANTUM_PAINTER_FONT_GLYPH_CACHE_SIZE > 0
+    }
 
-        // Not found
-        qp_dprintf("Failed to find unicode glyph info\n");
+    uint8_t  glyph_width  = (uint8_t)(glyph_value & QFF_GLYPH_WIDTH_MASK);
+    uint32_t glyph_offset = ((glyph_value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
+    if (qp_stream_setpos(&qff_font->stream, qff_font->glyph_data_offset + glyph_offset) < 0) {
+        qp_dprintf("Failed to set stream position while preparing glyph data\n");
         return false;
     }
-    return false;
+
+    *width = glyph_width;
+    return true;
 }
 
 // Function to iterate over each UTF8 codepoint, invoking the callback for each decoded glyph
@@ -342,7 +421,6 @@ typedef struct code_point_iter_drawglyph_state_t {
     painter_device_t                  device;
     int16_t                           xpos;
     int16_t                           ypos;
-    qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
 } code_point_iter_drawglyph_state_t;
@@ -366,11 +444,11 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
 
     // Decode the pixel data for the glyph
     uint32_t pixel_count = ((uint32_t)width) * height;
-    bool     ret         = qp_internal_decode_palette(state->device, pixel_count, qff_font->bpp, state->input_callback, state->input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, state->output_state);
+    bool     ret         = qp_internal_decode_palette_to_pixdata(state->device, pixel_count, qff_font->bpp, state->input_state, qp_internal_global_pixel_lookup_table, state->output_state);
 
     // Any leftovers need transmission as well.
     if (ret && state->output_state->pixel_write_pos > 0) {
-        ret &= driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->output_state->pixel_write_pos);
+        ret &= qp_internal_flush_pixdata(state->device, state->output_state->pixel_write_pos);
     }
 
     return ret;
@@ -423,10 +501,9 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
         return 0;
     }
 
-    // Set up the byte input state and input callback
-    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = &qff_font->stream};
-    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme);
-    if (input_callback == NULL) {
+    // Set up the byte input state
+    qp_internal_byte_input_state_t input_state = {.device = device, .src_stream = &qff_font->stream};
+    if (qp_internal_prepare_input_state(&input_state, qff_font->compression_scheme) == NULL) {
         qp_dprintf("qp_drawtext_recolor: fail (invalid font compression scheme)\n");
         qp_comms_stop(device);
         return false;
@@ -441,8 +518,7 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
                                                .xpos   = x,
                                                .ypos   = y,
                                                // Input
-                                               .input_callback = input_callback,
-                                               .input_state    = &input_state,
+                                               .input_state = &input_state,
                                                // Output
                                                .output_state = &output_state};
 
@@ -38,12 +38,16 @@ typedef bool (*painter_driver_comms_init_func)(painter_device_t device);
 typedef bool (*painter_driver_comms_start_func)(painter_device_t device);
 typedef void (*painter_driver_comms_stop_func)(painter_device_t device);
 typedef uint32_t (*painter_driver_comms_send_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef bool (*painter_driver_comms_send_async_func)(painter_device_t device, const void *data, uint32_t byte_count);
+typedef void (*painter_driver_comms_wait_func)(painter_device_t device);
 
 typedef struct painter_comms_vtable_t {
-    painter_driver_comms_init_func  comms_init;
-    painter_driver_comms_start_func comms_start;
-    painter_driver_comms_stop_func  comms_stop;
-    painter_driver_comms_send_func  comms_send;
+    painter_driver_comms_init_func       comms_init;
+    painter_driver_comms_start_func      comms_start;
+    painter_driver_comms_stop_func       comms_stop;
+    painter_driver_comms_send_func       comms_send;
+    painter_driver_comms_send_async_func comms_send_async; // optional, returns once the transfer is under way -- `data` must be left untouched until comms_wait()
+    painter_driver_comms_wait_func       comms_wait;       // optional, blocks until the transfer started by comms_send_async() has completed
 } painter_comms_vtable_t;
 
 typedef void (*painter_driver_comms_send_command_func)(painter_device_t device, uint8_t cmd);
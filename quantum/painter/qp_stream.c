@@ -7,6 +7,10 @@
 // Stream API
 
 uint32_t qp_stream_read_impl(void *output_buf, uint32_t member_size, uint32_t num_members, qp_stream_t *stream) {
+    if (stream->read_block) {
+        return stream->read_block(stream, output_buf, num_members * member_size) / member_size;
+    }
+
     uint8_t *output_ptr = (uint8_t *)output_buf;
 
     uint32_t i;
@@ -47,6 +51,19 @@ static inline int16_t mem_get(qp_stream_t *stream) {
     return s->buffer[s->position++];
 }
 
+static inline uint32_t mem_read_block(qp_stream_t *stream, void *output_buf, uint32_t length) {
+    qp_memory_stream_t *s         = (qp_memory_stream_t *)stream;
+    uint32_t            available = s->position < s->length ? s->length - s->position : 0;
+    if (length > available) {
+        // Same as reading byte by byte, hitting the end sets EOF
+        length    = available;
+        s->is_eof = true;
+    }
+    memcpy(output_buf, &s->buffer[s->position], length);
+    s->position += length;
+    return length;
+}
+
 static inline bool mem_put(qp_stream_t *stream, uint8_t c) {
     qp_memory_stream_t *s = (qp_memory_stream_t *)stream;
     if (s->position >= s->length) {
@@ -111,7 +128,7 @@ static inline void mem_close(qp_stream_t *stream) {
 
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     qp_memory_stream_t stream = {
-        .base     = {.get = mem_get, .put = mem_put, .seek = mem_seek, .tell = mem_tell, .is_eof = mem_is_eof, .close = mem_close},
+        .base     = {.get = mem_get, .put = mem_put, .read_block = mem_read_block, .seek = mem_seek, .tell = mem_tell, .is_eof = mem_is_eof, .close = mem_close},
         .buffer   = (uint8_t *)buffer,
         .length   = length,
         .position = 0,
@@ -131,6 +148,11 @@ static inline int16_t file_get(qp_stream_t *stream) {
     return (uint16_t)c;
 }
 
+static inline uint32_t file_read_block(qp_stream_t *stream, void *output_buf, uint32_t length) {
+    qp_file_stream_t *s = (qp_file_stream_t *)stream;
+    return (uint32_t)fread(output_buf, 1, length, s->file);
+}
+
 static inline bool file_put(qp_stream_t *stream, uint8_t c) {
     qp_file_stream_t *s = (qp_file_stream_t *)stream;
     return fputc(c, s->file) == c;
@@ -158,7 +180,7 @@ static inline void file_close(qp_stream_t *stream) {
 
 qp_file_stream_t qp_make_file_stream(FILE *f) {
     qp_file_stream_t stream = {
-        .base = {.get = file_get, .put = file_put, .seek = file_seek, .tell = file_tell, .is_eof = file_is_eof, .close = file_close},
+        .base = {.get = file_get, .put = file_put, .read_block = file_read_block, .seek = file_seek, .tell = file_tell, .is_eof = file_is_eof, .close = file_close},
         .file = f,
     };
     return stream;
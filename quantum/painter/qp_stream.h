@@ -51,6 +51,7 @@ uint32_t qp_stream_write_impl(const void *input_buf, uint32_t member_size, uint3
 typedef struct qp_stream_t {
     int16_t (*get)(qp_stream_t *stream);
     bool (*put)(qp_stream_t *stream, uint8_t c);
+    uint32_t (*read_block)(qp_stream_t *stream, void *output_buf, uint32_t length); // optional, qp_stream_read() falls back to get()
     int (*seek)(qp_stream_t *stream, int32_t offset, int origin);
     int32_t (*tell)(qp_stream_t *stream);
     bool (*is_eof)(qp_stream_t *stream);
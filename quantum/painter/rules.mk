@@ -4,6 +4,8 @@ QUANTUM_PAINTER_ANIMATIONS_ENABLE ?= yes
 
 QUANTUM_PAINTER_LVGL_INTEGRATION ?= no
 
+QUANTUM_PAINTER_ASYNC_COMMS ?= no
+
 # The list of permissible drivers that can be listed in QUANTUM_PAINTER_DRIVERS
 VALID_QUANTUM_PAINTER_DRIVERS := \
     surface \
@@ -173,7 +175,8 @@ ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_SURFACE)), yes)
     SRC += \
         $(DRIVER_PATH)/painter/generic/qp_surface_common.c \
         $(DRIVER_PATH)/painter/generic/qp_surface_mono1bpp.c \
-        $(DRIVER_PATH)/painter/generic/qp_surface_rgb565.c
+        $(DRIVER_PATH)/painter/generic/qp_surface_rgb565.c \
+        $(DRIVER_PATH)/painter/generic/qp_surface_layers.c
 endif
 
 # If dummy comms is needed, set up the required files
@@ -209,6 +212,15 @@ ifeq ($(strip $(QUANTUM_PAINTER_NEEDS_COMMS_I2C)), yes)
         $(DRIVER_PATH)/painter/comms/qp_comms_i2c.c
 endif
 
+# Check if pixel data should be sent to the display in the background
+ifeq ($(strip $(QUANTUM_PAINTER_ASYNC_COMMS)), yes)
+    ifeq ($(filter $(PLATFORM_KEY),chibios test),)
+        $(call CATASTROPHIC_ERROR,Invalid QUANTUM_PAINTER_ASYNC_COMMS,QUANTUM_PAINTER_ASYNC_COMMS is not supported on this platform)
+    endif
+    OPT_DEFS += -DQUANTUM_PAINTER_ASYNC_COMMS_ENABLE
+    BACKGROUND_WORKER_REQUIRED = yes
+endif
+
 # Check if LVGL needs to be enabled
 ifeq ($(strip $(QUANTUM_PAINTER_LVGL_INTEGRATION)), yes)
     include $(QUANTUM_DIR)/painter/lvgl/rules.mk
@@ -20,6 +20,7 @@
 #include "timer.h"
 #include "keycodes.h"
 #include "qmk_settings.h"
+#include "latency_tracing.h"
 
 #ifndef AUTO_SHIFT_DISABLED_AT_STARTUP
 #    define AUTO_SHIFT_STARTUP_STATE true /* enabled */
@@ -208,7 +209,9 @@ if (!QS_auto_shift_modifiers) {
             del_mods(MOD_BIT(KC_RSFT));
         }
         // autoshift_shift_state doesn't need to be changed.
+        LATENCY_TRACING_BEGIN(record->event.time, LATENCY_PATH_AUTO_SHIFT);
         autoshift_press_user(autoshift_lastkey, autoshift_flags.lastshifted, record);
+        LATENCY_TRACING_END();
         return false;
     }
 #endif
@@ -264,7 +267,9 @@ static void autoshift_end(uint16_t keycode, uint16_t now, bool matrix_trigger, k
             autoshift_flags.cancelling_rshift = true;
             del_mods(MOD_BIT(KC_RSFT));
         }
+        LATENCY_TRACING_BEGIN(autoshift_time, LATENCY_PATH_AUTO_SHIFT);
         autoshift_press_user(autoshift_lastkey, autoshift_flags.lastshifted, record);
+        LATENCY_TRACING_END();
 
         // clang-format off
 #if (defined(AUTO_SHIFT_REPEAT) || defined(AUTO_SHIFT_REPEAT_PER_KEY)) && (!defined(AUTO_SHIFT_NO_AUTO_REPEAT) || defined(AUTO_SHIFT_NO_AUTO_REPEAT_PER_KEY))
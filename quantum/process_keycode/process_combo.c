@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -25,6 +26,7 @@
 #include "action_layer.h"
 #include "action_tapping.h"
 #include "action_util.h"
+#include "latency_tracing.h"
 #include "action.h"
 
 #ifdef VIAL_ENABLE
@@ -117,6 +119,81 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+/* Set whenever a combo's state or flags may have changed, so clear_combos()
+ * only has to walk the combo list after combo keys were involved. */
+static bool combo_states_dirty = false;
+
+#ifdef COMBO_INDEX_ENABLE
+/* Inverted index of (keycode, combo) pairs, sorted by keycode and then by
+ * combo index, so that an event only visits the combos containing its key. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_index_entry_t;
+
+enum {
+    COMBO_INDEX_STALE,
+    COMBO_INDEX_READY,
+    COMBO_INDEX_OVERFLOW, // doesn't fit COMBO_INDEX_LENGTH, fall back to scanning every combo
+};
+
+static uint8_t             combo_index_state = COMBO_INDEX_STALE;
+static uint16_t            combo_index_size  = 0;
+static combo_index_entry_t combo_index_entries[COMBO_INDEX_LENGTH];
+
+static bool combo_index_insert(uint16_t keycode, uint16_t combo_index) {
+    uint16_t pos = combo_index_size;
+    while (pos > 0 && combo_index_entries[pos - 1].keycode > keycode) {
+        pos--;
+    }
+    if (pos > 0 && combo_index_entries[pos - 1].keycode == keycode && combo_index_entries[pos - 1].combo_index == combo_index) {
+        // key listed twice in the same combo
+        return true;
+    }
+    if (combo_index_size >= COMBO_INDEX_LENGTH) {
+        return false;
+    }
+    memmove(&combo_index_entries[pos + 1], &combo_index_entries[pos], (combo_index_size - pos) * sizeof(combo_index_entry_t));
+    combo_index_entries[pos] = (combo_index_entry_t){
+        .keycode     = keycode,
+        .combo_index = combo_index,
+    };
+    combo_index_size++;
+    return true;
+}
+
+static uint16_t combo_index_lower_bound(uint16_t keycode) {
+    uint16_t lo = 0;
+    uint16_t hi = combo_index_size;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (combo_index_entries[mid].keycode < keycode) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+#endif
+
+void combo_index_rebuild(void) {
+#ifdef COMBO_INDEX_ENABLE
+    combo_index_size  = 0;
+    combo_index_state = COMBO_INDEX_READY;
+    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+        const uint16_t *keys = combo_get(idx)->keys;
+        uint16_t        key;
+        for (uint8_t i = 0; (key = pgm_read_word(&keys[i])) != COMBO_END; ++i) {
+            if (!combo_index_insert(key, idx)) {
+                combo_index_state = COMBO_INDEX_OVERFLOW;
+                return;
+            }
+        }
+    }
+#endif
+}
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -217,10 +294,17 @@ static inline uint16_t _get_combo_term(uint16_t combo_index, combo_t *combo) {
 void clear_combos(void) {
     uint16_t index = 0;
     longest_term   = 0;
+    if (!combo_states_dirty) {
+        return;
+    }
+    combo_states_dirty = false;
     for (index = 0; index < combo_count(); ++index) {
         combo_t *combo = combo_get(index);
         if (!COMBO_ACTIVE(combo)) {
             RESET_COMBO_STATE(combo);
+        } else {
+            // still held, has to be reset once it is released
+            combo_states_dirty = true;
         }
     }
 }
@@ -246,6 +330,7 @@ static inline void dump_key_buffer(void) {
             continue;
         }
 
+        LATENCY_TRACING_BEGIN(record->event.time, LATENCY_PATH_COMBO);
         if (!record->keycode && qrecord->combo_index != (uint16_t)-1) {
             process_combo_event(qrecord->combo_index, true);
         } else {
@@ -255,6 +340,7 @@ static inline void dump_key_buffer(void) {
             process_record(record);
 #endif
         }
+        LATENCY_TRACING_END();
         record->event.type = TICK_EVENT;
 
 #if defined(CAPS_WORD_ENABLE) && defined(AUTO_SHIFT_ENABLE)
@@ -279,7 +365,6 @@ static inline void dump_key_buffer(void) {
     key_buffer_next = key_buffer_size = 0;
 }
 
-#define NO_COMBO_KEYS_ARE_DOWN (0 == COMBO_STATE(combo))
 #define ALL_COMBO_KEYS_ARE_DOWN(state, key_count) (((1 << key_count) - 1) == state)
 #define ONLY_ONE_KEY_IS_DOWN(state) !(state & (state - 1))
 #define KEY_NOT_YET_RELEASED(state, key_index) ((1 << key_index) & state)
@@ -311,6 +396,7 @@ void drop_combo_from_buffer(uint16_t combo_index) {
         if (qcombo->combo_index == combo_index) {
             combo_t *combo = combo_get(combo_index);
             DISABLE_COMBO(combo);
+            combo_states_dirty = true;
 
             if (i == combo_buffer_read) {
                 INCREMENT_MOD(combo_buffer_read);
@@ -446,6 +532,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
     if (-1 == (int16_t)key_index) {
         return false;
     }
+    combo_states_dirty = true;
 
     bool key_is_part_of_combo = (!COMBO_DISABLED(combo) && is_combo_enabled()
 #if defined(COMBO_MUST_PRESS_IN_ORDER) || defined(COMBO_MUST_PRESS_IN_ORDER_PER_COMBO)
@@ -558,8 +645,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -587,10 +673,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_INDEX_ENABLE
+    if (combo_index_state == COMBO_INDEX_STALE) {
+        combo_index_rebuild();
+    }
+    if (combo_index_state == COMBO_INDEX_READY) {
+        for (uint16_t i = combo_index_lower_bound(keycode); i < combo_index_size && combo_index_entries[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_index_entries[i].combo_index;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
@@ -673,3 +770,12 @@ void combo_toggle(void) {
 bool is_combo_enabled(void) {
     return b_combo_enable;
 }
+
+bool is_combo_pending(void) {
+#ifndef COMBO_NO_TIMER
+    if (timer != 0) {
+        return true;
+    }
+#endif
+    return key_buffer_size != 0;
+}
@@ -39,6 +39,17 @@
 #    define COMBO_BUFFER_LENGTH 4
 #endif
 
+#if !defined(COMBO_NO_INDEX) && !defined(__AVR__)
+#    define COMBO_INDEX_ENABLE
+#endif
+#ifndef COMBO_INDEX_LENGTH
+#    ifdef VIAL_COMBO_ENABLE
+#        define COMBO_INDEX_LENGTH (VIAL_COMBO_ENTRIES * 4)
+#    else
+#        define COMBO_INDEX_LENGTH 64
+#    endif
+#endif
+
 typedef struct combo_t {
     const uint16_t *keys;
     uint16_t        keycode;
@@ -77,7 +88,10 @@ bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+void combo_index_rebuild(void);
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
 bool is_combo_enabled(void);
+bool is_combo_pending(void);
@@ -188,6 +188,10 @@ void tap_dance_task(void) {
     }
 }
 
+bool is_tap_dance_pending(void) {
+    return active_td != 0;
+}
+
 void reset_tap_dance(tap_dance_state_t *state) {
     active_td = 0;
     process_tap_dance_action_on_reset((tap_dance_action_t *)state);
@@ -87,6 +87,7 @@ void reset_tap_dance(tap_dance_state_t *state);
 bool preprocess_tap_dance(uint16_t keycode, keyrecord_t *record);
 bool process_tap_dance(uint16_t keycode, keyrecord_t *record);
 void tap_dance_task(void);
+bool is_tap_dance_pending(void);
 
 void tap_dance_pair_on_each_tap(tap_dance_state_t *state, void *user_data);
 void tap_dance_pair_finished(tap_dance_state_t *state, void *user_data);
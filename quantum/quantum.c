@@ -74,6 +74,10 @@
 #    include "vial.h"
 #endif
 
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITEBACK_ENABLE)
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -180,6 +184,9 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITEBACK_ENABLE)
+    eeprom_driver_flush();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -515,6 +522,10 @@ __attribute__((weak)) bool shutdown_kb(bool jump_to_bootloader) {
 
 void suspend_power_down_quantum(void) {
     suspend_power_down_kb();
+#if defined(EEPROM_WEAR_LEVELING) && defined(WEAR_LEVELING_WRITEBACK_ENABLE)
+    // Power may not come back, don't leave settings only in RAM
+    eeprom_driver_flush();
+#endif
 #ifndef NO_SUSPEND_POWER_DOWN
 // Turn off backlight
 #    ifdef BACKLIGHT_ENABLE
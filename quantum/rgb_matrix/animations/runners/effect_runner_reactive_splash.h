@@ -3,21 +3,49 @@
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 
 typedef HSV (*reactive_splash_f)(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+// How far from a hit an effect can still light up LEDs at the given tick
+typedef uint8_t (*reactive_splash_reach_f)(uint16_t tick);
 
-bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+// Hits are matched against LEDs on a grid of 32x32 cells, 8 cells per axis
+#    define REACTIVE_SPLASH_CELL(coordinate) ((coordinate) >> 5)
+
+// The cells along one axis that lie within reach of a hit
+static uint8_t reactive_splash_cells(uint8_t center, uint8_t reach) {
+    uint8_t first = center > reach ? REACTIVE_SPLASH_CELL(center - reach) : 0;
+    uint8_t last  = center + reach > 255 ? 7 : REACTIVE_SPLASH_CELL(center + reach);
+    return (0xFF << first) & (0xFF >> (7 - last));
+}
+
+bool effect_runner_reactive_splash_reach(uint8_t start, effect_params_t* params, reactive_splash_f effect_func, reactive_splash_reach_f reach_func) {
     RGB_MATRIX_USE_LIMITS(led_min, led_max);
 
-    uint8_t count = g_last_hit_tracker.count;
+    uint8_t  count = g_last_hit_tracker.count;
+    uint16_t tick[LED_HITS_TO_REMEMBER];
+    uint8_t  reach[LED_HITS_TO_REMEMBER];
+    uint8_t  reached[8] = {0}; // for each row of cells, the columns within reach of any hit
+    for (uint8_t j = start; j < count; j++) {
+        tick[j]         = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+        reach[j]        = reach_func ? reach_func(tick[j]) : 255;
+        uint8_t rows    = reactive_splash_cells(g_last_hit_tracker.y[j], reach[j]);
+        uint8_t columns = reactive_splash_cells(g_last_hit_tracker.x[j], reach[j]);
+        for (uint8_t row = 0; row < 8; row++) {
+            if (rows & (1 << row)) reached[row] |= columns;
+        }
+    }
+
     for (uint8_t i = led_min; i < led_max; i++) {
         RGB_MATRIX_TEST_LED_FLAGS();
         HSV hsv = rgb_matrix_config.hsv;
         hsv.v   = 0;
-        for (uint8_t j = start; j < count; j++) {
-            int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
-            int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
-            uint8_t  dist = sqrt16(dx * dx + dy * dy);
-            uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
-            hsv           = effect_func(hsv, dx, dy, dist, tick);
+        if (reached[REACTIVE_SPLASH_CELL(g_led_config.point[i].y)] & (1 << REACTIVE_SPLASH_CELL(g_led_config.point[i].x))) {
+            for (uint8_t j = start; j < count; j++) {
+                int16_t dx = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+                int16_t dy = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+                if (abs(dx) > reach[j] || abs(dy) > reach[j]) continue;
+                uint8_t dist = sqrt16(dx * dx + dy * dy);
+                if (dist > reach[j]) continue;
+                hsv = effect_func(hsv, dx, dy, dist, tick[j]);
+            }
         }
         hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
         RGB rgb = rgb_matrix_hsv_to_rgb(hsv);
@@ -26,4 +54,8 @@ bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, react
     return rgb_matrix_check_finished_leds(led_max);
 }
 
+bool effect_runner_reactive_splash(uint8_t start, effect_params_t* params, reactive_splash_f effect_func) {
+    return effect_runner_reactive_splash_reach(start, params, effect_func, NULL);
+}
+
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
@@ -29,6 +29,10 @@
 
 #include <lib/lib8tion/lib8tion.h>
 
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+#    include "background_worker.h"
+#endif
+
 #ifndef RGB_MATRIX_CENTER
 const led_point_t k_rgb_matrix_center = {112, 32};
 #else
@@ -39,6 +43,56 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+static uint8_t rgb_matrix_calculate_distance(uint8_t index) {
+    int16_t dx = g_led_config.point[index].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[index].y - k_rgb_matrix_center.y;
+    return sqrt16(dx * dx + dy * dy);
+}
+
+static uint8_t rgb_matrix_calculate_angle(uint8_t index) {
+    int16_t dx = g_led_config.point[index].x - k_rgb_matrix_center.x;
+    int16_t dy = g_led_config.point[index].y - k_rgb_matrix_center.y;
+    return atan2_8(dy, dx);
+}
+
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+static struct {
+    bool    valid;
+    uint8_t distance[RGB_MATRIX_LED_COUNT];
+    uint8_t angle[RGB_MATRIX_LED_COUNT];
+} rgb_matrix_geometry;
+
+static void rgb_matrix_update_geometry(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_geometry.distance[i] = rgb_matrix_calculate_distance(i);
+        rgb_matrix_geometry.angle[i]    = rgb_matrix_calculate_angle(i);
+    }
+    rgb_matrix_geometry.valid = true;
+}
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
+uint8_t rgb_matrix_led_distance(uint8_t index) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    if (!rgb_matrix_geometry.valid) {
+        rgb_matrix_update_geometry();
+    }
+    return rgb_matrix_geometry.distance[index];
+#else
+    return rgb_matrix_calculate_distance(index);
+#endif
+}
+
+uint8_t rgb_matrix_led_angle(uint8_t index) {
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    if (!rgb_matrix_geometry.valid) {
+        rgb_matrix_update_geometry();
+    }
+    return rgb_matrix_geometry.angle[index];
+#else
+    return rgb_matrix_calculate_angle(index);
+#endif
+}
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -86,11 +140,20 @@ static uint32_t rgb_timer_buffer;
 static last_hit_t last_hit_buffer;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
 
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+// Effects render into the back buffer. A flush copies it to the front buffer, which the background
+// worker then hands to the driver while the scan loop carries on.
+static RGB rgb_back_buffer[RGB_MATRIX_LED_COUNT];
+static RGB rgb_front_buffer[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_ASYNC_FLUSH
+
 // split rgb matrix
 #if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 const uint8_t k_rgb_matrix_split[2] = RGB_MATRIX_SPLIT;
 #endif
 
+_Static_assert(sizeof(rgb_config_t) == sizeof(uint64_t), "RGB Matrix EECONFIG out of spec.");
+
 EECONFIG_DEBOUNCE_HELPER(rgb_matrix, EECONFIG_RGB_MATRIX, rgb_matrix_config);
 
 void eeconfig_update_rgb_matrix(void) {
@@ -142,6 +205,38 @@ uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *l
     return led_count;
 }
 
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+static void rgb_matrix_flush_front_buffer(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_driver.set_color(i, rgb_front_buffer[i].r, rgb_front_buffer[i].g, rgb_front_buffer[i].b);
+    }
+    rgb_matrix_driver.flush();
+}
+
+static void rgb_matrix_start_flush(void) {
+    background_worker_wait();
+    memcpy(rgb_front_buffer, rgb_back_buffer, sizeof(rgb_front_buffer));
+    background_worker_start(rgb_matrix_flush_front_buffer);
+}
+
+void rgb_matrix_update_pwm_buffers(void) {
+    rgb_matrix_start_flush();
+    background_worker_wait();
+}
+
+void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
+    if (index >= 0 && index < RGB_MATRIX_LED_COUNT) {
+        rgb_back_buffer[index].r = red;
+        rgb_back_buffer[index].g = green;
+        rgb_back_buffer[index].b = blue;
+    }
+}
+
+void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
+        rgb_matrix_set_color(i, red, green, blue);
+}
+#else
 void rgb_matrix_update_pwm_buffers(void) {
     rgb_matrix_driver.flush();
 }
@@ -151,13 +246,14 @@ void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue) {
 }
 
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue) {
-#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
+#    if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
     for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++)
         rgb_matrix_set_color(i, red, green, blue);
-#else
+#    else
     rgb_matrix_driver.set_color_all(red, green, blue);
-#endif
+#    endif
 }
+#endif // RGB_MATRIX_ASYNC_FLUSH
 
 void process_rgb_matrix(uint8_t row, uint8_t col, bool pressed) {
 #ifndef RGB_MATRIX_SPLIT
@@ -357,7 +453,11 @@ static void rgb_task_flush(uint8_t effect) {
     rgb_last_enable = rgb_matrix_config.enable;
 
     // update pwm buffers
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+    rgb_matrix_start_flush();
+#else
     rgb_matrix_update_pwm_buffers();
+#endif // RGB_MATRIX_ASYNC_FLUSH
 
     // next task
     rgb_task_state = SYNCING;
@@ -390,6 +490,10 @@ void rgb_matrix_task(void) {
             }
             break;
         case FLUSHING:
+#ifdef RGB_MATRIX_ASYNC_FLUSH
+            // the previous frame is still on its way out, keep scanning and check again next time
+            if (background_worker_busy()) break;
+#endif // RGB_MATRIX_ASYNC_FLUSH
             rgb_task_flush(effect);
             break;
         case SYNCING:
@@ -492,6 +596,9 @@ void rgb_matrix_set_suspend_state(bool state) {
     if (state && !suspend_state) { // only run if turning off, and only once
         rgb_task_render(0);        // turn off all LEDs when suspending
         rgb_task_flush(0);         // and actually flash led state to LEDs
+#    ifdef RGB_MATRIX_ASYNC_FLUSH
+        background_worker_wait(); // and wait for it to get there
+#    endif
     }
     suspend_state = state;
 #endif
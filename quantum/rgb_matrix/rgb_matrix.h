@@ -107,6 +107,11 @@
 #    define RGB_MATRIX_LED_PROCESS_LIMIT ((RGB_MATRIX_LED_COUNT + 4) / 5)
 #endif
 
+// Keep each LED's distance and angle from the center in RAM instead of working them out every frame
+#if !defined(RGB_MATRIX_GEOMETRY_CACHE) && !defined(__AVR__)
+#    define RGB_MATRIX_GEOMETRY_CACHE
+#endif
+
 struct rgb_matrix_limits_t {
     uint8_t led_min_index;
     uint8_t led_max_index;
@@ -162,6 +167,9 @@ void eeconfig_update_rgb_matrix(void);
 uint8_t rgb_matrix_map_row_column_to_led_kb(uint8_t row, uint8_t column, uint8_t *led_i);
 uint8_t rgb_matrix_map_row_column_to_led(uint8_t row, uint8_t column, uint8_t *led_i);
 
+uint8_t rgb_matrix_led_distance(uint8_t index);
+uint8_t rgb_matrix_led_angle(uint8_t index);
+
 void rgb_matrix_set_color(int index, uint8_t red, uint8_t green, uint8_t blue);
 void rgb_matrix_set_color_all(uint8_t red, uint8_t green, uint8_t blue);
 
@@ -83,5 +83,3 @@ typedef union {
         led_flags_t flags;
     };
 } rgb_config_t;
-
-_Static_assert(sizeof(rgb_config_t) == sizeof(uint64_t), "RGB Matrix EECONFIG out of spec.");
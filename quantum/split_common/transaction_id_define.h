@@ -24,6 +24,15 @@ enum serial_transaction_id {
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
+#ifdef SPLIT_SLAVE_MATRIX_EVENTS
+    GET_SLAVE_MATRIX_EVENTS_NEXT,
+    GET_SLAVE_MATRIX_EVENTS,
+#endif // SPLIT_SLAVE_MATRIX_EVENTS
+
+#ifdef SPLIT_TRANSPORT_AGGREGATE
+    AGGREGATE_FRAME,
+#endif // SPLIT_TRANSPORT_AGGREGATE
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     PUT_MASTER_MATRIX,
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -66,6 +75,10 @@ enum serial_transaction_id {
     PUT_RGB_MATRIX,
 #endif // defined(RGBLIGHT_ENABLE) && defined(RGBLIGHT_SPLIT)
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+    PUT_RGB_MATRIX_DIRECT,
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
     PUT_WPM,
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
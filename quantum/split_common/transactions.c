@@ -80,8 +80,18 @@
     { 0, 0, sizeof_member(split_shared_memory_t, member), offsetof(split_shared_memory_t, member), cb }
 #define trans_target2initiator_initializer(member) trans_target2initiator_initializer_cb(member, NULL)
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#define trans_bidirectional_initializer(initiator2target_member, target2initiator_member) \
+    { sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), NULL }
+
+#ifdef SPLIT_TRANSPORT_AGGREGATE
+static bool aggregate_write(int8_t id, const void *data, size_t length);
+static bool aggregate_read(int8_t id, void *data, size_t length);
+#    define transport_write(id, data, length) aggregate_write(id, data, length)
+#    define transport_read(id, data, length) aggregate_read(id, data, length)
+#else // SPLIT_TRANSPORT_AGGREGATE
+#    define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
+#    define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
+#endif // SPLIT_TRANSPORT_AGGREGATE
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -92,10 +102,13 @@ void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *i
 ////////////////////////////////////////////////////
 // Helpers
 
+static uint32_t retry_count = 0;
+
 static bool transaction_handler_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[], const char *prefix, bool (*handler)(matrix_row_t master_matrix[], matrix_row_t slave_matrix[])) {
     int num_retries = is_transport_connected() ? 10 : 1;
     for (int iter = 1; iter <= num_retries; ++iter) {
         if (iter > 1) {
+            retry_count++;
             for (int i = 0; i < iter * iter; ++i) {
                 wait_us(10);
             }
@@ -173,6 +186,128 @@ inline static bool send_if_data_mismatch(int8_t trans_id, uint32_t *last_update,
 ////////////////////////////////////////////////////
 // Slave matrix
 
+#ifdef SPLIT_SLAVE_MATRIX_EVENTS
+
+#    ifdef SPLIT_TRANSPORT_AGGREGATE
+#        error "SPLIT_SLAVE_MATRIX_EVENTS cannot be combined with SPLIT_TRANSPORT_AGGREGATE"
+#    endif // SPLIT_TRANSPORT_AGGREGATE
+
+_Static_assert(SPLIT_SLAVE_MATRIX_EVENTS_SIZE < 128, "SPLIT_SLAVE_MATRIX_EVENTS_SIZE must leave room for sequence number wraparound");
+_Static_assert(MATRIX_COLS <= 128, "Too many columns for split matrix events");
+
+static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t                  last_update                    = 0;
+    static matrix_row_t              last_matrix[(MATRIX_ROWS) / 2] = {0}; // last known-good matrix, so we can replicate if there are checksum errors
+    static uint8_t                   expected_sequence              = 0;
+    static bool                      needs_resync                   = false;
+    split_slave_matrix_events_sync_t events;
+    matrix_row_t                     temp_matrix[(MATRIX_ROWS) / 2];
+
+    // The acknowledgement goes out with a one byte poll, the slave drops what we have seen on its next scan.
+    // The event queue itself is only fetched when the slave has queued something we haven't seen.
+    uint8_t next_sequence = expected_sequence;
+    bool    okay          = transport_execute_transaction(GET_SLAVE_MATRIX_EVENTS_NEXT, &expected_sequence, sizeof(expected_sequence), &next_sequence, sizeof(next_sequence));
+    if (okay && next_sequence != expected_sequence) {
+        okay = transport_read(GET_SLAVE_MATRIX_EVENTS, &events, sizeof(events));
+        okay &= events.checksum == crc8(&events.payload, sizeof(events.payload));
+    } else {
+        events.payload.sequence = expected_sequence;
+        events.payload.count    = 0;
+    }
+    if (!okay) {
+        // Leave the acknowledgement where it is, so the slave sends the same events again
+        memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+        return false;
+    }
+
+    // Events already applied from an earlier response are skipped. If the slave has dropped events
+    // we never saw, fall back to comparing against its full matrix.
+    uint8_t seen = expected_sequence - events.payload.sequence;
+    if (seen > events.payload.count) {
+        needs_resync = true;
+    } else {
+        for (uint8_t i = seen; i < events.payload.count; i++) {
+            split_slave_matrix_event_t *event = &events.payload.events[i];
+            if (event->row >= (MATRIX_ROWS) / 2) {
+                continue;
+            }
+            if (event->pressed) {
+                split_shmem->smatrix.matrix[event->row] |= (MATRIX_ROW_SHIFTER << event->col);
+            } else {
+                split_shmem->smatrix.matrix[event->row] &= ~(MATRIX_ROW_SHIFTER << event->col);
+            }
+        }
+    }
+    expected_sequence = events.payload.sequence + events.payload.count;
+
+    if (needs_resync || timer_elapsed32(last_update) >= FORCED_SYNC_THROTTLE_MS) {
+        okay = read_if_checksum_mismatch(GET_SLAVE_MATRIX_CHECKSUM, GET_SLAVE_MATRIX_DATA, &last_update, temp_matrix, split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+        if (!okay) {
+            // Don't apply further events on top of a matrix that failed its checksum
+            memcpy(split_shmem->smatrix.matrix, last_matrix, sizeof(last_matrix));
+        }
+        needs_resync = !okay;
+    }
+    if (okay) {
+        memcpy(last_matrix, split_shmem->smatrix.matrix, sizeof(last_matrix));
+    }
+    memcpy(slave_matrix, last_matrix, sizeof(last_matrix));
+    return okay;
+}
+
+static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static matrix_row_t               reported[(MATRIX_ROWS) / 2] = {0};
+    static split_slave_matrix_event_t queue[SPLIT_SLAVE_MATRIX_EVENTS_SIZE];
+    static uint8_t                    queue_sequence = 0;
+    static uint8_t                    queue_count    = 0;
+
+    memcpy(split_shmem->smatrix.matrix, slave_matrix, sizeof(split_shmem->smatrix.matrix));
+    split_shmem->smatrix.checksum = crc8(split_shmem->smatrix.matrix, sizeof(split_shmem->smatrix.matrix));
+
+    // Drop whatever the master has acknowledged
+    uint8_t acked = split_shmem->smatrix_events_ack - queue_sequence;
+    if (acked > 0 && acked <= queue_count) {
+        queue_count -= acked;
+        queue_sequence += acked;
+        memmove(&queue[0], &queue[acked], queue_count * sizeof(split_slave_matrix_event_t));
+    }
+
+    for (uint8_t row = 0; row < (MATRIX_ROWS) / 2; row++) {
+        matrix_row_t changes = reported[row] ^ slave_matrix[row];
+        for (uint8_t col = 0; changes; col++, changes >>= 1) {
+            if (!(changes & 1)) {
+                continue;
+            }
+            // When the master falls behind, the oldest events are dropped and it resyncs from the full matrix
+            if (queue_count == SPLIT_SLAVE_MATRIX_EVENTS_SIZE) {
+                queue_count--;
+                queue_sequence++;
+                memmove(&queue[0], &queue[1], queue_count * sizeof(split_slave_matrix_event_t));
+            }
+            queue[queue_count++] = (split_slave_matrix_event_t){.row = row, .col = col, .pressed = (slave_matrix[row] >> col) & 1};
+        }
+        reported[row] = slave_matrix[row];
+    }
+
+    split_shmem->smatrix_events.payload.sequence = queue_sequence;
+    split_shmem->smatrix_events.payload.count    = queue_count;
+    memcpy(split_shmem->smatrix_events.payload.events, queue, sizeof(queue));
+    split_shmem->smatrix_events.checksum = crc8(&split_shmem->smatrix_events.payload, sizeof(split_shmem->smatrix_events.payload));
+    split_shmem->smatrix_events_next     = queue_sequence + queue_count;
+}
+
+// clang-format off
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+    [GET_SLAVE_MATRIX_CHECKSUM]    = trans_target2initiator_initializer(smatrix.checksum), \
+    [GET_SLAVE_MATRIX_DATA]        = trans_target2initiator_initializer(smatrix.matrix), \
+    [GET_SLAVE_MATRIX_EVENTS_NEXT] = trans_bidirectional_initializer(smatrix_events_ack, smatrix_events_next), \
+    [GET_SLAVE_MATRIX_EVENTS]      = trans_target2initiator_initializer(smatrix_events),
+// clang-format on
+
+#else // SPLIT_SLAVE_MATRIX_EVENTS
+
 static bool slave_matrix_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     static uint32_t     last_update                    = 0;
     static matrix_row_t last_matrix[(MATRIX_ROWS) / 2] = {0}; // last successfully-read matrix, so we can replicate if there are checksum errors
@@ -194,13 +329,15 @@ static void slave_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row
 }
 
 // clang-format off
-#define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
-#define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
+#    define TRANSACTIONS_SLAVE_MATRIX_MASTER() TRANSACTION_HANDLER_MASTER(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(slave_matrix)
+#    define TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS \
     [GET_SLAVE_MATRIX_CHECKSUM] = trans_target2initiator_initializer(smatrix.checksum), \
     [GET_SLAVE_MATRIX_DATA]     = trans_target2initiator_initializer(smatrix.matrix),
 // clang-format on
 
+#endif // SPLIT_SLAVE_MATRIX_EVENTS
+
 ////////////////////////////////////////////////////
 // Master matrix
 
@@ -574,6 +711,178 @@ static void rgb_matrix_handlers_slave(matrix_row_t master_matrix[], matrix_row_t
 
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+
+extern HSV g_direct_mode_colors[RGB_MATRIX_LED_COUNT];
+
+#    define RGB_MATRIX_DIRECT_RUN 0x80
+#    define RGB_MATRIX_DIRECT_MAX_COUNT 0x7F
+
+static void rgb_matrix_direct_range(bool left, uint8_t *first, uint8_t *count) {
+    const uint8_t split[2] = RGB_MATRIX_SPLIT;
+    *first                 = left ? 0 : split[0];
+    *count                 = left ? split[0] : RGB_MATRIX_LED_COUNT - split[0];
+}
+
+static inline bool rgb_matrix_direct_same(const HSV *a, const HSV *b) {
+    return a->h == b->h && a->s == b->s && a->v == b->v;
+}
+
+static HSV     rgb_matrix_direct_shadow[RGB_MATRIX_LED_COUNT];          // colors the slave is known to show
+static uint8_t rgb_matrix_direct_stale[(RGB_MATRIX_LED_COUNT + 7) / 8]; // sent regardless of the shadow
+
+static inline bool rgb_matrix_direct_dirty(uint8_t led) {
+    return (rgb_matrix_direct_stale[led / 8] & (1 << (led % 8))) || !rgb_matrix_direct_same(&g_direct_mode_colors[led], &rgb_matrix_direct_shadow[led]);
+}
+
+// Fills the frame with changed LEDs, starting at the cursor so that a budget too small for
+// everything still gets to every LED in turn. Returns the cursor for the next frame.
+static uint8_t rgb_matrix_direct_encode(uint8_t *data, uint8_t *length, uint8_t first, uint8_t count, uint8_t cursor) {
+    uint8_t index   = cursor < count ? cursor : 0;
+    uint8_t scanned = 0;
+    while (scanned < count && *length + 2 + sizeof(HSV) <= SPLIT_RGB_MATRIX_DIRECT_SIZE) {
+        HSV *colors = &g_direct_mode_colors[first];
+        if (!rgb_matrix_direct_dirty(first + index)) {
+            scanned++;
+            index = index + 1 < count ? index + 1 : 0;
+            continue;
+        }
+
+        uint8_t run = 1;
+        while (run < RGB_MATRIX_DIRECT_MAX_COUNT && index + run < count && rgb_matrix_direct_dirty(first + index + run) && rgb_matrix_direct_same(&colors[index + run], &colors[index])) {
+            run++;
+        }
+        data[(*length)++] = index;
+        if (run > 1) {
+            data[(*length)++] = RGB_MATRIX_DIRECT_RUN | run;
+            memcpy(&data[*length], &colors[index], sizeof(HSV));
+            *length += sizeof(HSV);
+        } else {
+            // Changed LEDs with differing colors go out one after another, up to the next run
+            uint8_t room = (SPLIT_RGB_MATRIX_DIRECT_SIZE - *length - 1) / sizeof(HSV);
+            if (room > RGB_MATRIX_DIRECT_MAX_COUNT) {
+                room = RGB_MATRIX_DIRECT_MAX_COUNT;
+            }
+            while (run < room && index + run < count && rgb_matrix_direct_dirty(first + index + run) && !(index + run + 1 < count && rgb_matrix_direct_same(&colors[index + run], &colors[index + run + 1]))) {
+                run++;
+            }
+            data[(*length)++] = run;
+            memcpy(&data[*length], &colors[index], run * sizeof(HSV));
+            *length += run * sizeof(HSV);
+        }
+
+        scanned += run;
+        index = index + run < count ? index + run : 0;
+    }
+    return index;
+}
+
+// Calls back for every LED a frame sets, LED indices are within the slave half
+static void rgb_matrix_direct_decode(const uint8_t *data, uint8_t length, uint8_t count, void (*apply)(uint8_t index, const HSV *color)) {
+    uint8_t offset = 0;
+    while (offset + 2 <= length) {
+        uint8_t index = data[offset++];
+        uint8_t run   = data[offset] & RGB_MATRIX_DIRECT_RUN;
+        uint8_t leds  = data[offset++] & RGB_MATRIX_DIRECT_MAX_COUNT;
+        if (offset + (run ? 1 : leds) * sizeof(HSV) > length) {
+            return;
+        }
+        for (uint8_t i = 0; i < leds && index + i < count; i++) {
+            apply(index + i, (const HSV *)&data[offset + (run ? 0 : i * sizeof(HSV))]);
+        }
+        offset += (run ? 1 : leds) * sizeof(HSV);
+    }
+}
+
+static uint8_t rgb_matrix_direct_first;
+
+static void rgb_matrix_direct_commit(uint8_t index, const HSV *color) {
+    uint8_t led                   = rgb_matrix_direct_first + index;
+    rgb_matrix_direct_shadow[led] = *color;
+    rgb_matrix_direct_stale[led / 8] &= ~(1 << (led % 8));
+}
+
+static bool rgb_matrix_direct_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint32_t                last_update = 0;
+    static uint8_t                 sequence    = 0;
+    static uint8_t                 cursor      = 0;
+    static uint8_t                 last_resync = 0;
+    static bool                    needs_resync = true;
+    split_rgb_matrix_direct_sync_t frame;
+    uint8_t                        resync;
+    uint8_t                        count;
+
+    rgb_matrix_direct_range(!is_keyboard_left(), &rgb_matrix_direct_first, &count);
+    if (needs_resync) {
+        memset(rgb_matrix_direct_stale, 0xFF, sizeof(rgb_matrix_direct_stale));
+    }
+
+    frame.payload.length = 0;
+    cursor               = rgb_matrix_direct_encode(frame.payload.data, &frame.payload.length, rgb_matrix_direct_first, count, cursor);
+    // Empty frames still go out now and then, to hear about frames the slave missed
+    if (frame.payload.length == 0 && !needs_resync && timer_elapsed32(last_update) < FORCED_SYNC_THROTTLE_MS) {
+        return true;
+    }
+    memset(&frame.payload.data[frame.payload.length], 0, SPLIT_RGB_MATRIX_DIRECT_SIZE - frame.payload.length);
+    frame.payload.sequence = ++sequence;
+    frame.checksum         = crc8(&frame.payload, sizeof(frame.payload));
+
+    bool okay = transport_execute_transaction(PUT_RGB_MATRIX_DIRECT, &frame, sizeof(frame), &resync, sizeof(resync));
+    if (!okay) {
+        // The slave may have restarted, in which case its colors are gone
+        needs_resync = true;
+        return false;
+    }
+
+    rgb_matrix_direct_decode(frame.payload.data, frame.payload.length, count, rgb_matrix_direct_commit);
+    needs_resync = resync != last_resync;
+    last_resync  = resync;
+    last_update  = timer_read32();
+    return true;
+}
+
+static void rgb_matrix_direct_apply(uint8_t index, const HSV *color) {
+    g_direct_mode_colors[rgb_matrix_direct_first + index] = *color;
+}
+
+static void rgb_matrix_direct_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t                 applied = 0;
+    split_rgb_matrix_direct_sync_t frame;
+    uint8_t                        count;
+
+    split_shared_memory_lock();
+    memcpy(&frame, &split_shmem->rgb_matrix_direct, sizeof(frame));
+    split_shared_memory_unlock();
+
+    // A frame that fails its checksum is skipped; if it was corrupt rather than caught halfway
+    // through a transfer, the next one shows up as a gap.
+    if (frame.payload.sequence == applied || frame.checksum != crc8(&frame.payload, sizeof(frame.payload))) {
+        return;
+    }
+    if (frame.payload.sequence != (uint8_t)(applied + 1)) {
+        split_shmem->rgb_matrix_direct_resync++;
+    }
+    applied = frame.payload.sequence;
+
+    rgb_matrix_direct_range(is_keyboard_left(), &rgb_matrix_direct_first, &count);
+    rgb_matrix_direct_decode(frame.payload.data, frame.payload.length, count, rgb_matrix_direct_apply);
+}
+
+// clang-format off
+#    define TRANSACTIONS_RGB_MATRIX_DIRECT_MASTER() TRANSACTION_HANDLER_MASTER(rgb_matrix_direct)
+#    define TRANSACTIONS_RGB_MATRIX_DIRECT_SLAVE() TRANSACTION_HANDLER_SLAVE(rgb_matrix_direct)
+#    define TRANSACTIONS_RGB_MATRIX_DIRECT_REGISTRATIONS \
+    [PUT_RGB_MATRIX_DIRECT] = trans_bidirectional_initializer(rgb_matrix_direct, rgb_matrix_direct_resync),
+// clang-format on
+
+#else // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+
+#    define TRANSACTIONS_RGB_MATRIX_DIRECT_MASTER()
+#    define TRANSACTIONS_RGB_MATRIX_DIRECT_SLAVE()
+#    define TRANSACTIONS_RGB_MATRIX_DIRECT_REGISTRATIONS
+
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+
 ////////////////////////////////////////////////////
 // WPM
 
@@ -884,6 +1193,153 @@ static void detected_os_handlers_slave(matrix_row_t master_matrix[], matrix_row_
 
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+////////////////////////////////////////////////////
+// Aggregated frame
+
+#ifdef SPLIT_TRANSPORT_AGGREGATE
+
+_Static_assert(sizeof(split_aggregate_m2s_t) <= UINT8_MAX && sizeof(split_aggregate_s2m_t) <= UINT8_MAX, "SPLIT_TRANSPORT_AGGREGATE_SIZE too large for a single transaction");
+_Static_assert(NUM_TOTAL_TRANSACTIONS <= 32, "Aggregate frame sections are a uint32_t bitmap of transaction IDs");
+
+static bool                  aggregate_staging = false; // only set while transactions_master() runs
+static uint32_t              aggregate_pending = 0;     // sections staged but not yet delivered
+static split_aggregate_m2s_t aggregate_frame;
+
+static uint8_t aggregate_frame_checksum(const split_aggregate_m2s_t *frame) {
+    return crc8(&frame->payload, offsetof(split_aggregate_m2s_t, payload.data) - offsetof(split_aggregate_m2s_t, payload) + frame->payload.length);
+}
+
+static bool aggregate_write(int8_t id, const void *data, size_t length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (!aggregate_staging || trans->initiator2target_buffer_size > SPLIT_TRANSPORT_AGGREGATE_SIZE) {
+        return transport_execute_transaction(id, data, length, NULL, 0);
+    }
+
+    // Stage the data in shared memory, it is packed into the next frame from there
+    size_t len = trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length;
+    memcpy(split_trans_initiator2target_buffer(trans), data, len);
+    aggregate_pending |= (1UL << id);
+    return true;
+}
+
+static bool aggregate_read(int8_t id, void *data, size_t length) {
+    if (!aggregate_staging) {
+        return transport_execute_transaction(id, NULL, 0, data, length);
+    }
+
+    // Everything the slave sends was received with the frame, and has been unpacked into shared memory
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    size_t                    len   = trans->target2initiator_buffer_size < length ? trans->target2initiator_buffer_size : length;
+    memcpy(data, split_trans_target2initiator_buffer(trans), len);
+    return true;
+}
+
+static void aggregate_frame_pack(void) {
+    uint8_t  length   = 0;
+    uint32_t sections = 0;
+    for (uint32_t pending = aggregate_pending; pending; pending &= pending - 1) {
+        int8_t                    id    = __builtin_ctzl(pending);
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        // Sections that do not fit stay pending for the next frame
+        if (length + trans->initiator2target_buffer_size > SPLIT_TRANSPORT_AGGREGATE_SIZE) {
+            continue;
+        }
+        memcpy(&aggregate_frame.payload.data[length], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+        length += trans->initiator2target_buffer_size;
+        sections |= (1UL << id);
+    }
+
+    aggregate_frame.payload.sections = sections;
+    aggregate_frame.payload.length   = length;
+    aggregate_frame.payload.sequence++;
+    aggregate_frame.checksum = aggregate_frame_checksum(&aggregate_frame);
+}
+
+static bool aggregate_frame_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_aggregate_s2m_t reply;
+    if (!transport_execute_transaction(AGGREGATE_FRAME, &aggregate_frame, offsetof(split_aggregate_m2s_t, payload.data) + aggregate_frame.payload.length, &reply, sizeof(reply))) {
+        return false;
+    }
+    if (reply.checksum != crc8(&reply.payload, sizeof(reply.payload))) {
+        return false;
+    }
+
+    memcpy(&split_shmem->smatrix, &reply.payload.smatrix, sizeof(split_slave_matrix_sync_t));
+#    ifdef ENCODER_ENABLE
+    memcpy(&split_shmem->encoders, &reply.payload.encoders, sizeof(split_slave_encoder_sync_t));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    split_shmem->pointing.checksum = reply.payload.pointing_checksum;
+    memcpy(&split_shmem->pointing.report, &reply.payload.pointing_report, sizeof(report_mouse_t));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+
+    aggregate_pending &= ~aggregate_frame.payload.sections;
+    return true;
+}
+
+static void aggregate_frame_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    static uint8_t        last_sequence = 0;
+    split_aggregate_m2s_t frame;
+
+    split_shared_memory_lock();
+    memcpy(&frame, &split_shmem->aggregate_m2s, sizeof(frame));
+    split_shared_memory_unlock();
+
+    // Retries resend the same frame, only apply it once
+    if (frame.payload.sequence == last_sequence || frame.payload.length > SPLIT_TRANSPORT_AGGREGATE_SIZE) {
+        return;
+    }
+    if (frame.checksum != aggregate_frame_checksum(&frame)) {
+        return;
+    }
+    last_sequence = frame.payload.sequence;
+
+    // Unpack each section to where its own transaction would have written it
+    uint8_t offset = 0;
+    split_shared_memory_lock();
+    for (uint32_t sections = frame.payload.sections; sections; sections &= sections - 1) {
+        int8_t id = __builtin_ctzl(sections);
+        if (id >= NUM_TOTAL_TRANSACTIONS) {
+            break;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        if (offset + trans->initiator2target_buffer_size > frame.payload.length) {
+            break;
+        }
+        memcpy(split_trans_initiator2target_buffer(trans), &frame.payload.data[offset], trans->initiator2target_buffer_size);
+        offset += trans->initiator2target_buffer_size;
+    }
+    split_shared_memory_unlock();
+}
+
+static void aggregate_reply_handlers_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    split_aggregate_s2m_t *reply = &split_shmem->aggregate_s2m;
+    memcpy(&reply->payload.smatrix, &split_shmem->smatrix, sizeof(split_slave_matrix_sync_t));
+#    ifdef ENCODER_ENABLE
+    memcpy(&reply->payload.encoders, &split_shmem->encoders, sizeof(split_slave_encoder_sync_t));
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    reply->payload.pointing_checksum = split_shmem->pointing.checksum;
+    memcpy(&reply->payload.pointing_report, &split_shmem->pointing.report, sizeof(report_mouse_t));
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    reply->checksum = crc8(&reply->payload, sizeof(reply->payload));
+}
+
+// clang-format off
+#    define TRANSACTIONS_AGGREGATE_SLAVE() TRANSACTION_HANDLER_SLAVE(aggregate_frame)
+#    define TRANSACTIONS_AGGREGATE_REPLY_SLAVE() TRANSACTION_HANDLER_SLAVE_AUTOLOCK(aggregate_reply)
+#    define TRANSACTIONS_AGGREGATE_REGISTRATIONS \
+    [AGGREGATE_FRAME] = trans_bidirectional_initializer(aggregate_m2s, aggregate_s2m),
+// clang-format on
+
+#else // SPLIT_TRANSPORT_AGGREGATE
+
+#    define TRANSACTIONS_AGGREGATE_SLAVE()
+#    define TRANSACTIONS_AGGREGATE_REPLY_SLAVE()
+#    define TRANSACTIONS_AGGREGATE_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_AGGREGATE
+
 ////////////////////////////////////////////////////
 
 split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
@@ -896,6 +1352,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 
     // clang-format off
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
+    TRANSACTIONS_AGGREGATE_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
     TRANSACTIONS_SYNC_TIMER_REGISTRATIONS
@@ -906,6 +1363,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
     TRANSACTIONS_RGBLIGHT_REGISTRATIONS
     TRANSACTIONS_LED_MATRIX_REGISTRATIONS
     TRANSACTIONS_RGB_MATRIX_REGISTRATIONS
+    TRANSACTIONS_RGB_MATRIX_DIRECT_REGISTRATIONS
     TRANSACTIONS_WPM_REGISTRATIONS
     TRANSACTIONS_OLED_REGISTRATIONS
     TRANSACTIONS_ST7565_REGISTRATIONS
@@ -924,6 +1382,49 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
+#ifdef SPLIT_TRANSPORT_AGGREGATE
+
+static bool transactions_master_aggregate(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    // Everything sent to the slave is staged first, then goes out in a single frame
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_SYNC_TIMER_MASTER();
+    TRANSACTIONS_LAYER_STATE_MASTER();
+    TRANSACTIONS_LED_STATE_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_BACKLIGHT_MASTER();
+    TRANSACTIONS_RGBLIGHT_MASTER();
+    TRANSACTIONS_LED_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_ST7565_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_HAPTIC_MASTER();
+    TRANSACTIONS_ACTIVITY_MASTER();
+    TRANSACTIONS_DETECTED_OS_MASTER();
+
+    aggregate_frame_pack();
+    TRANSACTION_HANDLER_MASTER(aggregate_frame);
+
+    // Direct colors need the slave's reply, they keep their own transaction
+    TRANSACTIONS_RGB_MATRIX_DIRECT_MASTER();
+
+    // The slave's reply arrived with the frame, these only unpack it
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+    return true;
+}
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    aggregate_staging = true;
+    bool okay         = transactions_master_aggregate(master_matrix, slave_matrix);
+    aggregate_staging = false;
+    return okay;
+}
+
+#else // SPLIT_TRANSPORT_AGGREGATE
+
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
@@ -936,6 +1437,7 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     TRANSACTIONS_RGBLIGHT_MASTER();
     TRANSACTIONS_LED_MATRIX_MASTER();
     TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_DIRECT_MASTER();
     TRANSACTIONS_WPM_MASTER();
     TRANSACTIONS_OLED_MASTER();
     TRANSACTIONS_ST7565_MASTER();
@@ -947,7 +1449,10 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     return true;
 }
 
+#endif // SPLIT_TRANSPORT_AGGREGATE
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_AGGREGATE_SLAVE();
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
     TRANSACTIONS_ENCODERS_SLAVE();
@@ -959,6 +1464,7 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_RGBLIGHT_SLAVE();
     TRANSACTIONS_LED_MATRIX_SLAVE();
     TRANSACTIONS_RGB_MATRIX_SLAVE();
+    TRANSACTIONS_RGB_MATRIX_DIRECT_SLAVE();
     TRANSACTIONS_WPM_SLAVE();
     TRANSACTIONS_OLED_SLAVE();
     TRANSACTIONS_ST7565_SLAVE();
@@ -967,6 +1473,11 @@ void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[
     TRANSACTIONS_HAPTIC_SLAVE();
     TRANSACTIONS_ACTIVITY_SLAVE();
     TRANSACTIONS_DETECTED_OS_SLAVE();
+    TRANSACTIONS_AGGREGATE_REPLY_SLAVE();
+}
+
+uint32_t transactions_master_retries(void) {
+    return retry_count;
 }
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
@@ -57,6 +57,28 @@ typedef struct _split_slave_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
 } split_slave_matrix_sync_t;
 
+#ifdef SPLIT_SLAVE_MATRIX_EVENTS
+// Key changes the slave keeps queued until the master acknowledges them
+#    ifndef SPLIT_SLAVE_MATRIX_EVENTS_SIZE
+#        define SPLIT_SLAVE_MATRIX_EVENTS_SIZE 8
+#    endif // SPLIT_SLAVE_MATRIX_EVENTS_SIZE
+
+typedef struct _split_slave_matrix_event_t {
+    uint8_t row; // row within the slave half
+    uint8_t col : 7;
+    uint8_t pressed : 1;
+} split_slave_matrix_event_t;
+
+typedef struct _split_slave_matrix_events_sync_t {
+    uint8_t checksum;
+    struct {
+        uint8_t                    sequence; // sequence number of events[0]
+        uint8_t                    count;
+        split_slave_matrix_event_t events[SPLIT_SLAVE_MATRIX_EVENTS_SIZE];
+    } payload;
+} split_slave_matrix_events_sync_t;
+#endif // SPLIT_SLAVE_MATRIX_EVENTS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
 typedef struct _split_master_matrix_sync_t {
     matrix_row_t matrix[(MATRIX_ROWS) / 2];
@@ -95,6 +117,25 @@ typedef struct _rgb_matrix_sync_t {
 } rgb_matrix_sync_t;
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+// Bytes of host-driven LED colors sent to the slave per scan, while they are changing
+#    ifndef SPLIT_RGB_MATRIX_DIRECT_SIZE
+#        define SPLIT_RGB_MATRIX_DIRECT_SIZE 32
+#    endif // SPLIT_RGB_MATRIX_DIRECT_SIZE
+
+// Only the slave's LEDs whose colors changed are sent. Each record is the index of its first
+// LED within the slave half, then a count. With the top bit of the count set a single HSV
+// color follows for the whole run, otherwise one color per LED.
+typedef struct _split_rgb_matrix_direct_sync_t {
+    uint8_t checksum;
+    struct {
+        uint8_t sequence;
+        uint8_t length;
+        uint8_t data[SPLIT_RGB_MATRIX_DIRECT_SIZE];
+    } payload;
+} split_rgb_matrix_direct_sync_t;
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+
 #ifdef SPLIT_MODS_ENABLE
 typedef struct _split_mods_sync_t {
     uint8_t real_mods;
@@ -146,6 +187,37 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSPORT_AGGREGATE
+// Bytes of master-to-slave section data carried per frame. Serial transports always send the full frame.
+#    ifndef SPLIT_TRANSPORT_AGGREGATE_SIZE
+#        define SPLIT_TRANSPORT_AGGREGATE_SIZE 32
+#    endif // SPLIT_TRANSPORT_AGGREGATE_SIZE
+
+typedef struct _split_aggregate_m2s_t {
+    uint8_t checksum;
+    struct {
+        uint32_t sections; // bitmap of transaction IDs whose data follows, in ascending ID order
+        uint8_t  sequence;
+        uint8_t  length;
+        uint8_t  data[SPLIT_TRANSPORT_AGGREGATE_SIZE];
+    } payload;
+} split_aggregate_m2s_t;
+
+typedef struct _split_aggregate_s2m_t {
+    uint8_t checksum;
+    struct {
+        split_slave_matrix_sync_t smatrix;
+#    ifdef ENCODER_ENABLE
+        split_slave_encoder_sync_t encoders;
+#    endif // ENCODER_ENABLE
+#    if defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+        uint8_t        pointing_checksum;
+        report_mouse_t pointing_report;
+#    endif // defined(POINTING_DEVICE_ENABLE) && defined(SPLIT_POINTING_ENABLE)
+    } payload;
+} split_aggregate_s2m_t;
+#endif // SPLIT_TRANSPORT_AGGREGATE
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -153,6 +225,12 @@ typedef struct _split_shared_memory_t {
 
     split_slave_matrix_sync_t smatrix;
 
+#ifdef SPLIT_SLAVE_MATRIX_EVENTS
+    split_slave_matrix_events_sync_t smatrix_events;
+    uint8_t                          smatrix_events_ack;  // sequence number of the next event the master expects
+    uint8_t                          smatrix_events_next; // sequence number the slave will give its next event
+#endif // SPLIT_SLAVE_MATRIX_EVENTS
+
 #ifdef SPLIT_TRANSPORT_MIRROR
     split_master_matrix_sync_t mmatrix;
 #endif // SPLIT_TRANSPORT_MIRROR
@@ -193,6 +271,11 @@ typedef struct _split_shared_memory_t {
     rgb_matrix_sync_t rgb_matrix_sync;
 #endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT)
 
+#if defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+    split_rgb_matrix_direct_sync_t rgb_matrix_direct;
+    uint8_t                        rgb_matrix_direct_resync; // bumped by the slave whenever it missed a frame
+#endif // defined(RGB_MATRIX_ENABLE) && defined(RGB_MATRIX_SPLIT) && defined(VIALRGB_ENABLE) && !defined(VIALRGB_NO_DIRECT)
+
 #if defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
     uint8_t current_wpm;
 #endif // defined(WPM_ENABLE) && defined(SPLIT_WPM_ENABLE)
@@ -230,6 +313,11 @@ typedef struct _split_shared_memory_t {
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_TRANSPORT_AGGREGATE
+    split_aggregate_m2s_t aggregate_m2s;
+    split_aggregate_s2m_t aggregate_s2m;
+#endif // SPLIT_TRANSPORT_AGGREGATE
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
@@ -0,0 +1,95 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "task_profiling.h"
+
+#include <string.h>
+#include "debug.h"
+#include "print.h"
+#include "timer.h"
+
+static uint16_t task_histogram[PROFILED_TASK_COUNT][TASK_PROFILING_BUCKETS];
+static uint32_t task_worst[PROFILED_TASK_COUNT];
+
+static const char *const task_names[PROFILED_TASK_COUNT] = {
+    [PROFILED_TASK_KEYBOARD]        = "keyboard_task",
+    [PROFILED_TASK_MATRIX]          = "matrix_task",
+    [PROFILED_TASK_QUANTUM]         = "quantum_task",
+    [PROFILED_TASK_KEY_OVERRIDE]    = "key_override_task",
+    [PROFILED_TASK_TAP_DANCE]       = "tap_dance_task",
+    [PROFILED_TASK_COMBO]           = "combo_task",
+    [PROFILED_TASK_LEADER]          = "leader_task",
+    [PROFILED_TASK_AUTO_SHIFT]      = "autoshift_matrix_scan",
+    [PROFILED_TASK_CAPS_WORD]       = "caps_word_task",
+    [PROFILED_TASK_RGBLIGHT]        = "rgblight_task",
+    [PROFILED_TASK_LED_MATRIX]      = "led_matrix_task",
+    [PROFILED_TASK_RGB_MATRIX]      = "rgb_matrix_task",
+    [PROFILED_TASK_ENCODER]         = "encoder_read",
+    [PROFILED_TASK_POINTING_DEVICE] = "pointing_device_task",
+    [PROFILED_TASK_OLED]            = "oled_task",
+    [PROFILED_TASK_HOUSEKEEPING]    = "housekeeping_task",
+};
+
+static uint8_t task_profiling_bucket(uint32_t ticks) {
+    uint8_t bucket = 0;
+    while (ticks != 0 && bucket < TASK_PROFILING_BUCKETS - 1) {
+        ticks >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void task_profiling_record(profiled_task_t task, uint32_t ticks) {
+    uint16_t *count = &task_histogram[task][task_profiling_bucket(ticks)];
+    if (*count != UINT16_MAX) {
+        (*count)++;
+    }
+    if (ticks > task_worst[task]) {
+        task_worst[task] = ticks;
+    }
+}
+
+void task_profiling_reset(void) {
+    memset(task_histogram, 0, sizeof(task_histogram));
+    memset(task_worst, 0, sizeof(task_worst));
+}
+
+uint32_t task_profiling_get_worst(profiled_task_t task) {
+    return task < PROFILED_TASK_COUNT ? task_worst[task] : 0;
+}
+
+uint16_t task_profiling_get_bucket(profiled_task_t task, uint8_t bucket) {
+    return task < PROFILED_TASK_COUNT && bucket < TASK_PROFILING_BUCKETS ? task_histogram[task][bucket] : 0;
+}
+
+const char *task_profiling_get_name(profiled_task_t task) {
+    return task < PROFILED_TASK_COUNT ? task_names[task] : "";
+}
+
+void task_profiling_print(void) {
+    for (uint8_t task = 0; task < PROFILED_TASK_COUNT; task++) {
+        uint8_t last = TASK_PROFILING_BUCKETS;
+        while (last > 0 && task_histogram[task][last - 1] == 0) {
+            last--;
+        }
+        // Tasks that are not compiled in never record anything
+        if (last == 0) {
+            continue;
+        }
+        dprintf("%s: worst %lu, histogram", task_names[task], (unsigned long)task_worst[task]);
+        for (uint8_t bucket = 0; bucket < last; bucket++) {
+            dprintf(" %u", task_histogram[task][bucket]);
+        }
+        dprint("\n");
+    }
+}
+
+void task_profiling_task(void) {
+#if TASK_PROFILING_PRINT_INTERVAL > 0
+    static uint32_t last_print = 0;
+    if (timer_elapsed32(last_print) >= TASK_PROFILING_PRINT_INTERVAL) {
+        last_print = timer_read32();
+        task_profiling_print();
+    }
+#endif
+}
@@ -0,0 +1,86 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+/*
+    Per-task timing histograms for the main loop, enabled with `TASK_PROFILING_ENABLE = yes`.
+
+    Every instrumented call is timed and counted into a log2 bucket: bucket 0 holds calls that
+    took 0 ticks, bucket n holds calls that took [2^(n-1), 2^n) ticks, and the last bucket also
+    holds everything longer. The worst case is tracked separately. On AVR a tick is one count of
+    timer 0, extended past its 1ms wrap by timer_read_raw32(). Elsewhere ticks are whatever the
+    basic_profiling.h TIMESTAMP_GETTER counts (CPU cycles on ChibiOS).
+
+    Usage example:
+
+        #include "task_profiling.h"
+
+        PROFILE_TASK(PROFILED_TASK_COMBO, combo_task());
+*/
+
+#include <stdint.h>
+#include <stdbool.h>
+
+typedef enum {
+    PROFILED_TASK_KEYBOARD,
+    PROFILED_TASK_MATRIX,
+    PROFILED_TASK_QUANTUM,
+    PROFILED_TASK_KEY_OVERRIDE,
+    PROFILED_TASK_TAP_DANCE,
+    PROFILED_TASK_COMBO,
+    PROFILED_TASK_LEADER,
+    PROFILED_TASK_AUTO_SHIFT,
+    PROFILED_TASK_CAPS_WORD,
+    PROFILED_TASK_RGBLIGHT,
+    PROFILED_TASK_LED_MATRIX,
+    PROFILED_TASK_RGB_MATRIX,
+    PROFILED_TASK_ENCODER,
+    PROFILED_TASK_POINTING_DEVICE,
+    PROFILED_TASK_OLED,
+    PROFILED_TASK_HOUSEKEEPING,
+    PROFILED_TASK_COUNT,
+} profiled_task_t;
+
+#ifndef TASK_PROFILING_BUCKETS
+#    define TASK_PROFILING_BUCKETS 24
+#endif
+
+// Interval between histogram dumps on the console, 0 to disable
+#ifndef TASK_PROFILING_PRINT_INTERVAL
+#    define TASK_PROFILING_PRINT_INTERVAL 10000
+#endif
+
+#ifdef TASK_PROFILING_ENABLE
+#    include "platform_deps.h"
+#    include "timer.h"
+#    ifdef __AVR__
+// TCNT0 wraps every millisecond, so it can't time anything longer on its own
+#        include "timer_avr.h"
+#        define TASK_PROFILING_TIMESTAMP() timer_read_raw32()
+#    else
+#        include "basic_profiling.h"
+#        define TASK_PROFILING_TIMESTAMP() (TIMESTAMP_GETTER)
+#    endif
+
+#    define PROFILE_TASK(task, call)                                                                           \
+        do {                                                                                                   \
+            uint32_t profile_start_ts = TASK_PROFILING_TIMESTAMP();                                            \
+            do {                                                                                               \
+                call;                                                                                          \
+            } while (0);                                                                                       \
+            task_profiling_record((task), TASK_PROFILING_TIMESTAMP() - profile_start_ts);                      \
+        } while (0)
+
+void        task_profiling_record(profiled_task_t task, uint32_t ticks);
+void        task_profiling_reset(void);
+uint32_t    task_profiling_get_worst(profiled_task_t task);
+uint16_t    task_profiling_get_bucket(profiled_task_t task, uint8_t bucket);
+const char *task_profiling_get_name(profiled_task_t task);
+void        task_profiling_print(void);
+void        task_profiling_task(void);
+#else
+#    define PROFILE_TASK(task, call) \
+        do {                         \
+            call;                    \
+        } while (0)
+#endif
@@ -20,6 +20,9 @@
 
 #include "dynamic_keymap.h"
 #include "quantum.h"
+#include "raw_hid.h"
+#include "crc.h"
+#include "task_profiling.h"
 #include "vial_generated_keyboard_definition.h"
 
 #include "vial_ensure_keycode.h"
@@ -76,6 +79,179 @@ __attribute__((unused)) static uint16_t vial_keycode_firewall(uint16_t in) {
     return in;
 }
 
+/* Snapshot transfer, see vial.h for the stream and packet layout */
+#define VIAL_SNAPSHOT_READ_PAYLOAD (VIAL_RAW_EPSIZE - 4)
+#define VIAL_SNAPSHOT_WRITE_PAYLOAD (VIAL_RAW_EPSIZE - 7)
+#define VIAL_SNAPSHOT_WINDOW 64
+
+typedef struct {
+    uint8_t packet[VIAL_RAW_EPSIZE];
+    uint16_t seq;
+    uint8_t length;
+} vial_snapshot_tx_t;
+
+static void vial_snapshot_tx_seal(vial_snapshot_tx_t *tx, bool last) {
+    memset(&tx->packet[3 + tx->length], 0, VIAL_SNAPSHOT_READ_PAYLOAD - tx->length);
+    tx->packet[0] = tx->seq & 0xFF;
+    tx->packet[1] = tx->seq >> 8;
+    tx->packet[2] = tx->length | (last ? VIAL_SNAPSHOT_LAST : 0);
+    tx->packet[VIAL_RAW_EPSIZE - 1] = crc8(tx->packet, VIAL_RAW_EPSIZE - 1);
+}
+
+static void vial_snapshot_tx_put(vial_snapshot_tx_t *tx, uint8_t byte) {
+    if (tx->length == VIAL_SNAPSHOT_READ_PAYLOAD) {
+        vial_snapshot_tx_seal(tx, false);
+        raw_hid_send(tx->packet, VIAL_RAW_EPSIZE);
+        tx->seq++;
+        tx->length = 0;
+    }
+    tx->packet[3 + tx->length++] = byte;
+}
+
+/* Words go out in the byte order they are stored in */
+static void vial_snapshot_tx_put_word(vial_snapshot_tx_t *tx, const uint16_t *word) {
+    const uint8_t *bytes = (const uint8_t *)word;
+    vial_snapshot_tx_put(tx, bytes[0]);
+    vial_snapshot_tx_put(tx, bytes[1]);
+}
+
+/* Streams the encoded snapshot; the final packet is left in msg for the regular reply */
+static void vial_snapshot_send(uint8_t *msg) {
+    vial_snapshot_tx_t tx = { 0 };
+    uint16_t window[VIAL_SNAPSHOT_WINDOW];
+    uint16_t size = dynamic_keymap_get_state_buffer_size();
+    uint16_t words = (size + 1) / 2;
+    uint16_t window_start = 0, window_end = 0;
+
+    vial_snapshot_tx_put(&tx, size & 0xFF);
+    vial_snapshot_tx_put(&tx, size >> 8);
+
+    for (uint16_t pos = 0; pos < words;) {
+        /* keep at least half a window of lookahead; an odd trailing byte is padded with zero */
+        if (window_end - pos < VIAL_SNAPSHOT_WINDOW / 2 && window_end < words) {
+            window_start = pos;
+            window_end = pos + MIN(words - pos, VIAL_SNAPSHOT_WINDOW);
+            dynamic_keymap_get_state_buffer(window_start * 2, (window_end - window_start) * 2, (uint8_t *)window);
+        }
+        const uint16_t *data = &window[pos - window_start];
+        uint8_t avail = window_end - pos;
+
+        uint8_t run = 1;
+        while (run < avail && data[run] == data[0])
+            ++run;
+        if (run >= 2) {
+            vial_snapshot_tx_put(&tx, 0x80 | (run - 2));
+            vial_snapshot_tx_put_word(&tx, &data[0]);
+            pos += run;
+            continue;
+        }
+
+        /* literal words up to the next run of two */
+        uint8_t count = 1;
+        while (count < avail && !(count + 1 < avail && data[count] == data[count + 1]))
+            ++count;
+        vial_snapshot_tx_put(&tx, count - 1);
+        for (uint8_t i = 0; i < count; ++i)
+            vial_snapshot_tx_put_word(&tx, &data[i]);
+        pos += count;
+    }
+
+    vial_snapshot_tx_seal(&tx, true);
+    memcpy(msg, tx.packet, VIAL_RAW_EPSIZE);
+}
+
+#if VIAL_SNAPSHOT_BUFFER_SIZE > 0
+enum {
+    vial_snapshot_idle,
+    vial_snapshot_receiving,
+    vial_snapshot_received,
+};
+
+static uint8_t vial_snapshot_buffer[VIAL_SNAPSHOT_BUFFER_SIZE];
+static uint16_t vial_snapshot_length;
+static uint16_t vial_snapshot_seq;
+static uint8_t vial_snapshot_state = vial_snapshot_idle;
+
+static bool vial_snapshot_receive(const uint8_t *msg) {
+    uint16_t seq = msg[3] | (msg[4] << 8);
+    uint8_t count = msg[5] & ~VIAL_SNAPSHOT_LAST;
+
+    if (vial_snapshot_state != vial_snapshot_receiving
+            || crc8(msg, VIAL_RAW_EPSIZE - 1) != msg[VIAL_RAW_EPSIZE - 1]
+            || seq != vial_snapshot_seq
+            || count > VIAL_SNAPSHOT_WRITE_PAYLOAD
+            || count > sizeof(vial_snapshot_buffer) - vial_snapshot_length)
+        return false;
+
+    memcpy(&vial_snapshot_buffer[vial_snapshot_length], &msg[6], count);
+    vial_snapshot_length += count;
+    vial_snapshot_seq++;
+    if (msg[5] & VIAL_SNAPSHOT_LAST)
+        vial_snapshot_state = vial_snapshot_received;
+    return true;
+}
+
+/* Decodes the staged stream, writing it to EEPROM when apply is set.
+   Returns false unless the stream decodes to exactly one snapshot. */
+static bool vial_snapshot_decode(bool apply) {
+    uint8_t *in = vial_snapshot_buffer;
+    uint8_t *end = vial_snapshot_buffer + vial_snapshot_length;
+    uint16_t size = dynamic_keymap_get_state_buffer_size();
+    uint16_t words = (size + 1) / 2;
+    uint16_t pos = 0;
+
+    if (vial_snapshot_length < 2 || (in[0] | (in[1] << 8)) != size)
+        return false;
+    in += 2;
+
+    /* the state buffer drops the padding of an odd trailing byte */
+    while (in < end) {
+        uint8_t token = *in++;
+        if (token & 0x80) {
+            uint8_t count = (token & 0x7F) + 2;
+            if (end - in < 2 || count > words - pos)
+                return false;
+            if (apply) {
+                uint8_t fill[16];
+                for (uint8_t i = 0; i < sizeof(fill); i += 2) {
+                    fill[i] = in[0];
+                    fill[i + 1] = in[1];
+                }
+                for (uint8_t done = 0; done < count; done += sizeof(fill) / 2)
+                    dynamic_keymap_set_state_buffer((pos + done) * 2, MIN(count - done, sizeof(fill) / 2) * 2, fill);
+            }
+            in += 2;
+            pos += count;
+        } else {
+            uint8_t count = token + 1;
+            if (count * 2 > end - in || count > words - pos)
+                return false;
+            if (apply)
+                dynamic_keymap_set_state_buffer(pos * 2, count * 2, in);
+            in += count * 2;
+            pos += count;
+        }
+    }
+
+    return pos == words;
+}
+
+static bool vial_snapshot_commit(void) {
+    bool valid = vial_snapshot_state == vial_snapshot_received && vial_snapshot_decode(false);
+    vial_snapshot_state = vial_snapshot_idle;
+    if (!valid)
+        return false;
+
+    vial_snapshot_decode(true);
+    dynamic_keymap_init();
+#ifdef QMK_SETTINGS
+    qmk_settings_init();
+#endif
+    vial_init();
+    return true;
+}
+#endif
+
 void vial_handle_cmd(uint8_t *msg, uint8_t length) {
     /* All packets must be fixed 32 bytes */
     if (length != VIAL_RAW_EPSIZE)
@@ -287,6 +463,74 @@ void vial_handle_cmd(uint8_t *msg, uint8_t length) {
 
             break;
         }
+        case vial_snapshot_op: {
+            switch (msg[2]) {
+            case vial_snapshot_read: {
+                vial_snapshot_send(msg);
+                break;
+            }
+#if VIAL_SNAPSHOT_BUFFER_SIZE > 0
+            /* Until keyboard is unlocked, don't allow replacing the keymap */
+            case vial_snapshot_write_begin: {
+                vial_snapshot_length = 0;
+                vial_snapshot_seq = 0;
+                vial_snapshot_state = vial_unlocked ? vial_snapshot_receiving : vial_snapshot_idle;
+                memset(msg, 0, length);
+                msg[0] = vial_unlocked ? 0 : 1;
+                break;
+            }
+            case vial_snapshot_write_data: {
+                bool ok = vial_unlocked && vial_snapshot_receive(msg);
+                if (!ok)
+                    vial_snapshot_state = vial_snapshot_idle;
+                memset(msg, 0, length);
+                msg[0] = ok ? 0 : 1;
+                break;
+            }
+            case vial_snapshot_write_commit: {
+                bool ok = vial_unlocked && vial_snapshot_commit();
+                memset(msg, 0, length);
+                msg[0] = ok ? 0 : 1;
+                break;
+            }
+#endif
+            }
+
+            break;
+        }
+        case vial_task_profiling_op: {
+            __attribute__((unused)) uint8_t task = msg[3];
+            __attribute__((unused)) uint8_t first_bucket = msg[4];
+            uint8_t op = msg[2];
+            memset(msg, 0, length);
+#ifdef TASK_PROFILING_ENABLE
+            switch (op) {
+            case vial_task_profiling_get_info: {
+                msg[0] = PROFILED_TASK_COUNT;
+                msg[1] = TASK_PROFILING_BUCKETS;
+                break;
+            }
+            case vial_task_profiling_get: {
+                uint32_t worst = task_profiling_get_worst(task);
+                for (uint8_t i = 0; i < 4; ++i)
+                    msg[i] = worst >> (8 * i);
+                for (uint8_t i = 0; 4 + 2 * i < length; ++i) {
+                    uint16_t count = task_profiling_get_bucket(task, first_bucket + i);
+                    msg[4 + 2 * i] = count & 0xFF;
+                    msg[5 + 2 * i] = count >> 8;
+                }
+                break;
+            }
+            case vial_task_profiling_reset: {
+                task_profiling_reset();
+                break;
+            }
+            }
+#else
+            (void)op;
+#endif
+            break;
+        }
     }
 }
 
@@ -339,7 +583,8 @@ enum {
 };
 
 static uint8_t dance_state[VIAL_TAP_DANCE_ENTRIES];
-static vial_tap_dance_entry_t td_entry;
+/* RAM copy of the tap dance entries, so the tap dance path never waits on EEPROM */
+static vial_tap_dance_entry_t td_entries[VIAL_TAP_DANCE_ENTRIES];
 
 static uint8_t dance_step(tap_dance_state_t *state) {
     if (state->count == 1) {
@@ -355,9 +600,8 @@ static uint8_t dance_step(tap_dance_state_t *state) {
 
 static void on_dance(tap_dance_state_t *state, void *user_data) {
     uint8_t index = (uintptr_t)user_data;
-    if (dynamic_keymap_get_tap_dance(index, &td_entry) != 0)
-        return;
-    uint16_t kc = td_entry.on_tap;
+    const vial_tap_dance_entry_t *td_entry = &td_entries[index];
+    uint16_t kc = td_entry->on_tap;
     if (kc) {
         if (state->count == 3) {
             vial_keycode_tap(kc);
@@ -371,51 +615,50 @@ static void on_dance(tap_dance_state_t *state, void *user_data) {
 
 static void on_dance_finished(tap_dance_state_t *state, void *user_data) {
     uint8_t index = (uintptr_t)user_data;
-    if (dynamic_keymap_get_tap_dance(index, &td_entry) != 0)
-        return;
+    const vial_tap_dance_entry_t *td_entry = &td_entries[index];
     dance_state[index] = dance_step(state);
     switch (dance_state[index]) {
         case SINGLE_TAP: {
-            if (td_entry.on_tap)
-                vial_keycode_down(td_entry.on_tap);
+            if (td_entry->on_tap)
+                vial_keycode_down(td_entry->on_tap);
             break;
         }
         case SINGLE_HOLD: {
-            if (td_entry.on_hold)
-                vial_keycode_down(td_entry.on_hold);
-            else if (td_entry.on_tap)
-                vial_keycode_down(td_entry.on_tap);
+            if (td_entry->on_hold)
+                vial_keycode_down(td_entry->on_hold);
+            else if (td_entry->on_tap)
+                vial_keycode_down(td_entry->on_tap);
             break;
         }
         case DOUBLE_TAP: {
-            if (td_entry.on_double_tap) {
-                vial_keycode_down(td_entry.on_double_tap);
-            } else if (td_entry.on_tap) {
-                vial_keycode_tap(td_entry.on_tap);
-                vial_keycode_down(td_entry.on_tap);
+            if (td_entry->on_double_tap) {
+                vial_keycode_down(td_entry->on_double_tap);
+            } else if (td_entry->on_tap) {
+                vial_keycode_tap(td_entry->on_tap);
+                vial_keycode_down(td_entry->on_tap);
             }
             break;
         }
         case DOUBLE_HOLD: {
-            if (td_entry.on_tap_hold) {
-                vial_keycode_down(td_entry.on_tap_hold);
+            if (td_entry->on_tap_hold) {
+                vial_keycode_down(td_entry->on_tap_hold);
             } else {
-                if (td_entry.on_tap) {
-                    vial_keycode_tap(td_entry.on_tap);
-                    if (td_entry.on_hold)
-                        vial_keycode_down(td_entry.on_hold);
+                if (td_entry->on_tap) {
+                    vial_keycode_tap(td_entry->on_tap);
+                    if (td_entry->on_hold)
+                        vial_keycode_down(td_entry->on_hold);
                     else
-                        vial_keycode_down(td_entry.on_tap);
-                } else if (td_entry.on_hold) {
-                    vial_keycode_down(td_entry.on_hold);
+                        vial_keycode_down(td_entry->on_tap);
+                } else if (td_entry->on_hold) {
+                    vial_keycode_down(td_entry->on_hold);
                 }
             }
             break;
         }
         case DOUBLE_SINGLE_TAP: {
-            if (td_entry.on_tap) {
-                vial_keycode_tap(td_entry.on_tap);
-                vial_keycode_down(td_entry.on_tap);
+            if (td_entry->on_tap) {
+                vial_keycode_tap(td_entry->on_tap);
+                vial_keycode_down(td_entry->on_tap);
             }
             break;
         }
@@ -424,51 +667,50 @@ static void on_dance_finished(tap_dance_state_t *state, void *user_data) {
 
 static void on_dance_reset(tap_dance_state_t *state, void *user_data) {
     uint8_t index = (uintptr_t)user_data;
-    if (dynamic_keymap_get_tap_dance(index, &td_entry) != 0)
-        return;
+    const vial_tap_dance_entry_t *td_entry = &td_entries[index];
     qs_wait_ms(QS_tap_code_delay);
     uint8_t st = dance_state[index];
     state->count = 0;
     dance_state[index] = 0;
     switch (st) {
         case SINGLE_TAP: {
-            if (td_entry.on_tap)
-                vial_keycode_up(td_entry.on_tap);
+            if (td_entry->on_tap)
+                vial_keycode_up(td_entry->on_tap);
             break;
         }
         case SINGLE_HOLD: {
-            if (td_entry.on_hold)
-                vial_keycode_up(td_entry.on_hold);
-            else if (td_entry.on_tap)
-                vial_keycode_up(td_entry.on_tap);
+            if (td_entry->on_hold)
+                vial_keycode_up(td_entry->on_hold);
+            else if (td_entry->on_tap)
+                vial_keycode_up(td_entry->on_tap);
             break;
         }
         case DOUBLE_TAP: {
-            if (td_entry.on_double_tap) {
-                vial_keycode_up(td_entry.on_double_tap);
-            } else if (td_entry.on_tap) {
-                vial_keycode_up(td_entry.on_tap);
+            if (td_entry->on_double_tap) {
+                vial_keycode_up(td_entry->on_double_tap);
+            } else if (td_entry->on_tap) {
+                vial_keycode_up(td_entry->on_tap);
             }
             break;
         }
         case DOUBLE_HOLD: {
-            if (td_entry.on_tap_hold) {
-                vial_keycode_up(td_entry.on_tap_hold);
+            if (td_entry->on_tap_hold) {
+                vial_keycode_up(td_entry->on_tap_hold);
             } else {
-                if (td_entry.on_tap) {
-                    if (td_entry.on_hold)
-                        vial_keycode_up(td_entry.on_hold);
+                if (td_entry->on_tap) {
+                    if (td_entry->on_hold)
+                        vial_keycode_up(td_entry->on_hold);
                     else
-                        vial_keycode_up(td_entry.on_tap);
-                } else if (td_entry.on_hold) {
-                    vial_keycode_up(td_entry.on_hold);
+                        vial_keycode_up(td_entry->on_tap);
+                } else if (td_entry->on_hold) {
+                    vial_keycode_up(td_entry->on_hold);
                 }
             }
             break;
         }
         case DOUBLE_SINGLE_TAP: {
-            if (td_entry.on_tap) {
-                vial_keycode_up(td_entry.on_tap);
+            if (td_entry->on_tap) {
+                vial_keycode_up(td_entry->on_tap);
             }
             break;
         }
@@ -477,9 +719,11 @@ static void on_dance_reset(tap_dance_state_t *state, void *user_data) {
 
 tap_dance_action_t tap_dance_actions[VIAL_TAP_DANCE_ENTRIES] = { };
 
-/* Load timings from eeprom into custom_tapping_term */
+/* Load entries, including their custom_tapping_term, from eeprom */
 static void reload_tap_dance(void) {
     for (size_t i = 0; i < VIAL_TAP_DANCE_ENTRIES; ++i) {
+        if (dynamic_keymap_get_tap_dance(i, &td_entries[i]) != 0)
+            memset(&td_entries[i], 0, sizeof(td_entries[i]));
         tap_dance_actions[i].fn.on_each_tap = on_dance;
         tap_dance_actions[i].fn.on_dance_finished = on_dance_finished;
         tap_dance_actions[i].fn.on_reset = on_dance_reset;
@@ -492,9 +736,9 @@ static void reload_tap_dance(void) {
 uint16_t get_tapping_term(uint16_t keycode, keyrecord_t *record) {
 #ifdef VIAL_TAP_DANCE_ENABLE
     if (keycode >= QK_TAP_DANCE && keycode <= QK_TAP_DANCE_MAX) {
-        vial_tap_dance_entry_t td;
-        if (dynamic_keymap_get_tap_dance(keycode & 0xFF, &td) == 0)
-            return td.custom_tapping_term;
+        uint8_t idx = keycode & 0xFF;
+        if (idx < VIAL_TAP_DANCE_ENTRIES)
+            return td_entries[idx].custom_tapping_term;
     }
 #endif
 #ifdef QMK_SETTINGS
@@ -525,6 +769,8 @@ static void reload_combo(void) {
             key_combos[i].keycode = entry.output;
         }
     }
+
+    combo_index_rebuild();
 }
 #endif
 
@@ -537,17 +783,18 @@ bool process_record_vial(uint16_t keycode, keyrecord_t *record) {
     /* process releases before tap-dance timeout arrives */
     if (!record->event.pressed && keycode >= QK_TAP_DANCE && keycode <= QK_TAP_DANCE_MAX) {
         uint16_t idx = keycode - QK_TAP_DANCE;
-        if (dynamic_keymap_get_tap_dance(idx, &td_entry) != 0)
+        if (idx >= VIAL_TAP_DANCE_ENTRIES)
             return true;
 
+        const vial_tap_dance_entry_t *td_entry = &td_entries[idx];
         tap_dance_action_t *action = &tap_dance_actions[idx];
 
         /* only care about 2 possibilities here
            - tap and hold set, everything else unset: process first release early (count == 1)
            - double tap set: process second release early (count == 2)
          */
-        if ((action->state.count == 1 && td_entry.on_tap && td_entry.on_hold && !td_entry.on_double_tap && !td_entry.on_tap_hold)
-            || (action->state.count == 2 && td_entry.on_double_tap)) {
+        if ((action->state.count == 1 && td_entry->on_tap && td_entry->on_hold && !td_entry->on_double_tap && !td_entry->on_tap_hold)
+            || (action->state.count == 2 && td_entry->on_double_tap)) {
                 action->state.pressed = false;
                 process_tap_dance_action_on_dance_finished(action);
                 /* reset_tap_dance() will get called in process_tap_dance() */
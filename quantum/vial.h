@@ -48,6 +48,8 @@ enum {
     vial_qmk_settings_set = 0x0B,
     vial_qmk_settings_reset = 0x0C,
     vial_dynamic_entry_op = 0x0D,  /* operate on tapdance, combos, etc */
+    vial_snapshot_op = 0x0E,       /* bulk transfer of all dynamic keymap state */
+    vial_task_profiling_op = 0x0F, /* main loop timing histograms, see task_profiling.h */
 };
 
 enum {
@@ -60,6 +62,51 @@ enum {
     dynamic_vial_key_override_set = 0x06,
 };
 
+enum {
+    vial_snapshot_read = 0x00,
+    vial_snapshot_write_begin = 0x01,
+    vial_snapshot_write_data = 0x02,
+    vial_snapshot_write_commit = 0x03,
+};
+
+/* A snapshot is the whole dynamic keymap EEPROM area (keymap, encoders, QMK settings,
+   tap dance, combos, key overrides and macros), read as 16-bit words in stored byte order
+   so that runs of the same keycode compress, with an odd trailing byte padded by zero.
+   It is run-length encoded as a little-endian uint16 uncompressed size in bytes followed
+   by tokens:
+     0x00..0x7F -- (token + 1) literal words follow
+     0x80..0xFF -- the next word is repeated ((token & 0x7F) + 2) times
+
+   vial_snapshot_read answers with consecutive packets, all but the last one sent ahead
+   of the normal reply:
+     [0..1] sequence number, [2] payload length | VIAL_SNAPSHOT_LAST, [3..30] payload,
+     [31] crc8 of bytes 0..30
+
+   vial_snapshot_write_data carries the same fields after the command bytes:
+     [0..2] 0xFE 0x0E 0x02, [3..4] sequence number, [5] payload length | VIAL_SNAPSHOT_LAST,
+     [6..30] payload, [31] crc8 of bytes 0..30
+
+   Written data is staged in RAM and only applied by vial_snapshot_write_commit once the
+   whole stream has arrived in order and decodes to exactly one snapshot. A stream that
+   does not fit VIAL_SNAPSHOT_BUFFER_SIZE is rejected, leaving the buffer commands. */
+#define VIAL_SNAPSHOT_LAST 0x80
+
+enum {
+    vial_task_profiling_get_info = 0x00, /* reply: [0] task count, [1] bucket count; zero when disabled */
+    vial_task_profiling_get = 0x01,      /* [3] task, [4] first bucket; reply: [0..3] worst, [4..31] 14 buckets */
+    vial_task_profiling_reset = 0x02,
+};
+
+/* Room for the keymap even if it doesn't compress at all, with the remaining sections
+   (mostly empty tap dance, combo, key override and macro slots) compressing into the rest */
+#ifndef VIAL_SNAPSHOT_BUFFER_SIZE
+#    ifdef __AVR__
+#        define VIAL_SNAPSHOT_BUFFER_SIZE 0
+#    else
+#        define VIAL_SNAPSHOT_BUFFER_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2 + 512)
+#    endif
+#endif
+
 #define VIAL_MACRO_EXT_TAP 5
 #define VIAL_MACRO_EXT_DOWN 6
 #define VIAL_MACRO_EXT_UP 7
@@ -23,6 +23,7 @@ void MockBackingStore::reset_instance() {
     backing_erase_invoke_count  = 0;
     backing_write_invoke_count  = 0;
     backing_lock_invoke_count   = 0;
+    backing_read_invoke_count   = 0;
 
     init_success_callback   = [](std::uint64_t) { return true; };
     erase_success_callback  = [](std::uint64_t) { return true; };
@@ -75,6 +76,32 @@ bool MockBackingStore::erase(void) {
     return true;
 }
 
+bool MockBackingStore::erase_partial(uint32_t address, uint32_t& erased_length) {
+    ++backing_erase_invoke_count;
+
+    EXPECT_TRUE(address % BACKING_STORE_ERASE_UNIT_SIZE::value == 0) << "Supplied address was not aligned with the erase unit size";
+    EXPECT_TRUE(address + BACKING_STORE_ERASE_UNIT_SIZE::value <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+    EXPECT_FALSE(is_locked()) << "Erase was attempted without being unlocked first";
+
+    // Erase each slot in the unit
+    std::size_t first = address / BACKING_STORE_WRITE_SIZE;
+    for (std::size_t i = first; i < first + BACKING_STORE_ERASE_UNIT_SIZE::value / BACKING_STORE_WRITE_SIZE; ++i) {
+        // Drop out of erase early with failure if we need to, leaving the unit partially erased
+        if (erase_success_callback && !erase_success_callback(backing_erase_invoke_count)) {
+            append_log(true);
+            return false;
+        }
+
+        backing_storage[i].erase();
+    }
+
+    // Keep track of the erase in the write log so that we can verify during tests
+    append_log(true);
+
+    erased_length = BACKING_STORE_ERASE_UNIT_SIZE::value;
+    return true;
+}
+
 bool MockBackingStore::write(uint32_t address, backing_store_int_t value) {
     ++backing_write_invoke_count;
 
@@ -114,6 +141,8 @@ bool MockBackingStore::lock(void) {
 }
 
 bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const {
+    ++backing_read_invoke_count;
+
     // precondition: value's buffer size already matches BACKING_STORE_WRITE_SIZE
     EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
     EXPECT_TRUE(address + BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
@@ -125,6 +154,21 @@ bool MockBackingStore::read(uint32_t address, backing_store_int_t& value) const
     return true;
 }
 
+bool MockBackingStore::read_bulk(uint32_t address, backing_store_int_t* values, std::size_t item_count) const {
+    ++backing_read_invoke_count;
+
+    EXPECT_TRUE(address % BACKING_STORE_WRITE_SIZE == 0) << "Supplied address was not aligned with the backing store integral size";
+    EXPECT_TRUE(address + item_count * BACKING_STORE_WRITE_SIZE <= WEAR_LEVELING_BACKING_SIZE) << "Address would result of out-of-bounds access";
+
+    // A single transaction, as a driver's optimised implementation would do
+    std::size_t index = address / BACKING_STORE_WRITE_SIZE;
+    for (std::size_t i = 0; i < item_count; ++i) {
+        values[i] = ~backing_storage[index + i].get();
+    }
+
+    return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Backing Implementation
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -141,6 +185,12 @@ extern "C" bool backing_store_erase(void) {
     return MockBackingStore::Instance().erase();
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+extern "C" bool backing_store_erase_partial(uint32_t address, uint32_t* erased_length) {
+    return MockBackingStore::Instance().erase_partial(address, *erased_length);
+}
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
 extern "C" bool backing_store_write(uint32_t address, backing_store_int_t value) {
     return MockBackingStore::Instance().write(address, value);
 }
@@ -152,3 +202,7 @@ extern "C" bool backing_store_lock(void) {
 extern "C" bool backing_store_read(uint32_t address, backing_store_int_t* value) {
     return MockBackingStore::Instance().read(address, *value);
 }
+
+extern "C" bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count) {
+    return MockBackingStore::Instance().read_bulk(address, values, item_count);
+}
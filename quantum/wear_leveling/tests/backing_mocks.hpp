@@ -21,6 +21,11 @@ using MOCK_WRITE_LOG_MAX_ENTRIES = std::integral_constant<std::size_t, 1024>;
 using BACKING_STORE_INTEGRAL_COMPLEMENT = std::integral_constant<backing_store_int_t, ((backing_store_int_t)(~(backing_store_int_t)0))>;
 // Total number of elements stored in the backing arrays
 using BACKING_STORE_ELEMENT_COUNT = std::integral_constant<std::size_t, (WEAR_LEVELING_BACKING_SIZE / sizeof(backing_store_int_t))>;
+// Size of the unit erased by a partial erase, like a flash sector
+#ifndef MOCK_ERASE_UNIT_SIZE
+#    define MOCK_ERASE_UNIT_SIZE 64
+#endif
+using BACKING_STORE_ERASE_UNIT_SIZE = std::integral_constant<std::size_t, MOCK_ERASE_UNIT_SIZE>;
 
 class MockBackingStoreElement {
    private:
@@ -96,6 +101,7 @@ class MockBackingStore {
     std::uint64_t backing_erase_invoke_count;
     std::uint64_t backing_write_invoke_count;
     std::uint64_t backing_lock_invoke_count;
+    mutable std::uint64_t backing_read_invoke_count;
 
     // Whether init should succeed
     std::function<bool(std::uint64_t)> init_success_callback;
@@ -147,6 +153,9 @@ class MockBackingStore {
     std::uint64_t lock_invoke_count() const {
         return backing_lock_invoke_count;
     }
+    std::uint64_t read_invoke_count() const {
+        return backing_read_invoke_count;
+    }
 
     // Clear out the internal data for the next run
     void reset_instance();
@@ -159,9 +168,11 @@ class MockBackingStore {
     bool init();
     bool unlock();
     bool erase();
+    bool erase_partial(std::uint32_t address, std::uint32_t& erased_length);
     bool write(std::uint32_t address, backing_store_int_t value);
     bool lock();
     bool read(std::uint32_t address, backing_store_int_t& value) const;
+    bool read_bulk(std::uint32_t address, backing_store_int_t* values, std::size_t item_count) const;
 
     // Control over when init/writes/erases should succeed
     void set_init_callback(std::function<bool(std::uint64_t)> callback) {
@@ -63,4 +63,42 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+
+wear_leveling_writeback_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=65536 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=32768 \
+	-DWEAR_LEVELING_WRITEBACK_ENABLE \
+	-DWEAR_LEVELING_WRITEBACK_RANGES=4
+wear_leveling_writeback_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_writeback.cpp
+wear_leveling_writeback_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_incremental_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=8 \
+	-DWEAR_LEVELING_BACKING_SIZE=512 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=64 \
+	-DWEAR_LEVELING_INCREMENTAL_CONSOLIDATION \
+	-DWEAR_LEVELING_CONSOLIDATION_STEP_SIZE=16
+wear_leveling_incremental_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_incremental.cpp
+wear_leveling_incremental_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_checkpoint_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=16384 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=1024 \
+	-DWEAR_LEVELING_CHECKPOINT_INTERVAL=64
+wear_leveling_checkpoint_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_checkpoint.cpp
+wear_leveling_checkpoint_INC := \
+	$(wear_leveling_common_INC)
@@ -293,3 +293,60 @@ TEST_F(WearLeveling2ByteOptimizedWrites, PlaybackReadbackWord01_Success) {
     wear_leveling_read(0x02, &tmp, sizeof(tmp));
     EXPECT_EQ(tmp, 1) << "Failed to read back the seeded data";
 }
+
+/**
+ * This test verifies that rewriting a block with a single changed U16 value only logs the changed value.
+ */
+TEST_F(WearLeveling2ByteOptimizedWrites, UnchangedDataIsNotLogged) {
+    auto& inst = MockBackingStore::Instance();
+    std::fill(verify_data.begin(), verify_data.end(), 0);
+
+    // Generate a test block of data the size of a raw HID keymap transfer
+    std::array<std::uint8_t, 28> testvalue;
+    std::iota(testvalue.begin(), testvalue.end(), 0x20);
+    EXPECT_EQ(test_write(2000, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    auto before = std::distance(inst.log_begin(), inst.log_end());
+
+    // Change one of the U16 values and write the whole block again
+    testvalue[10] = 0x55;
+    testvalue[11] = 0x66;
+    EXPECT_EQ(test_write(2000, testvalue.data(), testvalue.size()), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+
+    // Only a 2-byte multibyte entry (3 backing store writes) should have been appended
+    EXPECT_EQ(std::distance(inst.log_begin(), inst.log_end()) - before, 3) << "Unchanged data should not have been logged";
+    write_log_entry_t e;
+    auto              write_iter = inst.log_begin() + before;
+    e.raw16[0]                   = (write_iter + 0)->value;
+    e.raw16[1]                   = (write_iter + 1)->value;
+    EXPECT_EQ(LOG_ENTRY_GET_TYPE(e), LOG_ENTRY_TYPE_MULTIBYTE) << "Invalid write log entry type";
+    EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_ADDRESS(e), 2010) << "Invalid write log entry address";
+    EXPECT_EQ(LOG_ENTRY_MULTIBYTE_GET_LENGTH(e), 2) << "Invalid write log entry length";
+
+    // Re-init and re-read, verifying the reload capability
+    std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE> readback;
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    EXPECT_EQ(wear_leveling_read(0, readback.data(), WEAR_LEVELING_LOGICAL_SIZE), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    EXPECT_TRUE(memcmp(readback.data(), verify_data.data(), WEAR_LEVELING_LOGICAL_SIZE) == 0) << "Readback did not match";
+}
+
+/**
+ * This test verifies that the cache holds the whole write when the write log fails part way through appending its runs.
+ */
+TEST_F(WearLeveling2ByteOptimizedWrites, WriteFailurePartWay_CacheHoldsWholeWrite) {
+    auto& inst = MockBackingStore::Instance();
+
+    // Every other U16 value changes, so each one is its own run, more than the staging area can hold at once
+    std::array<std::uint8_t, 64> testvalue{};
+    for (std::size_t i = 0; i < testvalue.size(); i += 4) {
+        testvalue[i]     = 0x20 + i;
+        testvalue[i + 1] = 0x21 + i;
+    }
+
+    inst.set_write_callback([](std::uint64_t count, std::uint32_t address) { return false; });
+    EXPECT_EQ(wear_leveling_write(2000, testvalue.data(), testvalue.size()), WEAR_LEVELING_FAILED) << "Overall write operation should have failed";
+    EXPECT_EQ(inst.write_invoke_count(), 1) << "Write should have been invoked once";
+
+    std::array<std::uint8_t, 64> readback;
+    EXPECT_EQ(wear_leveling_read(2000, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read back the cached data";
+    EXPECT_TRUE(memcmp(readback.data(), testvalue.data(), testvalue.size()) == 0) << "Readback should come from cache regardless of write failure";
+}
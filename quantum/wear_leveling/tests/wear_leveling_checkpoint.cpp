@@ -0,0 +1,195 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <chrono>
+#include <iostream>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+// Start of the write log, after the consolidated data and its FNV1a_64
+constexpr std::uint32_t LOG_START = WEAR_LEVELING_LOGICAL_SIZE + 8;
+
+class WearLevelingCheckpoint : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    static logical_data_t read_all() {
+        logical_data_t data;
+        EXPECT_EQ(wear_leveling_read(0, data.data(), data.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        return data;
+    }
+
+    // Writes a distinct 16-bit value outside the optimised ranges, each of which is a single 3-word write log entry
+    static wear_leveling_status_t write_value(logical_data_t& expected, std::size_t index) {
+        uint32_t address = 64 + (index * 2) % (WEAR_LEVELING_LOGICAL_SIZE - 64);
+        uint16_t value   = 0x200 + index;
+        memcpy(&expected[address], &value, sizeof(value));
+        return wear_leveling_write(address, &value, sizeof(value));
+    }
+
+    static backing_store_int_t word_at(std::uint32_t address) {
+        return ~(MockBackingStore::Instance().storage_begin() + address / BACKING_STORE_WRITE_SIZE)->get();
+    }
+
+    static void set_word_at(std::uint32_t address, backing_store_int_t value) {
+        auto element = MockBackingStore::Instance().storage_begin() + address / BACKING_STORE_WRITE_SIZE;
+        element->erase();
+        element->set(~value);
+    }
+
+    struct log_position {
+        std::uint32_t address;
+        bool          checkpoint;
+    };
+
+    // Walks the write log as stored, returning the position of each entry
+    static std::vector<log_position> walk_log() {
+        std::vector<log_position> entries;
+        std::uint32_t             address = LOG_START;
+        while (address < WEAR_LEVELING_BACKING_SIZE && word_at(address) != 0) {
+            write_log_entry_t log{};
+            log.raw16[0] = word_at(address);
+            std::uint32_t words;
+            switch (LOG_ENTRY_GET_TYPE(log)) {
+                case LOG_ENTRY_TYPE_MULTIBYTE:
+                    words = 2 + (LOG_ENTRY_MULTIBYTE_GET_LENGTH(log) > 1 ? 1 : 0) + (LOG_ENTRY_MULTIBYTE_GET_LENGTH(log) > 3 ? 1 : 0);
+                    break;
+                case LOG_ENTRY_TYPE_CHECKPOINT:
+                    words = 4;
+                    break;
+                default:
+                    words = 1;
+                    break;
+            }
+            entries.push_back({address, LOG_ENTRY_GET_TYPE(log) == LOG_ENTRY_TYPE_CHECKPOINT});
+            address += words * BACKING_STORE_WRITE_SIZE;
+        }
+        return entries;
+    }
+};
+
+/**
+ * This test ensures checkpoints are appended at the configured interval, and that they verify on playback.
+ */
+TEST_F(WearLevelingCheckpoint, CheckpointsAreWrittenAtIntervals) {
+    logical_data_t expected{};
+    for (std::size_t i = 0; i < 100; ++i) {
+        ASSERT_EQ(write_value(expected, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    std::uint32_t last       = LOG_START;
+    std::size_t   found      = 0;
+    std::size_t   data_count = 0;
+    for (const auto& e : walk_log()) {
+        if (!e.checkpoint) {
+            ++data_count;
+            continue;
+        }
+        write_log_entry_t log{};
+        for (int i = 0; i < 4; ++i) {
+            log.raw16[i] = word_at(e.address + i * BACKING_STORE_WRITE_SIZE);
+        }
+        EXPECT_EQ(LOG_ENTRY_CHECKPOINT_GET_OFFSET(log), e.address - LOG_START) << "Checkpoint offset is incorrect";
+        EXPECT_GE(e.address - last, WEAR_LEVELING_CHECKPOINT_INTERVAL) << "Checkpoint came too early";
+        EXPECT_LT(e.address - last, WEAR_LEVELING_CHECKPOINT_INTERVAL + sizeof(write_log_entry_t)) << "Checkpoint came too late";
+        last = e.address + sizeof(write_log_entry_t);
+        ++found;
+    }
+    EXPECT_EQ(data_count, 100) << "Unexpected number of log entries";
+    EXPECT_EQ(found, (100 * 6) / WEAR_LEVELING_CHECKPOINT_INTERVAL) << "Unexpected number of checkpoints";
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), expected) << "Readback did not match";
+    EXPECT_EQ(MockBackingStore::Instance().erasure_count(), 0) << "Playback should not have consolidated";
+
+    // Checkpoints carry on from where the log was played back to
+    for (std::size_t i = 100; i < 200; ++i) {
+        ASSERT_EQ(write_value(expected, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), expected) << "Readback did not match";
+    EXPECT_EQ(MockBackingStore::Instance().erasure_count(), 0) << "Playback should not have consolidated";
+}
+
+/**
+ * This test ensures a segment that fails verification is not applied, nor anything after it.
+ */
+TEST_F(WearLevelingCheckpoint, CorruptSegmentIsDropped) {
+    logical_data_t expected{};
+    logical_data_t verified{};
+    for (std::size_t i = 0; i < 50; ++i) {
+        ASSERT_EQ(write_value(expected, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Replay the writes that precede the first checkpoint, and find an entry in the segment after it
+    auto          entries = walk_log();
+    std::size_t   first   = 0;
+    while (!entries[first].checkpoint) {
+        write_value(verified, first);
+        ++first;
+    }
+    ASSERT_FALSE(entries[first + 2].checkpoint);
+    const std::uint32_t victim = entries[first + 2].address;
+
+    // Flip a bit in the value of the entry, which otherwise still decodes correctly
+    set_word_at(victim + 2 * BACKING_STORE_WRITE_SIZE, word_at(victim + 2 * BACKING_STORE_WRITE_SIZE) ^ 0x10);
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Corruption did not force consolidation";
+    EXPECT_EQ(read_all(), verified) << "Only the first segment should have been applied";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), verified) << "Readback did not match after consolidation";
+}
+
+/**
+ * This test ensures a checkpoint torn by a power loss at the end of the log keeps the segment it covers.
+ */
+TEST_F(WearLevelingCheckpoint, TornCheckpointKeepsSegment) {
+    logical_data_t expected{};
+    std::size_t    index = 0;
+    while (walk_log().empty() || !walk_log().back().checkpoint) {
+        ASSERT_EQ(write_value(expected, index++), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+
+    // Drop the last half of the checkpoint, as though power was lost part way through writing it
+    const std::uint32_t checkpoint = walk_log().back().address;
+    (MockBackingStore::Instance().storage_begin() + checkpoint / BACKING_STORE_WRITE_SIZE + 2)->erase();
+    (MockBackingStore::Instance().storage_begin() + checkpoint / BACKING_STORE_WRITE_SIZE + 3)->erase();
+
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_CONSOLIDATED) << "Torn checkpoint did not force consolidation";
+    EXPECT_EQ(read_all(), expected) << "Segment before the torn checkpoint was not kept";
+    EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), expected) << "Readback did not match after consolidation";
+}
+
+/**
+ * Startup time with a nearly full write log. Reports how many log entries are replayed per millisecond and how many
+ * backing store reads it took.
+ */
+TEST_F(WearLevelingCheckpoint, Benchmark) {
+    auto&          inst = MockBackingStore::Instance();
+    logical_data_t expected{};
+
+    // Each entry takes 6 bytes plus its share of the checkpoints, fill most of the log with them
+    const std::size_t entries = ((WEAR_LEVELING_BACKING_SIZE - LOG_START) * 8 / 10) / 7;
+    for (std::size_t i = 0; i < entries; ++i) {
+        ASSERT_EQ(write_value(expected, i), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+    }
+    ASSERT_EQ(inst.erasure_count(), 0) << "Log should not have been consolidated";
+
+    const int rounds = 50;
+    uint64_t  reads  = inst.read_invoke_count();
+    auto      start  = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        EXPECT_EQ(wear_leveling_init(), WEAR_LEVELING_SUCCESS) << "Re-initialisation failed";
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    reads        = (inst.read_invoke_count() - reads) / rounds;
+
+    EXPECT_EQ(read_all(), expected) << "Readback did not match";
+    EXPECT_LT(reads, entries / 4) << "Playback should read the log in bulk";
+    std::cout << "playback: " << entries << " entries, " << reads << " backing store reads, " << (elapsed ? (uint64_t)entries * rounds * 1000 / elapsed : 0) << " entries/ms" << std::endl;
+}
@@ -0,0 +1,214 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+using logical_data_t = std::array<std::uint8_t, WEAR_LEVELING_LOGICAL_SIZE>;
+
+class WearLevelingIncremental : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    static logical_data_t read_all() {
+        logical_data_t data;
+        EXPECT_EQ(wear_leveling_read(0, data.data(), data.size()), WEAR_LEVELING_SUCCESS) << "Failed to read";
+        return data;
+    }
+
+    // Writes a distinct 16-bit value, each of which is a single write log entry with 8-byte backing store writes
+    static wear_leveling_status_t write_value(logical_data_t& expected, std::size_t index) {
+        uint32_t address = (index * 2) % WEAR_LEVELING_LOGICAL_SIZE;
+        uint16_t value   = 0x100 + index;
+        memcpy(&expected[address], &value, sizeof(value));
+        return wear_leveling_write(address, &value, sizeof(value));
+    }
+
+    // Keeps writing until a background consolidation has begun
+    static void write_until_pending(logical_data_t& expected, std::size_t& index) {
+        while (!wear_leveling_consolidation_pending()) {
+            ASSERT_EQ(write_value(expected, index++), WEAR_LEVELING_SUCCESS) << "Write returned incorrect status";
+            ASSERT_LT(index, 1000) << "Consolidation never began";
+        }
+    }
+};
+
+/**
+ * This test ensures consolidation is left for wear_leveling_task(), and that each step stays within its budget.
+ */
+TEST_F(WearLevelingIncremental, ConsolidationIsSpreadOverSteps) {
+    auto&          inst = MockBackingStore::Instance();
+    logical_data_t expected{};
+    std::size_t    index = 0;
+    write_until_pending(expected, index);
+    EXPECT_EQ(inst.erase_invoke_count(), 0) << "Writes should not have erased anything";
+
+    std::size_t steps = 0;
+    while (wear_leveling_consolidation_pending()) {
+        uint64_t erases = inst.erase_invoke_count();
+        uint64_t writes = inst.write_invoke_count();
+        EXPECT_NE(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Step failed";
+        EXPECT_LE(inst.erase_invoke_count() - erases, 1) << "Step erased more than one unit";
+        EXPECT_LE(inst.write_invoke_count() - writes, WEAR_LEVELING_CONSOLIDATION_STEP_SIZE / BACKING_STORE_WRITE_SIZE) << "Step wrote more than its budget";
+        ASSERT_LT(++steps, 100) << "Consolidation never completed";
+    }
+
+    // One step per erase unit of the bank, one per copied chunk, then switching banks
+    EXPECT_EQ(steps, (WEAR_LEVELING_BACKING_SIZE / 2) / BACKING_STORE_ERASE_UNIT_SIZE::value + WEAR_LEVELING_LOGICAL_SIZE / WEAR_LEVELING_CONSOLIDATION_STEP_SIZE + 1) << "Unexpected number of steps";
+    EXPECT_EQ(inst.erasure_count(), 0) << "The whole backing store should never be erased";
+    EXPECT_EQ(wear_leveling_task(), WEAR_LEVELING_SUCCESS) << "Idle step returned incorrect status";
+
+    EXPECT_EQ(read_all(), expected) << "Readback did not match";
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), expected) << "Readback did not match after re-init";
+}
+
+/**
+ * This test ensures the banks keep alternating over several consolidations.
+ */
+TEST_F(WearLevelingIncremental, BanksAlternate) {
+    logical_data_t expected{};
+    std::size_t    index = 0;
+    for (int i = 0; i < 5; ++i) {
+        write_until_pending(expected, index);
+        wear_leveling_status_t status;
+        while ((status = wear_leveling_task()) == WEAR_LEVELING_SUCCESS) {
+        }
+        EXPECT_EQ(status, WEAR_LEVELING_CONSOLIDATED) << "Consolidation did not complete";
+
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+        EXPECT_EQ(read_all(), expected) << "Readback did not match after consolidation " << i;
+    }
+}
+
+/**
+ * This test ensures writes made while consolidating are kept, including those to data that was already copied.
+ */
+TEST_F(WearLevelingIncremental, WritesDuringConsolidation) {
+    logical_data_t expected{};
+    std::size_t    index = 0;
+    write_until_pending(expected, index);
+
+    while (wear_leveling_consolidation_pending()) {
+        EXPECT_NE(wear_leveling_task(), WEAR_LEVELING_FAILED) << "Step failed";
+        // Rewrite the start of the data, which is copied first
+        uint16_t value = 0x5000 + index++;
+        memcpy(&expected[0], &value, sizeof(value));
+        EXPECT_NE(wear_leveling_write(0, &value, sizeof(value)), WEAR_LEVELING_FAILED) << "Write failed";
+    }
+
+    EXPECT_EQ(read_all(), expected) << "Readback did not match";
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), expected) << "Readback did not match after re-init";
+}
+
+/**
+ * This test ensures a full write log completes the consolidation in-line if wear_leveling_task() is never called.
+ */
+TEST_F(WearLevelingIncremental, FullLogConsolidatesInline) {
+    auto&                  inst = MockBackingStore::Instance();
+    logical_data_t         expected{};
+    std::size_t            index  = 0;
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    while (status != WEAR_LEVELING_CONSOLIDATED) {
+        status = write_value(expected, index++);
+        ASSERT_NE(status, WEAR_LEVELING_FAILED) << "Write failed";
+        ASSERT_LT(index, 1000) << "Consolidation never occurred";
+    }
+    EXPECT_FALSE(wear_leveling_consolidation_pending());
+    EXPECT_EQ(inst.erasure_count(), 0) << "The whole backing store should never be erased";
+
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), expected) << "Readback did not match after re-init";
+}
+
+/**
+ * This test ensures the older bank is used if the newer one's consolidated data is corrupt.
+ */
+TEST_F(WearLevelingIncremental, CorruptBankFallsBack) {
+    auto&          inst = MockBackingStore::Instance();
+    logical_data_t expected{};
+    std::size_t    index = 0;
+    write_until_pending(expected, index);
+    while (wear_leveling_task() == WEAR_LEVELING_SUCCESS) {
+    }
+
+    // The second consolidation goes back into the first bank
+    write_until_pending(expected, index);
+    while (wear_leveling_task() == WEAR_LEVELING_SUCCESS) {
+    }
+    auto newest = inst.storage_begin();
+    (newest + 1)->erase();
+
+    // The older bank's write log still holds everything written up to the second consolidation
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    EXPECT_EQ(read_all(), expected) << "Did not fall back to the older bank";
+}
+
+/**
+ * This test cuts the power after every single backing store operation across several consolidations, and ensures
+ * that every write that reported success is still present afterwards.
+ */
+TEST_F(WearLevelingIncremental, PowerLossAtEveryStep) {
+    auto&             inst       = MockBackingStore::Instance();
+    const std::size_t write_count = 120;
+
+    std::uint64_t operations = 0;
+    std::uint64_t power_off  = UINT64_MAX;
+    auto          powered    = [&]() { return ++operations <= power_off; };
+
+    // Runs the workload until the power goes, returning whether it did
+    auto run = [&](logical_data_t& committed, logical_data_t& in_flight) {
+        for (std::size_t index = 0; index < write_count; ++index) {
+            in_flight = committed;
+            if (write_value(in_flight, index) == WEAR_LEVELING_FAILED) {
+                return true;
+            }
+            committed = in_flight;
+            if (index % 2 == 0 && wear_leveling_task() == WEAR_LEVELING_FAILED) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Count the operations needed for the entire workload
+    logical_data_t committed{}, in_flight{};
+    inst.set_write_callback([&](std::uint64_t, std::uint32_t) { return powered(); });
+    inst.set_erase_callback([&](std::uint64_t) { return powered(); });
+    ASSERT_FALSE(run(committed, in_flight)) << "Workload failed without power loss";
+    const std::uint64_t total = operations;
+    ASSERT_GT(inst.erase_invoke_count(), 3 * (WEAR_LEVELING_BACKING_SIZE / 2) / BACKING_STORE_ERASE_UNIT_SIZE::value) << "Workload should span several consolidations";
+
+    for (power_off = 0; power_off < total; ++power_off) {
+        inst.reset_instance();
+        operations = 0;
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Initialisation failed";
+        inst.set_write_callback([&](std::uint64_t, std::uint32_t) { return powered(); });
+        inst.set_erase_callback([&](std::uint64_t) { return powered(); });
+
+        committed = {};
+        ASSERT_TRUE(run(committed, in_flight)) << "Power was never lost at operation " << power_off;
+
+        // Power comes back
+        inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+        inst.set_erase_callback([](std::uint64_t) { return true; });
+        if (!inst.is_locked()) {
+            inst.lock();
+        }
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed after losing power at operation " << power_off;
+        logical_data_t recovered = read_all();
+        ASSERT_TRUE(recovered == committed || recovered == in_flight) << "Data lost after losing power at operation " << power_off;
+
+        // Carry on from the recovered state
+        std::size_t index = write_count;
+        write_until_pending(recovered, index);
+        while (wear_leveling_task() == WEAR_LEVELING_SUCCESS) {
+        }
+        ASSERT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+        ASSERT_EQ(read_all(), recovered) << "Readback did not match after recovering from operation " << power_off;
+    }
+}
@@ -0,0 +1,183 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+class WearLevelingWriteback : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+
+    static std::size_t log_size() {
+        auto& inst = MockBackingStore::Instance();
+        return std::distance(inst.log_begin(), inst.log_end());
+    }
+
+    static wear_leveling_writeback_stats_t stats() {
+        wear_leveling_writeback_stats_t s;
+        wear_leveling_get_writeback_stats(&s);
+        return s;
+    }
+};
+
+/**
+ * This test ensures writes only reach the backing store once synced, while reads see the new data straight away.
+ */
+TEST_F(WearLevelingWriteback, WritesAreHeldUntilSync) {
+    uint32_t value = 0x12345678, readback = 0;
+    EXPECT_EQ(wear_leveling_write(100, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(log_size(), 0) << "Write reached the backing store before sync";
+    EXPECT_TRUE(wear_leveling_sync_pending());
+
+    EXPECT_EQ(wear_leveling_read(100, &readback, sizeof(readback)), WEAR_LEVELING_SUCCESS) << "Failed to read back the data";
+    EXPECT_EQ(readback, value) << "Readback did not match before sync";
+
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_SUCCESS) << "Sync failed with incorrect status";
+    EXPECT_GT(log_size(), 0) << "Sync did not reach the backing store";
+    EXPECT_FALSE(wear_leveling_sync_pending());
+
+    // Nothing left, so another sync is free
+    std::size_t synced = log_size();
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_SUCCESS) << "Sync failed with incorrect status";
+    EXPECT_EQ(log_size(), synced) << "Empty sync wrote to the backing store";
+}
+
+/**
+ * This test ensures a burst of writes to the same data costs the same as writing the final value once.
+ */
+TEST_F(WearLevelingWriteback, BurstOfWritesIsLoggedOnce) {
+    uint16_t value = 0x4321;
+    EXPECT_EQ(wear_leveling_write(20000, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_SUCCESS) << "Sync failed with incorrect status";
+    std::size_t single = log_size();
+
+    MockBackingStore::Instance().reset_instance();
+    wear_leveling_init();
+    for (value = 1; value <= 0x4321; value += 0x11) {
+        EXPECT_EQ(wear_leveling_write(20000, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    }
+    value = 0x4321;
+    EXPECT_EQ(wear_leveling_write(20000, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_SUCCESS) << "Sync failed with incorrect status";
+    EXPECT_EQ(log_size(), single) << "Burst of writes was not coalesced";
+}
+
+/**
+ * This test ensures overlapping and adjacent writes are merged into one pending range.
+ */
+TEST_F(WearLevelingWriteback, AdjacentWritesAreCoalesced) {
+    const uint16_t expected[3] = {0x5555, 0xAAAA, 0xAAAA};
+    EXPECT_EQ(wear_leveling_write(200, expected, sizeof(expected)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_SUCCESS) << "Sync failed with incorrect status";
+    std::size_t single = log_size();
+
+    MockBackingStore::Instance().reset_instance();
+    wear_leveling_init();
+    auto     before = stats();
+    uint16_t value  = 0xAAAA;
+    EXPECT_EQ(wear_leveling_write(200, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(wear_leveling_write(204, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    // Bridges the two ranges above
+    EXPECT_EQ(wear_leveling_write(202, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    value = 0x5555;
+    EXPECT_EQ(wear_leveling_write(200, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+
+    auto after = stats();
+    EXPECT_EQ(after.deferred - before.deferred, 4) << "Unexpected number of deferred writes";
+    EXPECT_EQ(after.coalesced - before.coalesced, 2) << "Unexpected number of coalesced writes";
+
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_SUCCESS) << "Sync failed with incorrect status";
+    EXPECT_EQ(log_size(), single) << "Merged range was not logged as a single entry";
+    EXPECT_EQ(stats().syncs - after.syncs, 1) << "Unexpected number of syncs";
+}
+
+/**
+ * This test ensures synced data is reloaded from the backing store.
+ */
+TEST_F(WearLevelingWriteback, SyncedDataSurvivesReinit) {
+    std::array<std::uint8_t, 64> data;
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = (uint8_t)(i * 7 + 3);
+    }
+    EXPECT_EQ(wear_leveling_write(1000, data.data(), data.size()), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(wear_leveling_write(30000, data.data(), 8), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_SUCCESS) << "Sync failed with incorrect status";
+
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    std::array<std::uint8_t, 64> readback;
+    EXPECT_EQ(wear_leveling_read(1000, readback.data(), readback.size()), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    EXPECT_EQ(readback, data) << "Readback did not match after re-init";
+    EXPECT_EQ(wear_leveling_read(30000, readback.data(), 8), WEAR_LEVELING_SUCCESS) << "Failed to read back the saved data";
+    EXPECT_TRUE(memcmp(readback.data(), data.data(), 8) == 0) << "Readback did not match after re-init";
+}
+
+/**
+ * This test ensures unsynced data is lost on re-init, as it would be on power loss.
+ */
+TEST_F(WearLevelingWriteback, UnsyncedDataIsLostOnReinit) {
+    uint16_t value = 0x1234, readback = 0;
+    EXPECT_EQ(wear_leveling_write(10, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    EXPECT_FALSE(wear_leveling_sync_pending());
+    EXPECT_EQ(wear_leveling_read(10, &readback, sizeof(readback)), WEAR_LEVELING_SUCCESS) << "Failed to read back the data";
+    EXPECT_EQ(readback, 0) << "Unsynced data was persisted";
+}
+
+/**
+ * This test ensures that running out of pending ranges syncs the existing ones first.
+ */
+TEST_F(WearLevelingWriteback, FullRangeListSyncs) {
+    uint16_t value  = 0x0101;
+    auto     before = stats();
+    for (uint32_t address = 1000; address < 1000 + (WEAR_LEVELING_WRITEBACK_RANGES) * 100; address += 100) {
+        EXPECT_EQ(wear_leveling_write(address, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    }
+    EXPECT_EQ(log_size(), 0) << "Write reached the backing store before the range list was full";
+
+    EXPECT_EQ(wear_leveling_write(5000, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_GT(log_size(), 0) << "Full range list did not sync";
+    EXPECT_EQ(stats().syncs - before.syncs, 1) << "Unexpected number of syncs";
+    EXPECT_TRUE(wear_leveling_sync_pending()) << "The write that triggered the sync should still be pending";
+
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_SUCCESS) << "Sync failed with incorrect status";
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    for (uint32_t address : {1000, 1100, 1200, 1300, 5000}) {
+        uint16_t readback = 0;
+        EXPECT_EQ(wear_leveling_read(address, &readback, sizeof(readback)), WEAR_LEVELING_SUCCESS) << "Failed to read back the data";
+        EXPECT_EQ(readback, value) << "Readback did not match at address " << address;
+    }
+}
+
+/**
+ * This test ensures a failed sync keeps the data pending so that a later sync can retry.
+ */
+TEST_F(WearLevelingWriteback, FailedSyncIsRetried) {
+    auto&    inst  = MockBackingStore::Instance();
+    uint32_t value = 0xCAFEF00D, readback = 0;
+    EXPECT_EQ(wear_leveling_write(400, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return false; });
+    EXPECT_EQ(wear_leveling_sync(), WEAR_LEVELING_FAILED) << "Sync succeeded with a failing backing store";
+    EXPECT_TRUE(wear_leveling_sync_pending()) << "Failed sync dropped the pending data";
+
+    inst.set_write_callback([](std::uint64_t, std::uint32_t) { return true; });
+    EXPECT_NE(wear_leveling_sync(), WEAR_LEVELING_FAILED) << "Sync failed with incorrect status";
+    EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED) << "Re-initialisation failed";
+    EXPECT_EQ(wear_leveling_read(400, &readback, sizeof(readback)), WEAR_LEVELING_SUCCESS) << "Failed to read back the data";
+    EXPECT_EQ(readback, value) << "Readback did not match after the retried sync";
+}
+
+/**
+ * This test ensures erasing drops anything still pending.
+ */
+TEST_F(WearLevelingWriteback, EraseDropsPendingRanges) {
+    uint16_t value = 0x7777, readback = 0;
+    EXPECT_EQ(wear_leveling_write(600, &value, sizeof(value)), WEAR_LEVELING_SUCCESS) << "Write failed with incorrect status";
+    EXPECT_EQ(wear_leveling_erase(), WEAR_LEVELING_SUCCESS) << "Erase failed with incorrect status";
+    EXPECT_FALSE(wear_leveling_sync_pending()) << "Erase left data pending";
+    EXPECT_EQ(wear_leveling_read(600, &readback, sizeof(readback)), WEAR_LEVELING_SUCCESS) << "Failed to read back the data";
+    EXPECT_EQ(readback, 0) << "Erase did not clear the data";
+}
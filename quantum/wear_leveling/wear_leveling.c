@@ -61,21 +61,65 @@
             to other subsystems performing reads/writes. This must be a multiple
             of the write size.
 
+        - WEAR_LEVELING_WRITEBACK_ENABLE: If defined, writes only update the
+            cache and remember which ranges changed. The changes are appended
+            to the write log by wear_leveling_sync(), so that bursts of small
+            writes to the same data become a single set of log entries.
+
+        - WEAR_LEVELING_INCREMENTAL_CONSOLIDATION: If defined, the backing
+            store is split into two banks and consolidation is performed a
+            step at a time by wear_leveling_task(), instead of erasing and
+            rewriting the backing store in one go. Requires the backing store
+            to implement backing_store_erase_partial(), and each bank to be at
+            least twice the logical size.
+
+        - WEAR_LEVELING_CHECKPOINT_INTERVAL: If defined, a checkpoint entry is
+            appended to the write log each time this many bytes of log entries
+            have been written since the last one. Checkpoints let playback
+            verify the write log before applying it.
+
     General algorithm:
 
         During initialization:
             * The contents of the consolidated data section are read into cache.
             * The contents of the write log are "played back" and update the
-                cache accordingly.
+                cache accordingly. The log is read in chunks of
+                WEAR_LEVELING_PLAYBACK_BUFFER_SIZE bytes with bulk reads.
 
         During reads:
             * Logical data is served from the cache.
 
         During writes:
+            * Only the parts of the data that differ from the cache are
+                considered, in units of 2 bytes relative to the start of the write.
             * The cache is updated with the new data.
-            * A new write log entry is appended to the log.
+            * New write log entries are staged in RAM, then appended to the log
+                with as few bulk backing store writes as possible.
             * If the log's full, data is consolidated and the write log cleared.
 
+        With write-back enabled, writes stop once the cache is updated and the
+        changed ranges are recorded. Syncing performs the remaining steps for
+        each recorded range.
+
+    Incremental consolidation:
+
+        Each bank has the same layout as the whole backing store otherwise
+        has, except that the FNV1a_64 is followed by an 8-byte sequence number
+        (the number, then its complement) and also covers it. The write log
+        starts after the sequence number. On startup the valid bank with the
+        highest sequence number is used.
+
+        Once the active bank's write log has less than
+        WEAR_LEVELING_CONSOLIDATION_RESERVE bytes free, consolidation into the
+        other bank begins. Each step either erases one erase unit of the other
+        bank, or copies WEAR_LEVELING_CONSOLIDATION_STEP_SIZE bytes of the
+        cache into it. Writes are still logged to the active bank meanwhile,
+        and any that land in parts already copied are logged again into the
+        other bank's write log once copying is complete. Writing the sequence
+        number and FNV1a_64 last switches banks, so a valid copy of the data
+        exists at every step. If the active bank's log fills up before that,
+        the remaining steps are performed in-line.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -153,7 +197,111 @@
         ║  │Address >> 1 ║
         ║  └── Value: 1  ║
         ╚════════════════╝
-        0 <= Address <= 0x3FFE (16382) */
+        0 <= Address <= 0x3FFE (16382)
+
+    Checkpoints:
+
+        With WEAR_LEVELING_CHECKPOINT_INTERVAL defined, the write log is split
+        into segments by checkpoint entries, available for all backing store
+        write sizes:
+
+        ╔ Checkpoint Log Entry (2, 4, 8-byte) ══════════════════════════════════╗
+        ║11000000║OOOOOOOO║OOOOOOOO║OOOOOOOO║HHHHHHHH║HHHHHHHH║HHHHHHHH║HHHHHHHH║
+        ║        ║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║└──┬───┘║
+        ║  Type  ║ Offset ║ Offset ║ Offset ║  Hash  ║  Hash  ║  Hash  ║  Hash  ║
+        ╚════════╩════════╩════════╩════════╩════════╩════════╩════════╩════════╝
+
+        The offset is the checkpoint's position relative to the start of the
+        write log, and the hash is a FNV1a_32 of the write log before it,
+        including earlier checkpoints. Playback only applies a segment once its
+        checkpoint verifies. A segment that doesn't verify is dropped along
+        with the rest of the log, which is then consolidated -- unless the
+        checkpoint is the last entry in the log, in which case it was torn by
+        a power loss while being written, and the segment is kept. Entries
+        after the last checkpoint are applied as they would be without
+        checkpoints. */
+
+/**
+ * Size of the RAM staging area for write log entries, in bytes. Log entries produced by a single
+ * wear_leveling_write() are collected here and appended to the backing store with bulk writes.
+ */
+#ifndef WEAR_LEVELING_LOG_STAGING_SIZE
+#    define WEAR_LEVELING_LOG_STAGING_SIZE 64
+#endif
+
+_Static_assert(WEAR_LEVELING_LOG_STAGING_SIZE >= sizeof(write_log_entry_t), "Log staging area must be able to hold at least one write log entry");
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#    define WEAR_LEVELING_BANK_SIZE ((WEAR_LEVELING_BACKING_SIZE) / 2)
+#    define WEAR_LEVELING_HEADER_SIZE 16 // FNV1a_64 of the consolidated data and sequence number, then the sequence number
+#else
+#    define WEAR_LEVELING_BANK_SIZE (WEAR_LEVELING_BACKING_SIZE)
+#    define WEAR_LEVELING_HEADER_SIZE 8 // FNV1a_64 of the consolidated data
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+#define WEAR_LEVELING_LOG_START ((WEAR_LEVELING_LOGICAL_SIZE) + WEAR_LEVELING_HEADER_SIZE)
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+_Static_assert(WEAR_LEVELING_CHECKPOINT_INTERVAL > 0, "Checkpoint interval must be nonzero");
+_Static_assert(WEAR_LEVELING_BANK_SIZE <= (1UL << 24), "Write log is too large for the checkpoint offset");
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
+/**
+ * Size of the RAM buffer the write log is read into during playback, in bytes. With checkpoints enabled it must hold
+ * a whole segment, its checkpoint and the word after it.
+ */
+#ifndef WEAR_LEVELING_PLAYBACK_BUFFER_SIZE
+#    ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+#        define WEAR_LEVELING_PLAYBACK_BUFFER_SIZE ((((WEAR_LEVELING_CHECKPOINT_INTERVAL) + 2 * sizeof(write_log_entry_t)) / (BACKING_STORE_WRITE_SIZE) + 1) * (BACKING_STORE_WRITE_SIZE))
+#    else
+#        define WEAR_LEVELING_PLAYBACK_BUFFER_SIZE 64
+#    endif
+#endif
+
+_Static_assert(WEAR_LEVELING_PLAYBACK_BUFFER_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Playback buffer size must be a multiple of write size");
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+_Static_assert(WEAR_LEVELING_PLAYBACK_BUFFER_SIZE >= (WEAR_LEVELING_CHECKPOINT_INTERVAL) + 2 * sizeof(write_log_entry_t) + (BACKING_STORE_WRITE_SIZE), "Playback buffer must be able to hold a whole checkpointed segment");
+#else
+_Static_assert(WEAR_LEVELING_PLAYBACK_BUFFER_SIZE >= sizeof(write_log_entry_t), "Playback buffer must be able to hold at least one write log entry");
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+/**
+ * Number of bytes of consolidated data programmed by each step of an incremental consolidation.
+ */
+#    ifndef WEAR_LEVELING_CONSOLIDATION_STEP_SIZE
+#        define WEAR_LEVELING_CONSOLIDATION_STEP_SIZE 256
+#    endif
+
+/**
+ * Free write log space, in bytes, below which incremental consolidation begins. Writes made while it runs are still
+ * logged to the active bank, so this should comfortably hold the writes expected over that time.
+ */
+#    ifndef WEAR_LEVELING_CONSOLIDATION_RESERVE
+#        define WEAR_LEVELING_CONSOLIDATION_RESERVE ((WEAR_LEVELING_BANK_SIZE - WEAR_LEVELING_LOG_START) / 2)
+#    endif
+
+_Static_assert(WEAR_LEVELING_BANK_SIZE >= (WEAR_LEVELING_LOGICAL_SIZE * 2), "Each bank must be at least twice the size of the logical size");
+_Static_assert(WEAR_LEVELING_BANK_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Bank size must be a multiple of write size");
+_Static_assert(WEAR_LEVELING_CONSOLIDATION_STEP_SIZE % BACKING_STORE_WRITE_SIZE == 0, "Consolidation step size must be a multiple of write size");
+
+typedef enum wear_leveling_consolidation_state_t {
+    CONSOLIDATION_IDLE,
+    CONSOLIDATION_ERASING,
+    CONSOLIDATION_COPYING,
+    CONSOLIDATION_FINALIZING,
+} wear_leveling_consolidation_state_t;
+
+#    define WEAR_LEVELING_CONSOLIDATION_STEPS (((WEAR_LEVELING_LOGICAL_SIZE) + (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE)-1) / (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE))
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
+/**
+ * Number of separate changed ranges held back when WEAR_LEVELING_WRITEBACK_ENABLE is defined. Writes that overlap or
+ * touch a pending range extend it; once every range is in use, the next write syncs them first.
+ */
+#ifndef WEAR_LEVELING_WRITEBACK_RANGES
+#    define WEAR_LEVELING_WRITEBACK_RANGES 8
+#endif
 
 /**
  * Storage area for the wear-leveling cache.
@@ -162,6 +310,28 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+    backing_store_int_t                                            staged[(WEAR_LEVELING_LOG_STAGING_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+    size_t                                                         staged_count;
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+    struct {
+        uint32_t start;
+        uint32_t end;
+    } dirty[(WEAR_LEVELING_WRITEBACK_RANGES)];
+    size_t                          dirty_count;
+    wear_leveling_writeback_stats_t stats;
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    uint32_t bank;     // base address of the active bank
+    uint32_t sequence; // sequence number of the active bank, zero if it has never been consolidated
+    uint8_t  consolidation;
+    uint32_t progress; // next address to erase or copy, relative to the other bank
+    uint64_t hash;     // FNV1a_64 of the data copied so far
+    uint8_t  recopy[(WEAR_LEVELING_CONSOLIDATION_STEPS + 7) / 8]; // copied steps that have changed since
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    uint32_t log_hash;           // FNV1a_32 of the write log so far, including staged entries
+    uint32_t checkpoint_address; // address just after the last checkpoint, or the start of the write log
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
 } wear_leveling;
 
 /**
@@ -197,12 +367,68 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
     return STATUS_SUCCESS;
 }
 
+/**
+ * Points the write log at an empty log starting at the supplied address.
+ */
+static inline void wear_leveling_reset_log(uint32_t address) {
+    wear_leveling.write_address = address;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.log_hash           = FNV1_32A_INIT;
+    wear_leveling.checkpoint_address = address;
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+}
+
 /**
  * Resets the cache, ensuring the write address is correctly initialised.
  */
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+    wear_leveling_reset_log(WEAR_LEVELING_LOG_START);
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+    wear_leveling.dirty_count = 0;
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling.bank          = 0;
+    wear_leveling.sequence      = 0;
+    wear_leveling.consolidation = CONSOLIDATION_IDLE;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
+/**
+ * Base address of the bank currently holding the consolidated data and write log.
+ */
+static inline uint32_t wear_leveling_bank_base(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    return wear_leveling.bank;
+#else
+    return 0;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
+/**
+ * Reads an 8-byte header value from the backing store.
+ */
+static bool wear_leveling_read_header(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_read_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_read_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_read(address, &entry->raw64);
+#endif
+}
+
+/**
+ * Writes an 8-byte header value to the backing store.
+ */
+static bool wear_leveling_write_header(uint32_t address, write_log_entry_t *entry) {
+#if BACKING_STORE_WRITE_SIZE == 2
+    return backing_store_write_bulk(address, entry->raw16, 4);
+#elif BACKING_STORE_WRITE_SIZE == 4
+    return backing_store_write_bulk(address, entry->raw32, 2);
+#elif BACKING_STORE_WRITE_SIZE == 8
+    return backing_store_write(address, entry->raw64);
+#endif
 }
 
 /**
@@ -212,6 +438,49 @@ static void wear_leveling_clear_cache(void) {
 static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     wl_dprintf("Reading consolidated data\n");
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Find each bank's sequence number, an erased or torn one reads as zero
+    uint32_t sequence[2] = {0, 0};
+    for (int i = 0; i < 2; ++i) {
+        write_log_entry_t entry;
+        if (wear_leveling_read_header(i * (WEAR_LEVELING_BANK_SIZE) + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry) && entry.raw32[0] == (uint32_t)~entry.raw32[1]) {
+            sequence[i] = entry.raw32[0];
+        }
+    }
+
+    // Try the newest bank first, falling back to the other if its data doesn't verify
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    const int              newest = sequence[1] > sequence[0] ? 1 : 0;
+    for (int i = 0; i < 2; ++i) {
+        const int      bank = i == 0 ? newest : !newest;
+        const uint32_t base = bank * (WEAR_LEVELING_BANK_SIZE);
+        if (sequence[bank] == 0) {
+            continue;
+        }
+        if (!backing_store_read_bulk(base, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
+            wl_dprintf("Failed to read from backing store\n");
+            status = WEAR_LEVELING_FAILED;
+            continue;
+        }
+
+        write_log_entry_t entry    = {.raw32 = {sequence[bank], ~sequence[bank]}};
+        uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
+        expected                   = fnv_64a_buf(&entry, sizeof(entry), expected);
+        if (wear_leveling_read_header(base + (WEAR_LEVELING_LOGICAL_SIZE), &entry) && entry.raw64 == expected) {
+            wl_dprintf("Checksum matches, bank %d is correct\n", bank);
+            wear_leveling.bank     = base;
+            wear_leveling.sequence = sequence[bank];
+            wear_leveling_reset_log(base + WEAR_LEVELING_LOG_START);
+            return WEAR_LEVELING_SUCCESS;
+        }
+        wl_dprintf("Checksum mismatch in bank %d\n", bank);
+    }
+
+    // Neither bank holds consolidated data, so carry on from the first bank's write log. This also caters for the
+    // completely clean MCU case.
+    wear_leveling_clear_cache();
+    return status;
+#else
     wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
     if (!backing_store_read_bulk(0, (backing_store_int_t *)wear_leveling.cache, sizeof(wear_leveling.cache) / sizeof(backing_store_int_t))) {
         wl_dprintf("Failed to read from backing store\n");
@@ -223,13 +492,7 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
         uint64_t          expected = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         write_log_entry_t entry;
         wl_dprintf("Reading checksum\n");
-#if BACKING_STORE_WRITE_SIZE == 2
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4);
-#elif BACKING_STORE_WRITE_SIZE == 4
-        backing_store_read_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2);
-#elif BACKING_STORE_WRITE_SIZE == 8
-        backing_store_read((WEAR_LEVELING_LOGICAL_SIZE) + 0, &entry.raw64);
-#endif
+        wear_leveling_read_header((WEAR_LEVELING_LOGICAL_SIZE), &entry);
         // If we have a mismatch, clear the cache but do not flag a failure,
         // which will cater for the completely clean MCU case.
         if (entry.raw64 == expected) {
@@ -246,8 +509,205 @@ static wear_leveling_status_t wear_leveling_read_consolidated(void) {
     }
 
     return status;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+static wear_leveling_status_t wear_leveling_flush_staged(void);
+static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const void *value, size_t length);
+
+/**
+ * Begins consolidating into the other bank. Only state is changed, the work happens in later steps.
+ */
+static void wear_leveling_consolidate_begin(void) {
+    wl_dprintf("Starting incremental consolidation\n");
+    wear_leveling.consolidation = CONSOLIDATION_ERASING;
+    wear_leveling.progress      = 0;
+}
+
+/**
+ * Logs the parts of the copied data that have changed since into the other bank's write log, then writes its sequence
+ * number and FNV1a_64 to make it the active bank.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED if the banks were switched, WEAR_LEVELING_SUCCESS if copying has to start over
+ */
+static wear_leveling_status_t wear_leveling_consolidate_finalize(uint32_t target) {
+    const uint32_t previous_bank          = wear_leveling.bank;
+    const uint32_t previous_write_address = wear_leveling.write_address;
+#    ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    const uint32_t previous_log_hash           = wear_leveling.log_hash;
+    const uint32_t previous_checkpoint_address = wear_leveling.checkpoint_address;
+#    endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+
+    // Point the write log at the other bank -- it's not valid until the header is written, so anything logged here is
+    // ignored if power is lost before then
+    wear_leveling.bank = target;
+    wear_leveling_reset_log(target + WEAR_LEVELING_LOG_START);
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (uint32_t step = 0; step < WEAR_LEVELING_CONSOLIDATION_STEPS && status == WEAR_LEVELING_SUCCESS; ++step) {
+        if (!(wear_leveling.recopy[step / 8] & (1 << (step % 8)))) {
+            continue;
+        }
+
+        const uint32_t end = (step + 1) * (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) < (WEAR_LEVELING_LOGICAL_SIZE) ? (step + 1) * (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) : (WEAR_LEVELING_LOGICAL_SIZE);
+        for (uint32_t address = step * (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE); address < end && status == WEAR_LEVELING_SUCCESS; address += sizeof(write_log_entry_t)) {
+            const size_t      length = end - address < sizeof(write_log_entry_t) ? end - address : sizeof(write_log_entry_t);
+            write_log_entry_t copied;
+            if (!backing_store_read_bulk(target + address, (backing_store_int_t *)copied.raw8, length / (BACKING_STORE_WRITE_SIZE))) {
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+            if (memcmp(copied.raw8, &wear_leveling.cache[address], length) == 0) {
+                continue;
+            }
+
+            // Leave enough room that the log can never fill up from in here, start over if it would
+            const uint32_t pending = wear_leveling.write_address + wear_leveling.staged_count * (BACKING_STORE_WRITE_SIZE);
+            if (pending + 2 * sizeof(write_log_entry_t) >= target + (WEAR_LEVELING_BANK_SIZE)) {
+                wl_dprintf("Too many changes while copying, starting over\n");
+                wear_leveling.staged_count = 0;
+                status                     = WEAR_LEVELING_SUCCESS;
+                wear_leveling_consolidate_begin();
+                break;
+            }
+            status = wear_leveling_write_raw(address, &wear_leveling.cache[address], length);
+        }
+        if (wear_leveling.consolidation != CONSOLIDATION_FINALIZING) {
+            break;
+        }
+    }
+    if (status == WEAR_LEVELING_SUCCESS && wear_leveling.consolidation == CONSOLIDATION_FINALIZING) {
+        status = wear_leveling_flush_staged();
+    }
+
+    if (status == WEAR_LEVELING_SUCCESS && wear_leveling.consolidation == CONSOLIDATION_FINALIZING) {
+        // Sequence number first, then the FNV1a_64 covering both the data and the sequence number
+        write_log_entry_t entry = {.raw32 = {wear_leveling.sequence + 1, ~(wear_leveling.sequence + 1)}};
+        uint64_t          hash  = fnv_64a_buf(&entry, sizeof(entry), wear_leveling.hash);
+        if (!wear_leveling_write_header(target + (WEAR_LEVELING_LOGICAL_SIZE) + 8, &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        } else {
+            entry.raw64 = hash;
+            if (!wear_leveling_write_header(target + (WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+                status = WEAR_LEVELING_FAILED;
+            }
+        }
+    }
+
+    if (status == WEAR_LEVELING_SUCCESS && wear_leveling.consolidation == CONSOLIDATION_FINALIZING) {
+        wl_dprintf("Consolidated into bank at 0x%08lX\n", (unsigned long)target);
+        wear_leveling.sequence++;
+        wear_leveling.consolidation = CONSOLIDATION_IDLE;
+        return WEAR_LEVELING_CONSOLIDATED;
+    }
+
+    // Still on the previous bank
+    wear_leveling.bank          = previous_bank;
+    wear_leveling.write_address = previous_write_address;
+    wear_leveling.staged_count  = 0;
+#    ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.log_hash           = previous_log_hash;
+    wear_leveling.checkpoint_address = previous_checkpoint_address;
+#    endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+    return status;
+}
+
+/**
+ * Performs a single step of an incremental consolidation.
+ * Pre-condition: the backing store is unlocked.
+ *
+ * @return WEAR_LEVELING_CONSOLIDATED if this step completed the consolidation
+ */
+static wear_leveling_status_t wear_leveling_consolidate_step(void) {
+    const uint32_t         target = wear_leveling.bank ^ (WEAR_LEVELING_BANK_SIZE);
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+
+    switch (wear_leveling.consolidation) {
+        case CONSOLIDATION_ERASING: {
+            uint32_t erased = 0;
+            if (!backing_store_erase_partial(target + wear_leveling.progress, &erased) || erased == 0) {
+                wl_dprintf("Failed to erase backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+            wear_leveling.progress += erased;
+            if (wear_leveling.progress >= (WEAR_LEVELING_BANK_SIZE)) {
+                wear_leveling.consolidation = CONSOLIDATION_COPYING;
+                wear_leveling.progress      = 0;
+                wear_leveling.hash          = FNV1A_64_INIT;
+                memset(wear_leveling.recopy, 0, sizeof(wear_leveling.recopy));
+            }
+        } break;
+
+        case CONSOLIDATION_COPYING: {
+            const uint32_t remaining = (WEAR_LEVELING_LOGICAL_SIZE) - wear_leveling.progress;
+            const uint32_t length    = remaining < (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) ? remaining : (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE);
+            if (!backing_store_write_bulk(target + wear_leveling.progress, (backing_store_int_t *)&wear_leveling.cache[wear_leveling.progress], length / (BACKING_STORE_WRITE_SIZE))) {
+                wl_dprintf("Failed to write to backing store\n");
+                status = WEAR_LEVELING_FAILED;
+                break;
+            }
+            wear_leveling.hash = fnv_64a_buf(&wear_leveling.cache[wear_leveling.progress], length, wear_leveling.hash);
+            wear_leveling.progress += length;
+            if (wear_leveling.progress >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                wear_leveling.consolidation = CONSOLIDATION_FINALIZING;
+            }
+        } break;
+
+        case CONSOLIDATION_FINALIZING:
+            status = wear_leveling_consolidate_finalize(target);
+            break;
+
+        default:
+            break;
+    }
+
+    // Partially programmed areas can't be programmed again without erasing them first
+    if (status == WEAR_LEVELING_FAILED) {
+        wear_leveling_consolidate_begin();
+    }
+    return status;
+}
+
+/**
+ * Records that part of the cache changed after being copied into the other bank.
+ */
+static void wear_leveling_consolidate_mark(uint32_t address, size_t length) {
+    if (wear_leveling.consolidation != CONSOLIDATION_COPYING && wear_leveling.consolidation != CONSOLIDATION_FINALIZING) {
+        return;
+    }
+    const uint32_t end = address + length < wear_leveling.progress ? address + length : wear_leveling.progress;
+    for (uint32_t step = address / (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE); step * (WEAR_LEVELING_CONSOLIDATION_STEP_SIZE) < end; ++step) {
+        wear_leveling.recopy[step / 8] |= 1 << (step % 8);
+    }
+}
+
+/**
+ * Completes the current consolidation in-line, beginning one if required.
+ */
+static wear_leveling_status_t wear_leveling_consolidate_force(void) {
+    if (wear_leveling.consolidation == CONSOLIDATION_IDLE) {
+        wear_leveling_consolidate_begin();
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status;
+    do {
+        status = wear_leveling_consolidate_step();
+    } while (status == WEAR_LEVELING_SUCCESS);
+
+    if (lock_status == STATUS_SUCCESS) {
+        wear_leveling_lock();
+    }
+    return status;
+}
+#else
 /**
  * Writes the current cache to consolidated data at the beginning of the backing store.
  * Does not clear the write log.
@@ -268,24 +728,9 @@ static wear_leveling_status_t wear_leveling_write_consolidated(void) {
         write_log_entry_t entry;
         entry.raw64 = fnv_64a_buf(wear_leveling.cache, (WEAR_LEVELING_LOGICAL_SIZE), FNV1A_64_INIT);
         wl_dprintf("Writing checksum\n");
-        do {
-#if BACKING_STORE_WRITE_SIZE == 2
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw16, 4)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 4
-            if (!backing_store_write_bulk((WEAR_LEVELING_LOGICAL_SIZE), entry.raw32, 2)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#elif BACKING_STORE_WRITE_SIZE == 8
-            if (!backing_store_write((WEAR_LEVELING_LOGICAL_SIZE), entry.raw64)) {
-                status = WEAR_LEVELING_FAILED;
-                break;
-            }
-#endif
-        } while (0);
+        if (!wear_leveling_write_header((WEAR_LEVELING_LOGICAL_SIZE), &entry)) {
+            status = WEAR_LEVELING_FAILED;
+        }
     }
 
     if (lock_status == STATUS_SUCCESS) {
@@ -316,10 +761,11 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     }
 
     // Next write of the log occurs after the consolidated values at the start of the backing store.
-    wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling_reset_log(WEAR_LEVELING_LOG_START);
 
     return status;
 }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Potential write of the current cache to the backing store.
@@ -329,26 +775,93 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
  * @return true if consolidation occurred
  */
 static wear_leveling_status_t wear_leveling_consolidate_if_needed(void) {
-    if (wear_leveling.write_address >= (WEAR_LEVELING_BACKING_SIZE)) {
+    const uint32_t end = wear_leveling_bank_base() + (WEAR_LEVELING_BANK_SIZE);
+    if (wear_leveling.write_address >= end) {
         return wear_leveling_consolidate_force();
     }
 
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    // Getting close, so start working towards it in the background
+    if (wear_leveling.consolidation == CONSOLIDATION_IDLE && end - wear_leveling.write_address <= (WEAR_LEVELING_CONSOLIDATION_RESERVE)) {
+        wear_leveling_consolidate_begin();
+    }
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+
     return WEAR_LEVELING_SUCCESS;
 }
 
 /**
- * Appends the supplied fixed-width entry to the write log, optionally consolidating if the log is full.
+ * Appends all staged log entries to the write log, optionally consolidating if the log is full.
+ * If consolidation occurs, any staged entries that did not fit are dropped -- their data is already
+ * part of the consolidated cache.
  *
  * @return true if consolidation occurred
  */
-static wear_leveling_status_t wear_leveling_append_raw(backing_store_int_t value) {
-    bool ok = backing_store_write(wear_leveling.write_address, value);
-    if (!ok) {
-        wl_dprintf("Failed to write to backing store\n");
-        return WEAR_LEVELING_FAILED;
+static wear_leveling_status_t wear_leveling_flush_staged(void) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    backing_store_int_t *  values = wear_leveling.staged;
+    size_t                 count  = wear_leveling.staged_count;
+    wear_leveling.staged_count    = 0;
+
+    while (count > 0) {
+        const size_t available   = (wear_leveling_bank_base() + (WEAR_LEVELING_BANK_SIZE) - wear_leveling.write_address) / (BACKING_STORE_WRITE_SIZE);
+        const size_t this_length = count < available ? count : available;
+        if (!backing_store_write_bulk(wear_leveling.write_address, values, this_length)) {
+            wl_dprintf("Failed to write to backing store\n");
+            return WEAR_LEVELING_FAILED;
+        }
+        wear_leveling.write_address += this_length * (BACKING_STORE_WRITE_SIZE);
+        values += this_length;
+        count -= this_length;
+
+        status = wear_leveling_consolidate_if_needed();
+        if (status != WEAR_LEVELING_SUCCESS) {
+            break;
+        }
     }
-    wear_leveling.write_address += (BACKING_STORE_WRITE_SIZE);
-    return wear_leveling_consolidate_if_needed();
+
+    return status;
+}
+
+/**
+ * Stages the supplied fixed-width log entry for appending to the write log. If the staging area is full,
+ * previously-staged entries are appended first, optionally consolidating if the log is full.
+ *
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_stage_raw(const backing_store_int_t *values, size_t count) {
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    if (wear_leveling.staged_count + count > sizeof(wear_leveling.staged) / sizeof(backing_store_int_t)) {
+        status = wear_leveling_flush_staged();
+        if (status != WEAR_LEVELING_SUCCESS) {
+            // If consolidation occurred, then this entry's data is already part of the consolidated area.
+            return status;
+        }
+    }
+    memcpy(&wear_leveling.staged[wear_leveling.staged_count], values, count * sizeof(backing_store_int_t));
+    wear_leveling.staged_count += count;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    wear_leveling.log_hash = fnv_32a_buf((void *)values, count * sizeof(backing_store_int_t), wear_leveling.log_hash);
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+    return status;
+}
+
+/**
+ * Stages the supplied log entry as per wear_leveling_stage_raw(), followed by a checkpoint if one is due.
+ *
+ * @return true if consolidation occurred
+ */
+static wear_leveling_status_t wear_leveling_append_raw(const backing_store_int_t *values, size_t count) {
+    wear_leveling_status_t status = wear_leveling_stage_raw(values, count);
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+    const uint32_t pending = wear_leveling.write_address + wear_leveling.staged_count * (BACKING_STORE_WRITE_SIZE);
+    if (status == WEAR_LEVELING_SUCCESS && pending - wear_leveling.checkpoint_address >= (WEAR_LEVELING_CHECKPOINT_INTERVAL)) {
+        write_log_entry_t checkpoint     = LOG_ENTRY_MAKE_CHECKPOINT(pending - (wear_leveling_bank_base() + WEAR_LEVELING_LOG_START), wear_leveling.log_hash);
+        wear_leveling.checkpoint_address = pending + sizeof(write_log_entry_t);
+        status                           = wear_leveling_stage_raw((backing_store_int_t *)checkpoint.raw8, sizeof(write_log_entry_t) / (BACKING_STORE_WRITE_SIZE));
+    }
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+    return status;
 }
 
 /**
@@ -364,50 +877,13 @@ static wear_leveling_status_t wear_leveling_write_raw_multibyte(uint32_t address
     }
 
     // Write to the backing store. See the multi-byte log format in the documentation header at the top of the file.
-    wear_leveling_status_t status;
 #if BACKING_STORE_WRITE_SIZE == 2
-    status = wear_leveling_append_raw(log.raw16[0]);
-    if (status != WEAR_LEVELING_SUCCESS) {
-        return status;
-    }
-
-    status = wear_leveling_append_raw(log.raw16[1]);
-    if (status != WEAR_LEVELING_SUCCESS) {
-        return status;
-    }
-
-    if (length > 1) {
-        status = wear_leveling_append_raw(log.raw16[2]);
-        if (status != WEAR_LEVELING_SUCCESS) {
-            return status;
-        }
-    }
-
-    if (length > 3) {
-        status = wear_leveling_append_raw(log.raw16[3]);
-        if (status != WEAR_LEVELING_SUCCESS) {
-            return status;
-        }
-    }
+    return wear_leveling_append_raw(log.raw16, 2 + (length > 1 ? 1 : 0) + (length > 3 ? 1 : 0));
 #elif BACKING_STORE_WRITE_SIZE == 4
-    status = wear_leveling_append_raw(log.raw32[0]);
-    if (status != WEAR_LEVELING_SUCCESS) {
-        return status;
-    }
-
-    if (length > 1) {
-        status = wear_leveling_append_raw(log.raw32[1]);
-        if (status != WEAR_LEVELING_SUCCESS) {
-            return status;
-        }
-    }
+    return wear_leveling_append_raw(log.raw32, 1 + (length > 1 ? 1 : 0));
 #elif BACKING_STORE_WRITE_SIZE == 8
-    status = wear_leveling_append_raw(log.raw64);
-    if (status != WEAR_LEVELING_SUCCESS) {
-        return status;
-    }
+    return wear_leveling_append_raw(&log.raw64, 1);
 #endif
-    return status;
 }
 
 /**
@@ -424,7 +900,7 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
             const uint16_t v = ((uint16_t)p[1]) << 8 | p[0]; // don't just dereference a uint16_t here -- if unaligned it generates faults on some MCUs
             if (v == 0 || v == 1) {
                 const write_log_entry_t log = LOG_ENTRY_MAKE_WORD_01(address, v);
-                status                      = wear_leveling_append_raw(log.raw16[0]);
+                status                      = wear_leveling_append_raw(log.raw16, 1);
                 if (status != WEAR_LEVELING_SUCCESS) {
                     // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
                     // If a failure occurred, pass it on.
@@ -441,7 +917,7 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
         // Small-write optimizations - address<64:
         if (address < 64) {
             const write_log_entry_t log = LOG_ENTRY_MAKE_OPTIMIZED_64(address, *p);
-            status                      = wear_leveling_append_raw(log.raw16[0]);
+            status                      = wear_leveling_append_raw(log.raw16, 1);
             if (status != WEAR_LEVELING_SUCCESS) {
                 // If consolidation occurred, then the cache has already been written to the consolidated area. No need to continue.
                 // If a failure occurred, pass it on.
@@ -470,131 +946,169 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
 }
 
 /**
- * "Replays" the write log from the backing store, updating the local cache with updated values.
+ * Number of backing store words taken up by the write log entry starting with the supplied word.
  */
-static wear_leveling_status_t wear_leveling_playback_log(void) {
-    wl_dprintf("Playback write log\n");
-
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
-    while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
-        backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
-        if (!ok) {
-            wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-            cancel_playback = true;
-            status          = WEAR_LEVELING_FAILED;
-            break;
-        }
-        if (value == 0) {
-            wl_dprintf("Found empty slot, no more log entries\n");
-            cancel_playback = true;
-            break;
-        }
-
-        // If we got a nonzero value, then we need to increment the address to ensure next write occurs at next location
-        address += (BACKING_STORE_WRITE_SIZE);
-
-        // Read from the write log
-        write_log_entry_t log;
+static size_t wear_leveling_entry_words(backing_store_int_t first) {
+    write_log_entry_t log = {.raw64 = 0};
+    memcpy(log.raw8, &first, sizeof(first));
+    switch (LOG_ENTRY_GET_TYPE(log)) {
+        case LOG_ENTRY_TYPE_MULTIBYTE: {
+            // See the multi-byte log format in the documentation header at the top of the file.
+            const uint8_t l = LOG_ENTRY_MULTIBYTE_GET_LENGTH(log);
 #if BACKING_STORE_WRITE_SIZE == 2
-        log.raw16[0] = value;
+            return 2 + (l > 1 ? 1 : 0) + (l > 3 ? 1 : 0);
 #elif BACKING_STORE_WRITE_SIZE == 4
-        log.raw32[0] = value;
+            return 1 + (l > 1 ? 1 : 0);
 #elif BACKING_STORE_WRITE_SIZE == 8
-        log.raw64 = value;
+            (void)l;
+            return 1;
 #endif
+        }
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+        case LOG_ENTRY_TYPE_CHECKPOINT:
+            return sizeof(write_log_entry_t) / (BACKING_STORE_WRITE_SIZE);
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+        default:
+            return 1;
+    }
+}
 
-        switch (LOG_ENTRY_GET_TYPE(log)) {
-            case LOG_ENTRY_TYPE_MULTIBYTE: {
+/**
+ * Updates the cache with a single write log entry read back from the backing store.
+ *
+ * @return false if the entry is invalid
+ */
+static bool wear_leveling_apply_entry(const backing_store_int_t *words, size_t count) {
+    write_log_entry_t log = {.raw64 = 0};
+    memcpy(log.raw8, words, count * sizeof(backing_store_int_t));
+    switch (LOG_ENTRY_GET_TYPE(log)) {
+        case LOG_ENTRY_TYPE_MULTIBYTE: {
+            const uint32_t a = LOG_ENTRY_MULTIBYTE_GET_ADDRESS(log);
+            const uint8_t  l = LOG_ENTRY_MULTIBYTE_GET_LENGTH(log);
+
+            if (a + l > (WEAR_LEVELING_LOGICAL_SIZE)) {
+                return false;
+            }
+
+            memcpy(&wear_leveling.cache[a], &log.raw8[3], l);
+        } break;
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
-                if (!ok) {
-                    wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-                    cancel_playback = true;
-                    status          = WEAR_LEVELING_FAILED;
-                    break;
-                }
-                address += (BACKING_STORE_WRITE_SIZE);
-#endif // BACKING_STORE_WRITE_SIZE == 2
-                const uint32_t a = LOG_ENTRY_MULTIBYTE_GET_ADDRESS(log);
-                const uint8_t  l = LOG_ENTRY_MULTIBYTE_GET_LENGTH(log);
+        case LOG_ENTRY_TYPE_OPTIMIZED_64: {
+            const uint32_t a = LOG_ENTRY_OPTIMIZED_64_GET_ADDRESS(log);
+            const uint8_t  v = LOG_ENTRY_OPTIMIZED_64_GET_VALUE(log);
 
-                if (a + l > (WEAR_LEVELING_LOGICAL_SIZE)) {
-                    cancel_playback = true;
-                    status          = WEAR_LEVELING_FAILED;
-                    break;
-                }
+            if (a >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                return false;
+            }
 
-#if BACKING_STORE_WRITE_SIZE == 2
-                if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
-                    if (!ok) {
-                        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-                        cancel_playback = true;
-                        status          = WEAR_LEVELING_FAILED;
-                        break;
-                    }
-                    address += (BACKING_STORE_WRITE_SIZE);
-                }
-                if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
-                    if (!ok) {
-                        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-                        cancel_playback = true;
-                        status          = WEAR_LEVELING_FAILED;
-                        break;
-                    }
-                    address += (BACKING_STORE_WRITE_SIZE);
-                }
-#elif BACKING_STORE_WRITE_SIZE == 4
-                if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
-                    if (!ok) {
-                        wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
-                        cancel_playback = true;
-                        status = WEAR_LEVELING_FAILED;
-                        break;
-                    }
-                    address += (BACKING_STORE_WRITE_SIZE);
-                }
-#endif
+            wear_leveling.cache[a] = v;
+        } break;
+        case LOG_ENTRY_TYPE_WORD_01: {
+            const uint32_t a = LOG_ENTRY_WORD_01_GET_ADDRESS(log);
+            const uint8_t  v = LOG_ENTRY_WORD_01_GET_VALUE(log);
 
-                memcpy(&wear_leveling.cache[a], &log.raw8[3], l);
-            } break;
-#if BACKING_STORE_WRITE_SIZE == 2
-            case LOG_ENTRY_TYPE_OPTIMIZED_64: {
-                const uint32_t a = LOG_ENTRY_OPTIMIZED_64_GET_ADDRESS(log);
-                const uint8_t  v = LOG_ENTRY_OPTIMIZED_64_GET_VALUE(log);
+            if (a + 1 >= (WEAR_LEVELING_LOGICAL_SIZE)) {
+                return false;
+            }
+
+            wear_leveling.cache[a + 0] = v;
+            wear_leveling.cache[a + 1] = 0;
+        } break;
+#endif // BACKING_STORE_WRITE_SIZE == 2
+        default:
+            return false;
+    }
+    return true;
+}
 
-                if (a >= (WEAR_LEVELING_LOGICAL_SIZE)) {
-                    cancel_playback = true;
-                    status          = WEAR_LEVELING_FAILED;
+/**
+ * "Replays" the write log from the backing store, updating the local cache with updated values.
+ */
+static wear_leveling_status_t wear_leveling_playback_log(void) {
+    wl_dprintf("Playback write log\n");
+
+    const uint32_t         end     = wear_leveling_bank_base() + (WEAR_LEVELING_BANK_SIZE);
+    wear_leveling_status_t status  = WEAR_LEVELING_SUCCESS;
+    uint32_t               address = wear_leveling_bank_base() + WEAR_LEVELING_LOG_START;
+    bool                   done    = false;
+    wear_leveling_reset_log(address);
+    while (!done && address < end) {
+        backing_store_int_t buffer[(WEAR_LEVELING_PLAYBACK_BUFFER_SIZE) / (BACKING_STORE_WRITE_SIZE)];
+        const size_t        available = (end - address) / (BACKING_STORE_WRITE_SIZE);
+        const size_t        count     = available < sizeof(buffer) / sizeof(buffer[0]) ? available : sizeof(buffer) / sizeof(buffer[0]);
+        if (!backing_store_read_bulk(address, buffer, count)) {
+            wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
+            status = WEAR_LEVELING_FAILED;
+            break;
+        }
+
+        // Find the complete entries in the buffer, stopping early at a checkpoint
+        size_t used = 0;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+        size_t checkpoint = count;
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+        while (used < count && buffer[used] != 0) {
+            const size_t words = wear_leveling_entry_words(buffer[used]);
+            if (used + words > count) {
+                break;
+            }
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+            write_log_entry_t log = {.raw64 = 0};
+            memcpy(log.raw8, &buffer[used], sizeof(buffer[used]));
+            if (LOG_ENTRY_GET_TYPE(log) == LOG_ENTRY_TYPE_CHECKPOINT) {
+                // Whether it's the last entry in the log isn't known until the word after it has been read
+                if (used + words == count && address + count * (BACKING_STORE_WRITE_SIZE) < end) {
                     break;
                 }
+                checkpoint = used;
+                used += words;
+                break;
+            }
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+            used += words;
+        }
 
-                wear_leveling.cache[a] = v;
-            } break;
-            case LOG_ENTRY_TYPE_WORD_01: {
-                const uint32_t a = LOG_ENTRY_WORD_01_GET_ADDRESS(log);
-                const uint8_t  v = LOG_ENTRY_WORD_01_GET_VALUE(log);
+        // Nothing further once an empty slot, the end of the bank, or an entry cut off by the end of the bank is found
+        done = used == 0 || (used < count && buffer[used] == 0) || address + used * (BACKING_STORE_WRITE_SIZE) >= end;
+        if (done && used < count && buffer[used] == 0) {
+            wl_dprintf("Found empty slot, no more log entries\n");
+        }
 
-                if (a + 1 >= (WEAR_LEVELING_LOGICAL_SIZE)) {
-                    cancel_playback = true;
-                    status          = WEAR_LEVELING_FAILED;
-                    break;
+        size_t apply = used;
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+        if (checkpoint < count) {
+            write_log_entry_t log = {.raw64 = 0};
+            memcpy(log.raw8, &buffer[checkpoint], sizeof(write_log_entry_t));
+            const uint32_t hash = fnv_32a_buf(buffer, checkpoint * sizeof(backing_store_int_t), wear_leveling.log_hash);
+            apply               = checkpoint;
+            if (LOG_ENTRY_CHECKPOINT_GET_HASH(log) == hash && LOG_ENTRY_CHECKPOINT_GET_OFFSET(log) == address + checkpoint * (BACKING_STORE_WRITE_SIZE) - (wear_leveling_bank_base() + WEAR_LEVELING_LOG_START)) {
+                wear_leveling.checkpoint_address = address + used * (BACKING_STORE_WRITE_SIZE);
+            } else {
+                // A torn checkpoint at the end of the log still leaves the entries before it as they were written
+                wl_dprintf("Checkpoint mismatch, %s\n", done ? "assuming it was torn" : "dropping the rest of the write log");
+                if (!done) {
+                    apply = 0;
                 }
+                status = WEAR_LEVELING_FAILED;
+                done   = true;
+            }
+        }
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
 
-                wear_leveling.cache[a + 0] = v;
-                wear_leveling.cache[a + 1] = 0;
-            } break;
-#endif // BACKING_STORE_WRITE_SIZE == 2
-            default: {
-                cancel_playback = true;
-                status          = WEAR_LEVELING_FAILED;
-            } break;
+        for (size_t i = 0; i < apply;) {
+            const size_t words = wear_leveling_entry_words(buffer[i]);
+            if (!wear_leveling_apply_entry(&buffer[i], words)) {
+                status = WEAR_LEVELING_FAILED;
+                done   = true;
+                break;
+            }
+            i += words;
         }
+
+#ifdef WEAR_LEVELING_CHECKPOINT_INTERVAL
+        wear_leveling.log_hash = fnv_32a_buf(buffer, used * sizeof(backing_store_int_t), wear_leveling.log_hash);
+#endif // WEAR_LEVELING_CHECKPOINT_INTERVAL
+        address += used * (BACKING_STORE_WRITE_SIZE);
     }
 
     // We've reached the end of the log, so we're at the new write location
@@ -671,6 +1185,112 @@ wear_leveling_status_t wear_leveling_erase(void) {
     return ret ? WEAR_LEVELING_SUCCESS : WEAR_LEVELING_FAILED;
 }
 
+/**
+ * Updates the cache with new logical data.
+ */
+static inline void wear_leveling_update_cache(uint32_t address, const void *value, size_t length) {
+    memcpy(&wear_leveling.cache[address], value, length);
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    wear_leveling_consolidate_mark(address, length);
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
+/**
+ * Finds the next run of data that differs from the cache, at or after the given offset into the write. Comparisons are
+ * done two bytes at a time relative to the start of the write, so that 16-bit values such as keycodes are never split
+ * across log entries.
+ *
+ * @return false if nothing else differs
+ */
+static bool wear_leveling_next_changed_run(const uint32_t address, const uint8_t *p, size_t length, size_t offset, size_t *start, size_t *end) {
+    size_t s = offset;
+    while (s < length && memcmp(&p[s], &wear_leveling.cache[address + s], (length - s) < 2 ? 1 : 2) == 0) {
+        s += 2;
+    }
+    if (s >= length) {
+        return false;
+    }
+
+    size_t e = s;
+    while (e < length && memcmp(&p[e], &wear_leveling.cache[address + e], (length - e) < 2 ? 1 : 2) != 0) {
+        e += 2;
+    }
+    *start = s;
+    *end   = e > length ? length : e;
+    return true;
+}
+
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+/**
+ * Records a changed range of the cache for the next sync, merging it into any pending range it overlaps or touches.
+ * If every range is in use, the pending ranges are synced first.
+ *
+ * @return status of the sync, if one occurred
+ */
+static wear_leveling_status_t wear_leveling_defer(uint32_t start, uint32_t end) {
+    wear_leveling.stats.deferred++;
+
+    size_t index;
+    for (index = 0; index < wear_leveling.dirty_count; ++index) {
+        if (start <= wear_leveling.dirty[index].end && wear_leveling.dirty[index].start <= end) {
+            break;
+        }
+    }
+
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    if (index < wear_leveling.dirty_count) {
+        wear_leveling.stats.coalesced++;
+    } else if (wear_leveling.dirty_count < (WEAR_LEVELING_WRITEBACK_RANGES) || (status = wear_leveling_sync()) != WEAR_LEVELING_FAILED) {
+        index                            = wear_leveling.dirty_count++;
+        wear_leveling.dirty[index].start = start;
+        wear_leveling.dirty[index].end   = end;
+    } else {
+        // The sync failed and left every range pending, so widen one of them instead
+        index = 0;
+    }
+
+    if (start < wear_leveling.dirty[index].start) {
+        wear_leveling.dirty[index].start = start;
+    }
+    if (end > wear_leveling.dirty[index].end) {
+        wear_leveling.dirty[index].end = end;
+    }
+
+    // The grown range may now reach others, absorb them
+    for (size_t i = 0; i < wear_leveling.dirty_count;) {
+        if (i != index && wear_leveling.dirty[i].start <= wear_leveling.dirty[index].end && wear_leveling.dirty[index].start <= wear_leveling.dirty[i].end) {
+            if (wear_leveling.dirty[i].start < wear_leveling.dirty[index].start) {
+                wear_leveling.dirty[index].start = wear_leveling.dirty[i].start;
+            }
+            if (wear_leveling.dirty[i].end > wear_leveling.dirty[index].end) {
+                wear_leveling.dirty[index].end = wear_leveling.dirty[i].end;
+            }
+            wear_leveling.dirty[i] = wear_leveling.dirty[--wear_leveling.dirty_count];
+            if (index == wear_leveling.dirty_count) {
+                index = i;
+            }
+            i = 0;
+            continue;
+        }
+        ++i;
+    }
+
+    return status;
+}
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
+
+/**
+ * Copies the runs of a failed write that haven't reached the cache yet, starting at the given offset into the write.
+ * Reads always reflect the whole write, even when none or only part of it could be persisted.
+ */
+static void wear_leveling_cache_remaining_runs(uint32_t address, const uint8_t *p, size_t length, size_t offset) {
+    size_t start, end;
+    while (wear_leveling_next_changed_run(address, p, length, offset, &start, &end)) {
+        wear_leveling_update_cache(address + start, &p[start], end - start);
+        offset = end;
+    }
+}
+
 /**
  * Writes logical data into the backing store. Skips writes if there are no changes to values.
  */
@@ -688,18 +1308,62 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
         return true;
     }
 
-    // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
-    memcpy(&wear_leveling.cache[address], value, length);
+    const uint8_t *p = value;
+    size_t         start, end;
+
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+    // Only record what changed, the write log is appended to on the next sync
+    wear_leveling_status_t deferred_status = WEAR_LEVELING_SUCCESS;
+    size_t                 deferred_offset = 0;
+    while (wear_leveling_next_changed_run(address, p, length, deferred_offset, &start, &end)) {
+        wear_leveling_update_cache(address + start, &p[start], end - start);
+        wear_leveling_status_t this_status = wear_leveling_defer(address + (uint32_t)start, address + (uint32_t)end);
+        if (this_status != WEAR_LEVELING_SUCCESS && deferred_status != WEAR_LEVELING_FAILED) {
+            deferred_status = this_status;
+        }
+        deferred_offset = end;
+    }
+    return deferred_status;
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
 
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
+        wear_leveling_cache_remaining_runs(address, p, length, 0);
         wear_leveling_lock();
         return WEAR_LEVELING_FAILED;
     }
 
-    // Perform the actual write
-    wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
+    // Perform the actual write, only logging the runs of data that changed
+    bool                   consolidated = false;
+    wear_leveling_status_t status       = WEAR_LEVELING_SUCCESS;
+    size_t                 offset       = 0;
+    while (wear_leveling_next_changed_run(address, p, length, offset, &start, &end)) {
+        // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
+        wear_leveling_update_cache(address + start, &p[start], end - start);
+
+        status = wear_leveling_write_raw(address + (uint32_t)start, &p[start], end - start);
+        if (status == WEAR_LEVELING_FAILED) {
+            break;
+        }
+        if (status == WEAR_LEVELING_CONSOLIDATED) {
+            // Later runs are not in the consolidated area yet, so keep going with the fresh write log
+            consolidated = true;
+        }
+        offset = end;
+    }
+
+    // Append everything that was staged in as few backing store writes as possible
+    if (status != WEAR_LEVELING_FAILED) {
+        status = wear_leveling_flush_staged();
+        if (status == WEAR_LEVELING_SUCCESS && consolidated) {
+            status = WEAR_LEVELING_CONSOLIDATED;
+        }
+    } else {
+        wear_leveling.staged_count = 0;
+        wear_leveling_cache_remaining_runs(address, p, length, offset);
+    }
+
     switch (status) {
         case WEAR_LEVELING_CONSOLIDATED:
         case WEAR_LEVELING_FAILED:
@@ -726,6 +1390,119 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+/**
+ * Appends any ranges held back by write-back to the write log.
+ */
+wear_leveling_status_t wear_leveling_sync(void) {
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+    if (wear_leveling.dirty_count == 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    wl_dprintf("Sync %d ranges\n", (int)wear_leveling.dirty_count);
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    // The cache already holds the new data. If the log fills up part way, consolidation writes out the whole cache,
+    // which includes every range that's still pending.
+    wear_leveling_status_t status = WEAR_LEVELING_SUCCESS;
+    for (size_t i = 0; i < wear_leveling.dirty_count && status == WEAR_LEVELING_SUCCESS; ++i) {
+        status = wear_leveling_write_raw(wear_leveling.dirty[i].start, &wear_leveling.cache[wear_leveling.dirty[i].start], wear_leveling.dirty[i].end - wear_leveling.dirty[i].start);
+    }
+
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_flush_staged();
+    }
+    if (status == WEAR_LEVELING_SUCCESS) {
+        status = wear_leveling_consolidate_if_needed();
+    }
+
+    if (status != WEAR_LEVELING_FAILED) {
+        wear_leveling.dirty_count = 0;
+        wear_leveling.stats.syncs++;
+    } else {
+        // Keep the ranges pending, appending them again on the next sync is harmless
+        wear_leveling.staged_count = 0;
+    }
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
+}
+
+/**
+ * Whether there is data waiting for wear_leveling_sync().
+ */
+bool wear_leveling_sync_pending(void) {
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+    return wear_leveling.dirty_count > 0;
+#else
+    return false;
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
+}
+
+/**
+ * Copies out the write-back counters.
+ */
+void wear_leveling_get_writeback_stats(wear_leveling_writeback_stats_t *stats) {
+#ifdef WEAR_LEVELING_WRITEBACK_ENABLE
+    *stats = wear_leveling.stats;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif // WEAR_LEVELING_WRITEBACK_ENABLE
+}
+
+/**
+ * Performs one step of any consolidation in progress.
+ */
+wear_leveling_status_t wear_leveling_task(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    if (wear_leveling.consolidation == CONSOLIDATION_IDLE) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    backing_store_lock_status_t lock_status = wear_leveling_unlock();
+    if (lock_status == STATUS_FAILURE) {
+        wear_leveling_lock();
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wear_leveling_status_t status = wear_leveling_consolidate_step();
+
+    if (lock_status == STATUS_SUCCESS) {
+        if (wear_leveling_lock() == STATUS_FAILURE) {
+            status = WEAR_LEVELING_FAILED;
+        }
+    }
+
+    return status;
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
+/**
+ * Whether a consolidation has begun and wear_leveling_task() has more steps to perform.
+ */
+bool wear_leveling_consolidation_pending(void) {
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+    return wear_leveling.consolidation != CONSOLIDATION_IDLE;
+#else
+    return false;
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+}
+
 /**
  * Reads logical data from the cache.
  */
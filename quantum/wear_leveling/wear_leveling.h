@@ -1,6 +1,7 @@
 // Copyright 2022 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 #pragma once
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 
@@ -36,6 +37,8 @@ wear_leveling_status_t wear_leveling_erase(void);
  * determine if an overwrite should occur -- if there is any data mismatch the entire block will be written to the log,
  * not just the changed bytes.
  *
+ * With WEAR_LEVELING_WRITEBACK_ENABLE defined, only the cache is updated and the data is logged by wear_leveling_sync().
+ *
  * @param address[in] the logical address to write data
  * @param value[in] pointer to the source buffer
  * @param length[in] length of the data
@@ -52,3 +55,49 @@ wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value,
  * @return Status of the request
  */
 wear_leveling_status_t wear_leveling_read(uint32_t address, void* value, size_t length);
+
+/**
+ * @typedef Counters kept while write-back is enabled.
+ */
+typedef struct wear_leveling_writeback_stats_t {
+    uint32_t deferred;  //< Changed runs held back instead of being logged
+    uint32_t coalesced; //< Of those, the runs merged into an already pending range
+    uint32_t syncs;     //< Syncs that appended pending ranges to the write log
+} wear_leveling_writeback_stats_t;
+
+/**
+ * Appends any data held back by write-back to the write log.
+ *
+ * Does nothing unless WEAR_LEVELING_WRITEBACK_ENABLE is defined, as every write is logged immediately otherwise.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_sync(void);
+
+/**
+ * Whether there is data waiting to be appended by wear_leveling_sync().
+ */
+bool wear_leveling_sync_pending(void);
+
+/**
+ * Retrieves the write-back counters, which are all zero unless WEAR_LEVELING_WRITEBACK_ENABLE is defined.
+ *
+ * @param stats[out] pointer to the destination
+ */
+void wear_leveling_get_writeback_stats(wear_leveling_writeback_stats_t* stats);
+
+/**
+ * Performs one step of an incremental consolidation, if one is in progress.
+ *
+ * Does nothing unless WEAR_LEVELING_INCREMENTAL_CONSOLIDATION is defined. Each step erases at most one erase unit of
+ * the backing store, or programs at most WEAR_LEVELING_CONSOLIDATION_STEP_SIZE bytes, so this is intended to be called
+ * periodically from the main loop.
+ *
+ * @return Status of the request, WEAR_LEVELING_CONSOLIDATED once the consolidation completes
+ */
+wear_leveling_status_t wear_leveling_task(void);
+
+/**
+ * Whether an incremental consolidation is in progress.
+ */
+bool wear_leveling_consolidation_pending(void);
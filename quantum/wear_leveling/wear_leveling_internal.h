@@ -75,6 +75,9 @@ bool backing_store_write_bulk(uint32_t address, backing_store_int_t* values, siz
 bool backing_store_lock(void);
 bool backing_store_read(uint32_t address, backing_store_int_t* value);
 bool backing_store_read_bulk(uint32_t address, backing_store_int_t* values, size_t item_count); // weak implementation already provided, optimized implementation can be implemented by driver
+#ifdef WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
+bool backing_store_erase_partial(uint32_t address, uint32_t* erased_length); // erases the erase unit starting at address, reporting its size -- only needed for incremental consolidation
+#endif // WEAR_LEVELING_INCREMENTAL_CONSOLIDATION
 
 /**
  * Helper type used to contain a write log entry.
@@ -101,6 +104,9 @@ enum {
     // 0x02 -- 2-byte backing store write optimization: word-encoded 0/1 values
     LOG_ENTRY_TYPE_WORD_01,
 
+    // 0x03 -- Checkpoint: offset and FNV1a_32 of the preceding write log
+    LOG_ENTRY_TYPE_CHECKPOINT,
+
     LOG_ENTRY_TYPES
 };
 
@@ -149,3 +155,19 @@ _Static_assert(LOG_ENTRY_TYPES <= (1 << 2), "Too many log entry types to fit int
             [1] = (uint8_t)((address) >> 1), /* address */                                            \
         }                                                                                             \
     }
+
+#define LOG_ENTRY_CHECKPOINT_GET_OFFSET(entry) ((((uint32_t)((entry).raw8[1])) << 16) | (((uint32_t)((entry).raw8[2])) << 8) | (entry).raw8[3])
+#define LOG_ENTRY_CHECKPOINT_GET_HASH(entry) ((((uint32_t)((entry).raw8[4])) << 24) | (((uint32_t)((entry).raw8[5])) << 16) | (((uint32_t)((entry).raw8[6])) << 8) | (entry).raw8[7])
+#define LOG_ENTRY_MAKE_CHECKPOINT(offset, hash)                                                         \
+    (write_log_entry_t) {                                                                               \
+        .raw8 = {                                                                                       \
+            [0] = ((((uint8_t)LOG_ENTRY_TYPE_CHECKPOINT) & BITMASK_FOR_BITCOUNT(2)) << 6), /* type */   \
+            [1] = (((uint8_t)((offset) >> 16)) & BITMASK_FOR_BITCOUNT(8)),                 /* offset */ \
+            [2] = (((uint8_t)((offset) >> 8)) & BITMASK_FOR_BITCOUNT(8)),                  /* offset */ \
+            [3] = (((uint8_t)(offset)) & BITMASK_FOR_BITCOUNT(8)),                         /* offset */ \
+            [4] = ((uint8_t)((hash) >> 24)),                                               /* hash */   \
+            [5] = ((uint8_t)((hash) >> 16)),                                               /* hash */   \
+            [6] = ((uint8_t)((hash) >> 8)),                                                /* hash */   \
+            [7] = ((uint8_t)(hash)),                                                       /* hash */   \
+        }                                                                                               \
+    }
@@ -0,0 +1,44 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+#include <string.h>
+
+#include "benchmark_combos.h"
+
+// Keys the generated combos are built from
+const uint16_t benchmark_combo_pool[] = {
+    KC_A, KC_B, KC_C, KC_D, KC_E, KC_F, KC_G, KC_H, KC_I, KC_J, KC_K, KC_L, KC_M, KC_N, KC_O,
+    KC_P, KC_Q, KC_R, KC_S, KC_T, KC_U, KC_V, KC_W, KC_X, KC_Y, KC_Z, KC_1, KC_2, KC_3, KC_4,
+};
+#define BENCHMARK_COMBO_POOL_SIZE (sizeof(benchmark_combo_pool) / sizeof(benchmark_combo_pool[0]))
+
+static uint16_t benchmark_combo_keys[BENCHMARK_COMBO_MAX][4];
+static uint16_t benchmark_combo_count = 0;
+
+extern combo_t key_combos[BENCHMARK_COMBO_MAX];
+
+uint16_t combo_count(void) {
+    return benchmark_combo_count;
+}
+
+// Fills the first `count` combos with distinct three key chords
+void benchmark_combos_init(uint16_t count) {
+    memset(benchmark_combo_keys, 0, sizeof(benchmark_combo_keys));
+    memset(key_combos, 0, sizeof(key_combos));
+
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t first = i % BENCHMARK_COMBO_POOL_SIZE;
+        uint16_t step  = (i / BENCHMARK_COMBO_POOL_SIZE) % 14;
+
+        benchmark_combo_keys[i][0] = benchmark_combo_pool[first];
+        benchmark_combo_keys[i][1] = benchmark_combo_pool[(first + 1 + step) % BENCHMARK_COMBO_POOL_SIZE];
+        benchmark_combo_keys[i][2] = benchmark_combo_pool[(first + 15 + step) % BENCHMARK_COMBO_POOL_SIZE];
+        benchmark_combo_keys[i][3] = COMBO_END;
+
+        key_combos[i].keys    = benchmark_combo_keys[i];
+        key_combos[i].keycode = KC_F1 + (i % 12);
+    }
+
+    benchmark_combo_count = count;
+    combo_index_rebuild();
+}
@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#pragma once
+
+#include <stdint.h>
+
+#define BENCHMARK_COMBO_MAX 256
+
+void benchmark_combos_init(uint16_t count);
@@ -0,0 +1,7 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+#include "benchmark_combos.h"
+
+// Filled in at runtime by benchmark_combos_init()
+combo_t key_combos[BENCHMARK_COMBO_MAX];
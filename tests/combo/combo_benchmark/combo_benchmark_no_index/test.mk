@@ -0,0 +1,8 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = ../benchmark_keymap.c
+
+SRC += ../benchmark_combos.c ../test_combo_benchmark.cpp
@@ -0,0 +1,79 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "benchmark_combos.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+class ComboBenchmark : public ::testing::WithParamInterface<uint16_t>, public TestFixture {
+   protected:
+    void SetUp() override {
+        benchmark_combos_init(GetParam());
+    }
+
+    static void report(const char *name, uint32_t events, std::chrono::steady_clock::duration elapsed) {
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        std::cout << GetParam() << " combos, " << name << ": " << (uint64_t)(ns / events) << " ns/event" << std::endl;
+    }
+};
+
+// clang-format off
+INSTANTIATE_TEST_CASE_P(
+    Combos,
+    ComboBenchmark,
+    ::testing::Values(8, 64, 256),
+    [](const ::testing::TestParamInfo<uint16_t>& info) {
+        return std::to_string(info.param);
+    }
+);
+// clang-format on
+
+// Typing keys that aren't part of any combo only runs the combo engine.
+TEST_P(ComboBenchmark, NonComboKey) {
+    const uint32_t iterations = 100000;
+    keyrecord_t    press      = {};
+    press.event.key           = {.col = 0, .row = 1};
+    press.event.type          = KEY_EVENT;
+    press.event.pressed       = true;
+    keyrecord_t release       = press;
+    release.event.pressed     = false;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        EXPECT_TRUE(process_combo(KC_F13, &press));
+        EXPECT_TRUE(process_combo(KC_F13, &release));
+    }
+    report("non-combo key", iterations * 2, std::chrono::steady_clock::now() - start);
+}
+
+// Tapping a key that is part of some combos goes through the whole keyboard
+// pipeline, including buffering and replaying the key.
+TEST_P(ComboBenchmark, ComboKeyTap) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 0, KC_A);
+    set_keymap({key_a});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    const uint32_t iterations = 2000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        key_a.press();
+        run_one_scan_loop();
+        key_a.release();
+        run_one_scan_loop();
+    }
+    report("combo key tap", iterations * 2, std::chrono::steady_clock::now() - start);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,48 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "process_combo.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class ComboNoTimer : public TestFixture {};
+
+TEST_F(ComboNoTimer, combo_modtest_tapped) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_u});
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(is_combo_pending());
+}
+
+TEST_F(ComboNoTimer, lone_combo_key_is_pending_until_released) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+
+    // Without a timer a lone combo key is only resolved by its release
+    EXPECT_NO_REPORT(driver);
+    key_y.press();
+    idle_for(COMBO_TERM * 2);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(is_combo_pending());
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    key_y.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(is_combo_pending());
+}
@@ -2,5 +2,6 @@
 # SPDX-License-Identifier: GPL-2.0-or-later
 
 COMBO_ENABLE = yes
+LATENCY_TRACING_ENABLE = yes
 
 INTROSPECTION_KEYMAP_C = test_combos.c
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "keyboard_report_util.hpp"
+#include "latency_util.hpp"
 #include "quantum.h"
 #include "keycode.h"
 #include "test_common.h"
@@ -55,3 +56,33 @@ TEST_F(Combo, combo_osmshift_tapped) {
     tap_key(key_i);
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(Combo, combo_latency_within_budget) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_u});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_LATENCY_WITHIN(LATENCY_PATH_COMBO, COMBO_TERM);
+}
+
+TEST_F(Combo, key_held_back_by_combo_latency_within_budget) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+
+    // A lone combo key is held back until it is released
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_y, COMBO_TERM / 2);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_LATENCY_WITHIN(LATENCY_PATH_COMBO, COMBO_TERM / 2);
+    EXPECT_FALSE(LatencyWithinBudget(LATENCY_PATH_COMBO, COMBO_TERM / 2 - 2));
+}
@@ -0,0 +1,200 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include "gtest/gtest.h"
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeconfig.h"
+#include "eeprom.h"
+#include "keycodes.h"
+#include "quantum_keycodes.h"
+#include "send_string_keycodes.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class DynamicKeymap : public testing::Test {
+   protected:
+    void SetUp() override {
+        eeconfig_init_quantum();
+        dynamic_keymap_reset();
+        dynamic_keymap_init();
+    }
+};
+
+TEST_F(DynamicKeymap, SetKeycodeIsStoredBigEndian) {
+    dynamic_keymap_set_keycode(1, 2, 3, LT(1, KC_A));
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), LT(1, KC_A));
+
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(1, 2, 3);
+    EXPECT_EQ(eeprom_read_byte(address), LT(1, KC_A) >> 8);
+    EXPECT_EQ(eeprom_read_byte(address + 1), LT(1, KC_A) & 0xFF);
+}
+
+TEST_F(DynamicKeymap, InitLoadsKeymapFromEeprom) {
+    uint8_t *address = (uint8_t *)dynamic_keymap_key_to_eeprom_address(3, 1, 9);
+    eeprom_update_byte(address, KC_LEFT_SHIFT >> 8);
+    eeprom_update_byte(address + 1, KC_LEFT_SHIFT & 0xFF);
+
+    dynamic_keymap_init();
+    EXPECT_EQ(dynamic_keymap_get_keycode(3, 1, 9), KC_LEFT_SHIFT);
+}
+
+TEST_F(DynamicKeymap, SetBufferUpdatesLookups) {
+    // Layer 0, row 1, columns 0 and 1
+    uint16_t offset  = MATRIX_COLS * 2;
+    uint8_t  data[4] = {MO(2) >> 8, MO(2) & 0xFF, KC_B >> 8, KC_B & 0xFF};
+    dynamic_keymap_set_buffer(offset, sizeof(data), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 0), MO(2));
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_B);
+
+    // Misaligned write touching the low byte of column 1 and the high byte of column 2
+    dynamic_keymap_set_keycode(0, 1, 2, KC_C);
+    uint8_t misaligned[2] = {KC_D & 0xFF, LCTL(KC_C) >> 8};
+    dynamic_keymap_set_buffer(offset + 3, sizeof(misaligned), misaligned);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 1), KC_D);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), LCTL(KC_C));
+
+    uint8_t readback[6];
+    dynamic_keymap_get_buffer(offset, sizeof(readback), readback);
+    EXPECT_EQ((readback[2] << 8) | readback[3], KC_D);
+    EXPECT_EQ((readback[4] << 8) | readback[5], LCTL(KC_C));
+}
+
+TEST_F(DynamicKeymap, OutOfRangeLookupsReturnNoKey) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, MATRIX_COLS), KC_NO);
+}
+
+TEST_F(DynamicKeymap, LookupBenchmark) {
+    const uint32_t   iterations = 2000000;
+    volatile uint16_t sink       = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        sink = dynamic_keymap_get_keycode(i % DYNAMIC_KEYMAP_LAYER_COUNT, i % MATRIX_ROWS, i % MATRIX_COLS);
+    }
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    (void)sink;
+
+    std::cout << "dynamic_keymap_get_keycode: " << (uint64_t)(iterations / elapsed) << " lookups/s" << std::endl;
+}
+
+class DynamicKeymapMacro : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_macro_reset();
+    }
+
+    void set_macros(const std::string &macros) {
+        dynamic_keymap_macro_set_buffer(0, macros.size(), (uint8_t *)macros.data());
+    }
+};
+
+TEST_F(DynamicKeymapMacro, SendsSelectedMacro) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros(std::string("ab\0cd\0", 6));
+
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_D));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, SendsMagicSequences) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros(std::string("a" SS_TAP(X_ENTER) "b" SS_DOWN(X_LSFT) "c" SS_UP(X_LSFT)) + '\0');
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_ENTER));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_C));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, SendsLastMacroAtEndOfBuffer) {
+    TestDriver driver;
+    InSequence s;
+
+    // Pad the first macros so the last one ends right before the final null
+    std::string last    = "abcdefghijklmnopqrstuvwxyz";
+    size_t      padding = (dynamic_keymap_macro_get_buffer_size() - last.size() - 1) / (DYNAMIC_KEYMAP_MACRO_COUNT - 1) - 1;
+    std::string macros;
+    for (uint8_t i = 0; i < DYNAMIC_KEYMAP_MACRO_COUNT - 1; i++) {
+        macros += std::string(padding, 'x') + '\0';
+    }
+    macros += last + '\0';
+    set_macros(macros);
+
+    for (char c : last) {
+        EXPECT_REPORT(driver, (KC_A + (c - 'a')));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    dynamic_keymap_macro_send(DYNAMIC_KEYMAP_MACRO_COUNT - 1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, SendsMacroLongerThanAByte) {
+    TestDriver driver;
+    InSequence s;
+
+    std::string text;
+    for (uint16_t i = 0; i < 280; i++) {
+        text += 'a' + (i % 26);
+    }
+    set_macros(text + '\0');
+
+    for (char c : text) {
+        EXPECT_REPORT(driver, (KC_A + (c - 'a')));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    dynamic_keymap_macro_send(0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(DynamicKeymapMacro, IncompleteBufferIsNotSent) {
+    TestDriver driver;
+    InSequence s;
+
+    set_macros(std::string("ab\0", 3));
+
+    // Hosts mark the buffer as being written by setting the last byte
+    uint8_t busy = 0xFF;
+    dynamic_keymap_macro_set_buffer(dynamic_keymap_macro_get_buffer_size() - 1, 1, &busy);
+
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    VERIFY_AND_CLEAR(driver);
+
+    // Clearing it again completes the write
+    busy = 0;
+    dynamic_keymap_macro_set_buffer(dynamic_keymap_macro_get_buffer_size() - 1, 1, &busy);
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    VERIFY_AND_CLEAR(driver);
+}
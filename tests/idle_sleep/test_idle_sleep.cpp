@@ -0,0 +1,147 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "idle_sleep.h"
+#include "deferred_exec.h"
+}
+
+using testing::_;
+
+static bool allow_sleep = true;
+
+extern "C" bool idle_sleep_allowed_user(void) {
+    return allow_sleep;
+}
+
+static uint32_t deferred_calls = 0;
+
+static uint32_t count_deferred_call(uint32_t trigger_time, void *cb_arg) {
+    deferred_calls++;
+    return 0;
+}
+
+// The test platform runs the simulated clock to the deadline while "asleep"
+static uint32_t time_slept(void) {
+    uint32_t start = timer_read32();
+    idle_sleep_task();
+    return timer_read32() - start;
+}
+
+class IdleSleep : public TestFixture {
+   protected:
+    void SetUp() override {
+        allow_sleep    = true;
+        deferred_calls = 0;
+    }
+};
+
+TEST_F(IdleSleep, SleepsForMaximumDurationWhenIdle) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(idle_sleep_allowed());
+    EXPECT_EQ(time_slept(), IDLE_SLEEP_MAX_DURATION);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(IdleSleep, StaysAwakeWhileKeyIsHeld) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(time_slept(), 0);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(time_slept(), IDLE_SLEEP_MAX_DURATION);
+}
+
+TEST_F(IdleSleep, StaysAwakeUntilTapHoldKeyIsResolved) {
+    TestDriver driver;
+    KeymapKey  mod_tap_key = KeymapKey(0, 0, 0, LSFT_T(KC_P));
+    set_keymap({mod_tap_key});
+
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    mod_tap_key.press();
+    run_one_scan_loop();
+    mod_tap_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The tap is remembered for a repeated tap until the tapping term expires
+    EXPECT_NO_REPORT(driver);
+    EXPECT_TRUE(is_tapping_pending());
+    EXPECT_EQ(time_slept(), 0);
+    idle_for(TAPPING_TERM);
+    EXPECT_FALSE(is_tapping_pending());
+    EXPECT_EQ(time_slept(), IDLE_SLEEP_MAX_DURATION);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(IdleSleep, StaysAwakeWhileComboIsPending) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+
+    EXPECT_NO_REPORT(driver);
+    key_y.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_TRUE(is_combo_pending());
+    EXPECT_FALSE(idle_sleep_allowed());
+
+    EXPECT_REPORT(driver, (KC_Y));
+    EXPECT_EMPTY_REPORT(driver);
+    key_y.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_FALSE(is_combo_pending());
+    EXPECT_TRUE(idle_sleep_allowed());
+}
+
+TEST_F(IdleSleep, WakesForNextDeferredExecution) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    deferred_token token = defer_exec(3, count_deferred_call, NULL);
+    EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+    EXPECT_EQ(time_slept(), 3);
+    deferred_exec_task();
+    EXPECT_EQ(deferred_calls, 1);
+    EXPECT_EQ(time_slept(), IDLE_SLEEP_MAX_DURATION);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(IdleSleep, UserCanVetoSleep) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    allow_sleep = false;
+    EXPECT_EQ(time_slept(), 0);
+    allow_sleep = true;
+    EXPECT_EQ(time_slept(), IDLE_SLEEP_MAX_DURATION);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST(IdleSleepPins, PinsSharingAnEventLineCannotBeArmed) {
+    // The test platform models STM32, where pins 16 apart share an event line like A0 and B0
+    const pin_t distinct[] = {0, 1, 2, 15};
+    const pin_t shared[]   = {0, 1, 16};
+    const pin_t unused[]   = {0, NO_PIN, 1, NO_PIN};
+
+    EXPECT_TRUE(idle_sleep_pins_armable(distinct, sizeof(distinct)));
+    EXPECT_FALSE(idle_sleep_pins_armable(shared, sizeof(shared)));
+    EXPECT_TRUE(idle_sleep_pins_armable(unused, sizeof(unused)));
+}
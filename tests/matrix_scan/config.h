@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Full width rows, so that matrix_row_t is 32 bits
+#undef MATRIX_ROWS
+#define MATRIX_ROWS 8
+#undef MATRIX_COLS
+#define MATRIX_COLS 32
@@ -0,0 +1,64 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+#include "test_common.hpp"
+
+extern "C" {
+#include "test_matrix.h"
+}
+
+// Only the change detection in matrix_task is measured, not the action pipeline
+extern "C" bool should_process_keypress(void) {
+    return false;
+}
+
+class MatrixScanBenchmark : public TestFixture {
+   protected:
+    static void report(const char *name, uint32_t scans, std::chrono::steady_clock::duration elapsed) {
+        double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+        std::cout << name << ": " << (uint64_t)(ns / scans) << " ns/scan" << std::endl;
+    }
+
+    // Alternates between pressing and releasing the given keys on every scan
+    static void benchmark(const char *name, const std::vector<std::pair<uint8_t, uint8_t>> &keys) {
+        TestDriver     driver;
+        const uint32_t iterations = 200000;
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < iterations; i++) {
+            for (auto &key : keys) {
+                if (i & 1) {
+                    release_key(key.first, key.second);
+                } else {
+                    press_key(key.first, key.second);
+                }
+            }
+            keyboard_task();
+        }
+        report(name, iterations, std::chrono::steady_clock::now() - start);
+        clear_all_keys();
+        keyboard_task();
+    }
+};
+
+TEST_F(MatrixScanBenchmark, Idle) {
+    benchmark("idle", {});
+}
+
+TEST_F(MatrixScanBenchmark, SingleKey) {
+    benchmark("single key", {{MATRIX_COLS - 1, MATRIX_ROWS - 1}});
+}
+
+TEST_F(MatrixScanBenchmark, SparseKeys) {
+    benchmark("one key per row", {{0, 0}, {7, 1}, {13, 2}, {19, 3}, {23, 4}, {29, 5}, {31, 6}, {3, 7}});
+}
+
+TEST_F(MatrixScanBenchmark, FullRow) {
+    std::vector<std::pair<uint8_t, uint8_t>> keys;
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        keys.push_back({col, 3});
+    }
+    benchmark("full row", keys);
+}
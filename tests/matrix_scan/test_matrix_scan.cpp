@@ -0,0 +1,99 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+struct matrix_event {
+    uint8_t row;
+    uint8_t col;
+    bool    pressed;
+
+    bool operator==(const matrix_event &other) const {
+        return row == other.row && col == other.col && pressed == other.pressed;
+    }
+};
+
+static std::vector<matrix_event> events;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    events.push_back({record->event.key.row, record->event.key.col, record->event.pressed});
+    return true;
+}
+
+class MatrixScan : public TestFixture {
+   protected:
+    void SetUp() override {
+        events.clear();
+    }
+};
+
+TEST_F(MatrixScan, SimultaneousChangesAreReportedRowMajorByAscendingColumn) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 31, 0, KC_A);
+    KeymapKey  key_b(0, 3, 0, KC_B);
+    KeymapKey  key_c(0, 17, 1, KC_C);
+    KeymapKey  key_d(0, 0, 2, KC_D);
+    KeymapKey  key_e(0, 16, 7, KC_E);
+    set_keymap({key_a, key_b, key_c, key_d, key_e});
+
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    key_e.press();
+    key_a.press();
+    key_d.press();
+    key_b.press();
+    key_c.press();
+    run_one_scan_loop();
+
+    std::vector<matrix_event> expected = {{0, 3, true}, {0, 31, true}, {1, 17, true}, {2, 0, true}, {7, 16, true}};
+    EXPECT_EQ(events, expected);
+
+    events.clear();
+    key_c.release();
+    key_a.release();
+    run_one_scan_loop();
+    expected = {{0, 31, false}, {1, 17, false}};
+    EXPECT_EQ(events, expected);
+
+    events.clear();
+    key_b.release();
+    key_d.release();
+    key_e.release();
+    run_one_scan_loop();
+    expected = {{0, 3, false}, {2, 0, false}, {7, 16, false}};
+    EXPECT_EQ(events, expected);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(MatrixScan, UnchangedKeysInChangedRowAreNotReported) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 1, 4, KC_A);
+    KeymapKey  key_b(0, 30, 4, KC_B);
+    set_keymap({key_a, key_b});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    key_b.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    std::vector<matrix_event> expected = {{4, 1, true}, {4, 30, true}};
+    EXPECT_EQ(events, expected);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    key_b.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
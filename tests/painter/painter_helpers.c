@@ -0,0 +1,278 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "painter_helpers.h"
+#include "qff.h"
+#include "qgf.h"
+#include "qp_draw.h"
+#include "qp_surface.h"
+#include "qp_surface_internal.h"
+
+static surface_painter_device_t test_surfaces[PAINTER_TEST_SURFACES];
+
+painter_device_t painter_test_surface(uint8_t slot, uint16_t width, uint16_t height, uint16_t *buffer) {
+    memset(&test_surfaces[slot], 0, sizeof(surface_painter_device_t));
+    painter_device_t device = qp_make_rgb565_surface_advanced(&test_surfaces[slot], 1, width, height, buffer);
+    qp_init(device, QP_ROTATION_0);
+    return device;
+}
+
+typedef struct writer_t {
+    uint8_t *buffer;
+    uint32_t capacity;
+    uint32_t position;
+} writer_t;
+
+static void write_bytes(writer_t *writer, const void *data, uint32_t length) {
+    if (writer->position + length <= writer->capacity) {
+        memcpy(&writer->buffer[writer->position], data, length);
+    }
+    writer->position += length;
+}
+
+static void write_byte(writer_t *writer, uint8_t value) {
+    write_bytes(writer, &value, 1);
+}
+
+static qgf_block_header_v1_t block_header(uint8_t type_id, uint32_t length) {
+    qgf_block_header_v1_t header = {.type_id = type_id, .neg_type_id = ~type_id, .length = length};
+    return header;
+}
+
+// Same scheme as the `qmk painter-convert-graphics` RLE: runs of two or more repeat, everything else goes out verbatim
+static void write_rle(writer_t *writer, const uint8_t *data, uint32_t length) {
+    uint32_t i = 0;
+    while (i < length) {
+        uint32_t run = 1;
+        while (i + run < length && run < 127 && data[i + run] == data[i]) {
+            run++;
+        }
+        if (run >= 2) {
+            write_byte(writer, run);
+            write_byte(writer, data[i]);
+            i += run;
+            continue;
+        }
+
+        uint32_t literal = 1;
+        while (i + literal < length && literal < 128 && !(i + literal + 1 < length && data[i + literal] == data[i + literal + 1])) {
+            literal++;
+        }
+        write_byte(writer, 127 + literal);
+        write_bytes(writer, &data[i], literal);
+        i += literal;
+    }
+}
+
+uint32_t painter_test_build_qgf(uint8_t *buffer, uint32_t capacity, uint16_t width, uint16_t height, uint8_t format, uint8_t compression, const uint8_t *pixdata, uint32_t pixdata_size) {
+    return painter_test_build_animated_qgf(buffer, capacity, width, height, format, compression, &pixdata, 1, pixdata_size, 0);
+}
+
+uint32_t painter_test_build_animated_qgf(uint8_t *buffer, uint32_t capacity, uint16_t width, uint16_t height, uint8_t format, uint8_t compression, const uint8_t *const *frames, uint16_t frame_count, uint32_t pixdata_size, uint16_t delay) {
+    uint8_t bpp;
+    bool    has_palette;
+    if (!qgf_parse_format(format, &bpp, &has_palette, NULL)) {
+        return 0;
+    }
+
+    writer_t writer = {.buffer = buffer, .capacity = capacity, .position = sizeof(qgf_graphics_descriptor_v1_t)};
+
+    // The frame offsets are only known once each frame is written, so they get patched afterwards
+    qgf_frame_offsets_v1_t frame_offsets = {.header = block_header(QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, frame_count * sizeof(uint32_t))};
+    write_bytes(&writer, &frame_offsets, sizeof(frame_offsets));
+    uint32_t offsets_position = writer.position;
+    writer.position += frame_count * sizeof(uint32_t);
+
+    for (uint16_t f = 0; f < frame_count; f++) {
+        uint32_t frame_offset = writer.position;
+        if (offsets_position + (f + 1) * sizeof(uint32_t) <= capacity) {
+            memcpy(&buffer[offsets_position + f * sizeof(uint32_t)], &frame_offset, sizeof(frame_offset));
+        }
+
+        qgf_frame_v1_t frame = {.header = block_header(QGF_FRAME_DESCRIPTOR_TYPEID, sizeof(qgf_frame_v1_t) - sizeof(qgf_block_header_v1_t)), .format = format, .compression_scheme = compression, .delay = delay};
+        write_bytes(&writer, &frame, sizeof(frame));
+
+        if (has_palette) {
+            uint16_t         entries = 1 << bpp;
+            qgf_palette_v1_t palette = {.header = block_header(QGF_FRAME_PALETTE_DESCRIPTOR_TYPEID, entries * sizeof(qgf_palette_entry_v1_t))};
+            write_bytes(&writer, &palette, sizeof(palette));
+            for (uint16_t i = 0; i < entries; i++) {
+                qgf_palette_entry_v1_t entry = {.h = i * 256 / entries + f * PAINTER_TEST_FRAME_HUE_STEP, .s = 255, .v = 255};
+                write_bytes(&writer, &entry, sizeof(entry));
+            }
+        }
+
+        // The data block length is only known once the data is compressed, so it gets patched afterwards
+        uint32_t data_position = writer.position;
+        writer.position += sizeof(qgf_data_v1_t);
+        if (compression == IMAGE_COMPRESSED_RLE) {
+            write_rle(&writer, frames[f], pixdata_size);
+        } else {
+            write_bytes(&writer, frames[f], pixdata_size);
+        }
+        if (writer.position > capacity) {
+            return 0;
+        }
+
+        qgf_data_v1_t data = {.header = block_header(QGF_FRAME_DATA_DESCRIPTOR_TYPEID, writer.position - data_position - sizeof(qgf_data_v1_t))};
+        memcpy(&buffer[data_position], &data, sizeof(data));
+    }
+
+    uint32_t                     total_size = writer.position;
+    qgf_graphics_descriptor_v1_t descriptor = {
+        .header              = block_header(QGF_GRAPHICS_DESCRIPTOR_TYPEID, sizeof(qgf_graphics_descriptor_v1_t) - sizeof(qgf_block_header_v1_t)),
+        .magic               = QGF_MAGIC,
+        .qgf_version         = 0x01,
+        .total_file_size     = total_size,
+        .neg_total_file_size = ~total_size,
+        .image_width         = width,
+        .image_height        = height,
+        .frame_count         = frame_count,
+    };
+    memcpy(buffer, &descriptor, sizeof(descriptor));
+    return total_size;
+}
+
+uint32_t painter_test_build_qff(uint8_t *buffer, uint32_t capacity, uint8_t version, const uint32_t *code_points, const uint8_t *widths, uint16_t count) {
+    writer_t writer = {.buffer = buffer, .capacity = capacity, .position = sizeof(qff_font_descriptor_v1_t)};
+
+    qgf_block_header_v1_t unicode_header = block_header(QFF_UNICODE_GLYPH_DESCRIPTOR_TYPEID, count * sizeof(qff_unicode_glyph_v1_t));
+    write_bytes(&writer, &unicode_header, sizeof(unicode_header));
+    uint32_t data_size = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        qff_unicode_glyph_v1_t glyph = {.code_point = code_points[i], .value = (data_size << QFF_GLYPH_WIDTH_BITS) | widths[i]};
+        write_bytes(&writer, &glyph, sizeof(glyph));
+        data_size += (widths[i] * PAINTER_TEST_FONT_HEIGHT + 7) / 8;
+    }
+
+    qgf_block_header_v1_t data_header = block_header(0x04, data_size); // QFF font data block
+    write_bytes(&writer, &data_header, sizeof(data_header));
+    for (uint16_t i = 0; i < count; i++) {
+        uint8_t  lit_row = code_points[i] % PAINTER_TEST_FONT_HEIGHT;
+        uint16_t pixels  = widths[i] * PAINTER_TEST_FONT_HEIGHT;
+        uint8_t  byte    = 0;
+        for (uint16_t p = 0; p < pixels; p++) {
+            if (p / widths[i] == lit_row) {
+                byte |= 1 << (p % 8);
+            }
+            if (p % 8 == 7 || p == pixels - 1) {
+                write_byte(&writer, byte);
+                byte = 0;
+            }
+        }
+    }
+
+    uint32_t total_size = writer.position;
+    if (total_size > capacity) {
+        return 0;
+    }
+
+    qff_font_descriptor_v1_t descriptor = {
+        .header              = block_header(QFF_FONT_DESCRIPTOR_TYPEID, sizeof(qff_font_descriptor_v1_t) - sizeof(qgf_block_header_v1_t)),
+        .magic               = QFF_MAGIC,
+        .qff_version         = version,
+        .total_file_size     = total_size,
+        .neg_total_file_size = ~total_size,
+        .line_height         = PAINTER_TEST_FONT_HEIGHT,
+        .has_ascii_table     = false,
+        .num_unicode_glyphs  = count,
+        .format              = GRAYSCALE_1BPP,
+        .compression_scheme  = IMAGE_UNCOMPRESSED,
+    };
+    memcpy(buffer, &descriptor, sizeof(descriptor));
+    return total_size;
+}
+
+const uint8_t *painter_test_qgf_pixdata(const uint8_t *qgf, uint32_t *length) {
+    // Walk the blocks of the first frame up to its data block
+    uint32_t position = sizeof(qgf_graphics_descriptor_v1_t);
+    while (true) {
+        qgf_block_header_v1_t header;
+        memcpy(&header, &qgf[position], sizeof(header));
+        position += sizeof(header);
+        if (header.type_id == QGF_FRAME_DATA_DESCRIPTOR_TYPEID) {
+            *length = header.length;
+            return &qgf[position];
+        }
+        position += header.length;
+    }
+}
+
+uint16_t painter_test_palette_color(uint8_t index) {
+    return qp_internal_global_pixel_lookup_table[index].rgb565;
+}
+
+static bool decode(painter_device_t device, const uint8_t *data, uint32_t length, uint8_t compression, uint8_t bpp, uint16_t width, uint16_t height, bool bulk) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (!driver->driver_vtable->viewport(device, 0, 0, width - 1, height - 1)) {
+        return false;
+    }
+
+    qp_memory_stream_t              stream         = qp_make_memory_stream((void *)data, length);
+    qp_internal_byte_input_state_t  input_state    = {.device = device, .src_stream = (qp_stream_t *)&stream};
+    qp_internal_byte_input_callback input_callback = qp_internal_prepare_input_state(&input_state, compression);
+    if (input_callback == NULL) {
+        return false;
+    }
+
+    uint32_t pixel_count = (uint32_t)width * height;
+    if (bpp == driver->native_bits_per_pixel) {
+        qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = qp_internal_num_pixels_in_buffer(device) * driver->native_bits_per_pixel / 8};
+        uint32_t                        byte_count   = pixel_count * bpp / 8;
+        bool                            ret          = bulk ? qp_internal_send_bytes_to_pixdata(device, byte_count, &input_state, &output_state) : qp_internal_send_bytes(device, byte_count, input_callback, &input_state, qp_internal_byte_appender, &output_state);
+        if (ret && output_state.byte_write_pos > 0) {
+            ret &= qp_internal_flush_pixdata(device, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
+        }
+        return ret;
+    }
+
+    qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
+    bool                             ret          = bulk ? qp_internal_decode_palette_to_pixdata(device, pixel_count, bpp, &input_state, qp_internal_global_pixel_lookup_table, &output_state) : qp_internal_decode_palette(device, pixel_count, bpp, input_callback, &input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+    if (ret && output_state.pixel_write_pos > 0) {
+        ret &= qp_internal_flush_pixdata(device, output_state.pixel_write_pos);
+    }
+    return ret;
+}
+
+bool painter_test_decode_per_byte(painter_device_t device, const uint8_t *data, uint32_t length, uint8_t compression, uint8_t bpp, uint16_t width, uint16_t height) {
+    return decode(device, data, length, compression, bpp, width, height, false);
+}
+
+bool painter_test_decode_bulk(painter_device_t device, const uint8_t *data, uint32_t length, uint8_t compression, uint8_t bpp, uint16_t width, uint16_t height) {
+    return decode(device, data, length, compression, bpp, width, height, true);
+}
+
+// Wraps the surface's palette conversion so calls to it can be counted
+static const surface_painter_driver_vtable_t *counted_vtable;
+static surface_painter_driver_vtable_t        counting_vtable;
+static uint32_t                               palette_converts;
+
+static bool counting_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t *palette) {
+    palette_converts++;
+    return counted_vtable->base.palette_convert(device, palette_size, palette);
+}
+
+void painter_test_count_palette_converts(painter_device_t device) {
+    painter_driver_t *driver = (painter_driver_t *)device;
+    if (driver->driver_vtable != &counting_vtable.base) {
+        counted_vtable                       = (const surface_painter_driver_vtable_t *)driver->driver_vtable;
+        counting_vtable                      = *counted_vtable;
+        counting_vtable.base.palette_convert = counting_palette_convert;
+        driver->driver_vtable                = &counting_vtable.base;
+    }
+    palette_converts = 0;
+}
+
+uint32_t painter_test_palette_converts(void) {
+    return palette_converts;
+}
+
+void advance_time(uint32_t ms);
+void qp_internal_animation_tick(void);
+
+void painter_test_advance_animations(uint32_t ms) {
+    advance_time(ms);
+    qp_internal_animation_tick();
+}
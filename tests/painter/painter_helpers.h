@@ -0,0 +1,53 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "qp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PAINTER_TEST_SURFACES 2
+
+// A 16bpp surface over the caller's buffer, already initialised. Making another surface in the same slot replaces it.
+painter_device_t painter_test_surface(uint8_t slot, uint16_t width, uint16_t height, uint16_t *buffer);
+
+// Writes a single frame QGF image holding the given (uncompressed) pixel data, returns its size or 0 if it didn't fit.
+// Palette formats get a palette of fully saturated hues, entry i being hue i * 256 / entries.
+uint32_t painter_test_build_qgf(uint8_t *buffer, uint32_t capacity, uint16_t width, uint16_t height, uint8_t format, uint8_t compression, const uint8_t *pixdata, uint32_t pixdata_size);
+
+#define PAINTER_TEST_FRAME_HUE_STEP 8
+
+// As above with one frame per entry of frames, each pixdata_size bytes and shown for delay milliseconds. Frame f's
+// palette has its hues shifted along by f * PAINTER_TEST_FRAME_HUE_STEP.
+uint32_t painter_test_build_animated_qgf(uint8_t *buffer, uint32_t capacity, uint16_t width, uint16_t height, uint8_t format, uint8_t compression, const uint8_t *const *frames, uint16_t frame_count, uint32_t pixdata_size, uint16_t delay);
+
+#define PAINTER_TEST_FONT_HEIGHT 8
+
+// Writes an uncompressed 1bpp QFF font with only a unicode glyph table, listing the glyphs in the order given. Glyph n is
+// widths[n] pixels wide with only row (code_points[n] % PAINTER_TEST_FONT_HEIGHT) lit. Returns its size or 0 if it didn't fit.
+uint32_t painter_test_build_qff(uint8_t *buffer, uint32_t capacity, uint8_t version, const uint32_t *code_points, const uint8_t *widths, uint16_t count);
+
+// The still encoded pixel data of the image's first frame
+const uint8_t *painter_test_qgf_pixdata(const uint8_t *qgf, uint32_t *length);
+
+// The native color of a palette entry, as loaded by the last image drawn
+uint16_t painter_test_palette_color(uint8_t index);
+
+// Decodes raw frame data onto the top left of the device with the palette of the last image drawn, either through the
+// per-byte callback codec or the bulk one
+bool painter_test_decode_per_byte(painter_device_t device, const uint8_t *data, uint32_t length, uint8_t compression, uint8_t bpp, uint16_t width, uint16_t height);
+bool painter_test_decode_bulk(painter_device_t device, const uint8_t *data, uint32_t length, uint8_t compression, uint8_t bpp, uint16_t width, uint16_t height);
+
+// Counts the palette conversions the device makes from now on
+void     painter_test_count_palette_converts(painter_device_t device);
+uint32_t painter_test_palette_converts(void);
+
+// Moves time along and lets any running animations draw their next frame
+void painter_test_advance_animations(uint32_t ms);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,136 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "painter_helpers.h"
+}
+
+// Image formats and compression schemes, as in qp_internal_formats.h
+constexpr uint8_t PALETTE_4BPP         = 0x06;
+constexpr uint8_t RGB565_16BPP         = 0x08;
+constexpr uint8_t IMAGE_UNCOMPRESSED   = 0;
+constexpr uint8_t IMAGE_COMPRESSED_RLE = 1;
+
+constexpr uint16_t SIZE = 240;
+
+// Diagonal bands of color with a sprinkling of noise, so RLE data has both repeating and verbatim runs
+static uint8_t source_index(uint16_t x, uint16_t y) {
+    if ((x * 7 + y * 13) % 29 == 0) {
+        return (x ^ y) & 0x0F;
+    }
+    return ((x + y) / 24) & 0x0F;
+}
+
+static std::vector<uint8_t> source_4bpp() {
+    std::vector<uint8_t> pixdata(SIZE * SIZE / 2);
+    for (uint32_t i = 0; i < SIZE * SIZE; i++) {
+        pixdata[i / 2] |= source_index(i % SIZE, i / SIZE) << ((i % 2) * 4);
+    }
+    return pixdata;
+}
+
+static std::vector<uint8_t> source_rgb565() {
+    std::vector<uint8_t> pixdata(SIZE * SIZE * 2);
+    for (uint32_t i = 0; i < SIZE * SIZE; i++) {
+        pixdata[i * 2]     = source_index(i % SIZE, i / SIZE) * 16;
+        pixdata[i * 2 + 1] = i & 0xFF;
+    }
+    return pixdata;
+}
+
+static std::vector<uint8_t> build_qgf(uint8_t format, uint8_t compression, const std::vector<uint8_t> &pixdata) {
+    std::vector<uint8_t> qgf(pixdata.size() * 2 + 1024);
+    qgf.resize(painter_test_build_qgf(qgf.data(), qgf.size(), SIZE, SIZE, format, compression, pixdata.data(), pixdata.size()));
+    return qgf;
+}
+
+class PainterCodec : public ::testing::Test {
+   protected:
+    std::vector<uint16_t> framebuffer = std::vector<uint16_t>(SIZE * SIZE);
+    painter_device_t      device      = painter_test_surface(0, SIZE, SIZE, framebuffer.data());
+
+    void draw(const std::vector<uint8_t> &qgf) {
+        painter_image_handle_t image = qp_load_image_mem(qgf.data());
+        ASSERT_NE(image, nullptr);
+        EXPECT_TRUE(qp_drawimage(device, 0, 0, image));
+        qp_close_image(image);
+    }
+
+    void expect_palette_source() {
+        for (uint32_t i = 0; i < SIZE * SIZE; i++) {
+            ASSERT_EQ(framebuffer[i], painter_test_palette_color(source_index(i % SIZE, i / SIZE))) << "at pixel " << i;
+        }
+    }
+};
+
+TEST_F(PainterCodec, UncompressedPaletteImage) {
+    draw(build_qgf(PALETTE_4BPP, IMAGE_UNCOMPRESSED, source_4bpp()));
+    expect_palette_source();
+}
+
+TEST_F(PainterCodec, RlePaletteImage) {
+    auto qgf = build_qgf(PALETTE_4BPP, IMAGE_COMPRESSED_RLE, source_4bpp());
+    EXPECT_LT(qgf.size(), SIZE * SIZE / 2);
+    draw(qgf);
+    expect_palette_source();
+}
+
+TEST_F(PainterCodec, NativeImage) {
+    auto source = source_rgb565();
+    draw(build_qgf(RGB565_16BPP, IMAGE_COMPRESSED_RLE, source));
+    EXPECT_EQ(memcmp(framebuffer.data(), source.data(), source.size()), 0);
+}
+
+TEST_F(PainterCodec, TruncatedDataFails) {
+    auto     qgf = build_qgf(PALETTE_4BPP, IMAGE_COMPRESSED_RLE, source_4bpp());
+    uint32_t length;
+    auto     data = painter_test_qgf_pixdata(qgf.data(), &length);
+    draw(qgf);
+    EXPECT_TRUE(painter_test_decode_bulk(device, data, length, IMAGE_COMPRESSED_RLE, 4, SIZE, SIZE));
+    EXPECT_FALSE(painter_test_decode_bulk(device, data, length - 10, IMAGE_COMPRESSED_RLE, 4, SIZE, SIZE));
+}
+
+// Decodes the same frame data through the per-byte callbacks and the bulk codec, checking both agree and timing them
+TEST_F(PainterCodec, Benchmark) {
+    std::vector<uint16_t> reference(SIZE * SIZE);
+    painter_device_t      reference_device = painter_test_surface(1, SIZE, SIZE, reference.data());
+
+    struct {
+        const char *         name;
+        uint8_t              format;
+        uint8_t              compression;
+        uint8_t              bpp;
+        std::vector<uint8_t> source;
+    } cases[] = {
+        {"4bpp palette", PALETTE_4BPP, IMAGE_UNCOMPRESSED, 4, source_4bpp()},
+        {"4bpp palette, RLE", PALETTE_4BPP, IMAGE_COMPRESSED_RLE, 4, source_4bpp()},
+        {"rgb565", RGB565_16BPP, IMAGE_UNCOMPRESSED, 16, source_rgb565()},
+        {"rgb565, RLE", RGB565_16BPP, IMAGE_COMPRESSED_RLE, 16, source_rgb565()},
+    };
+
+    for (auto &c : cases) {
+        auto qgf = build_qgf(c.format, c.compression, c.source);
+        draw(qgf); // loads the palette
+        uint32_t length;
+        auto     data = painter_test_qgf_pixdata(qgf.data(), &length);
+
+        constexpr int ITERATIONS = 20;
+        auto          time       = [&](painter_device_t target, bool (*decode)(painter_device_t, const uint8_t *, uint32_t, uint8_t, uint8_t, uint16_t, uint16_t)) {
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < ITERATIONS; i++) {
+                EXPECT_TRUE(decode(target, data, length, c.compression, c.bpp, SIZE, SIZE));
+            }
+            return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+        };
+        double per_byte = time(reference_device, painter_test_decode_per_byte);
+        double bulk     = time(device, painter_test_decode_bulk);
+
+        EXPECT_EQ(framebuffer, reference) << c.name;
+        std::cout << c.name << ": per-byte " << per_byte << "us, bulk " << bulk << "us per " << SIZE << "x" << SIZE << " frame (" << per_byte / bulk << "x)" << std::endl;
+    }
+}
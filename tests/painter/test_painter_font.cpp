@@ -0,0 +1,149 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "painter_helpers.h"
+}
+
+// CJK ideographs, spaced out so neighbouring code points are missing from the font
+static uint32_t glyph_code_point(uint16_t n) {
+    return 0x4E00 + n * 3;
+}
+
+static uint8_t glyph_width(uint32_t code_point) {
+    return 1 + code_point % 13;
+}
+
+static std::string utf8(const std::vector<uint32_t> &code_points) {
+    std::string str;
+    for (uint32_t cp : code_points) {
+        if (cp < 0x80) {
+            str += (char)cp;
+        } else if (cp < 0x800) {
+            str += (char)(0xC0 | (cp >> 6));
+            str += (char)(0x80 | (cp & 0x3F));
+        } else {
+            str += (char)(0xE0 | (cp >> 12));
+            str += (char)(0x80 | ((cp >> 6) & 0x3F));
+            str += (char)(0x80 | (cp & 0x3F));
+        }
+    }
+    return str;
+}
+
+static int16_t total_width(const std::vector<uint32_t> &code_points) {
+    int16_t width = 0;
+    for (uint32_t cp : code_points) {
+        width += glyph_width(cp);
+    }
+    return width;
+}
+
+// A font of `count` glyphs, QFF v2 lists them in code point order while v1 gets them in reverse
+static std::vector<uint8_t> build_font(uint8_t version, uint16_t count) {
+    std::vector<uint32_t> code_points;
+    std::vector<uint8_t>  widths;
+    for (uint16_t n = 0; n < count; n++) {
+        code_points.push_back(glyph_code_point(n));
+    }
+    if (version == 1) {
+        std::reverse(code_points.begin(), code_points.end());
+    }
+    for (uint32_t cp : code_points) {
+        widths.push_back(glyph_width(cp));
+    }
+
+    std::vector<uint8_t> qff(64 * 1024);
+    qff.resize(painter_test_build_qff(qff.data(), qff.size(), version, code_points.data(), widths.data(), count));
+    return qff;
+}
+
+class PainterFont : public ::testing::TestWithParam<uint8_t> {
+   protected:
+    std::vector<uint8_t>  qff  = build_font(GetParam(), 600);
+    painter_font_handle_t font = qp_load_font_mem(qff.data());
+
+    void TearDown() override {
+        qp_close_font(font);
+    }
+};
+
+TEST_P(PainterFont, MeasuresGlyphsAcrossTheTable) {
+    ASSERT_NE(font, nullptr);
+    std::vector<uint32_t> code_points = {glyph_code_point(0), glyph_code_point(599), glyph_code_point(300), glyph_code_point(1), glyph_code_point(598), glyph_code_point(0)};
+    EXPECT_EQ(qp_textwidth(font, utf8(code_points).c_str()), total_width(code_points));
+}
+
+TEST_P(PainterFont, MissingGlyphIsNotFound) {
+    ASSERT_NE(font, nullptr);
+    EXPECT_EQ(qp_textwidth(font, utf8({glyph_code_point(10) + 1}).c_str()), 0);
+    EXPECT_EQ(qp_textwidth(font, utf8({glyph_code_point(0) - 1}).c_str()), 0);
+    EXPECT_EQ(qp_textwidth(font, utf8({glyph_code_point(600)}).c_str()), 0);
+    EXPECT_EQ(qp_textwidth(font, "A"), 0);
+}
+
+// Cycles through more glyphs than the cache holds, so entries get evicted and looked up again
+TEST_P(PainterFont, RecentGlyphsStayCorrect) {
+    ASSERT_NE(font, nullptr);
+    for (int round = 0; round < 4; round++) {
+        for (uint16_t n = 0; n < 40; n++) {
+            std::vector<uint32_t> code_points = {glyph_code_point(n * 7 % 600), glyph_code_point(n % 5), glyph_code_point(n * 13 % 600)};
+            ASSERT_EQ(qp_textwidth(font, utf8(code_points).c_str()), total_width(code_points)) << "round " << round << ", glyph " << n;
+        }
+    }
+}
+
+TEST_P(PainterFont, DrawsTheRequestedGlyphs) {
+    ASSERT_NE(font, nullptr);
+    std::vector<uint16_t> framebuffer(64 * PAINTER_TEST_FONT_HEIGHT);
+    painter_device_t      device = painter_test_surface(0, 64, PAINTER_TEST_FONT_HEIGHT, framebuffer.data());
+
+    std::vector<uint32_t> code_points = {glyph_code_point(17), glyph_code_point(420), glyph_code_point(3), glyph_code_point(17)};
+    EXPECT_EQ(qp_drawtext(device, 0, 0, font, utf8(code_points).c_str()), total_width(code_points));
+
+    uint16_t x = 0;
+    for (uint32_t cp : code_points) {
+        for (uint16_t column = x; column < x + glyph_width(cp); column++) {
+            for (uint16_t row = 0; row < PAINTER_TEST_FONT_HEIGHT; row++) {
+                bool lit = row == cp % PAINTER_TEST_FONT_HEIGHT;
+                EXPECT_EQ(framebuffer[row * 64 + column] != 0, lit) << "code point " << cp << " at " << column << "," << row;
+            }
+        }
+        x += glyph_width(cp);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(QffVersions, PainterFont, ::testing::Values(1, 2), [](const ::testing::TestParamInfo<uint8_t> &info) { return info.param == 1 ? std::string("Unsorted") : std::string("Sorted"); });
+
+// Measures a string of distinct glyphs spread over the table, against fonts of increasing size
+TEST(PainterFontBenchmark, LookupTime) {
+    std::vector<uint32_t> code_points;
+    for (uint16_t n = 0; n < 32; n++) {
+        code_points.push_back(glyph_code_point(n * 37 % 64));
+    }
+    std::string str = utf8(code_points);
+
+    for (uint16_t count : {64, 256, 1024}) {
+        for (uint8_t version : {1, 2}) {
+            auto                  qff  = build_font(version, count);
+            painter_font_handle_t font = qp_load_font_mem(qff.data());
+            ASSERT_NE(font, nullptr);
+
+            constexpr int ITERATIONS = 200;
+            auto          start      = std::chrono::steady_clock::now();
+            for (int i = 0; i < ITERATIONS; i++) {
+                EXPECT_EQ(qp_textwidth(font, str.c_str()), total_width(code_points));
+            }
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / ITERATIONS;
+            std::cout << "QFF v" << (int)version << ", " << count << " glyphs: " << us << "us per 32 glyph string" << std::endl;
+            qp_close_font(font);
+        }
+    }
+}
@@ -0,0 +1,132 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "painter_helpers.h"
+}
+
+// Image formats and compression schemes, as in qp_internal_formats.h
+constexpr uint8_t GRAYSCALE_2BPP     = 0x01;
+constexpr uint8_t PALETTE_2BPP       = 0x05;
+constexpr uint8_t IMAGE_UNCOMPRESSED = 0;
+
+constexpr uint16_t WIDTH  = 8;
+constexpr uint16_t HEIGHT = 4;
+constexpr uint16_t DELAY  = 10;
+
+// The first pixels spell out the frame number in base 4 so that every frame differs, the rest is a shifting pattern
+static std::vector<uint8_t> frame_pixdata(uint16_t frame) {
+    std::vector<uint8_t> pixdata(WIDTH * HEIGHT / 4);
+    for (uint16_t i = 0; i < WIDTH * HEIGHT; i++) {
+        uint8_t index = i < 3 ? (frame >> (i * 2)) & 0x03 : (i + frame) & 0x03;
+        pixdata[i / 4] |= index << ((i % 4) * 2);
+    }
+    return pixdata;
+}
+
+class PainterImage : public ::testing::Test {
+   protected:
+    std::vector<uint16_t>             framebuffer      = std::vector<uint16_t>(WIDTH * HEIGHT);
+    std::vector<uint16_t>             reference        = std::vector<uint16_t>(WIDTH * HEIGHT);
+    painter_device_t                  device           = painter_test_surface(0, WIDTH, HEIGHT, framebuffer.data());
+    painter_device_t                  reference_device = painter_test_surface(1, WIDTH, HEIGHT, reference.data());
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t>              qgf;
+
+    painter_image_handle_t load(uint8_t format, uint16_t frame_count) {
+        std::vector<const uint8_t *> frame_pointers;
+        for (uint16_t f = 0; f < frame_count; f++) {
+            frames.push_back(frame_pixdata(f));
+        }
+        for (auto &frame : frames) {
+            frame_pointers.push_back(frame.data());
+        }
+        qgf.resize(4096);
+        qgf.resize(painter_test_build_animated_qgf(qgf.data(), qgf.size(), WIDTH, HEIGHT, format, IMAGE_UNCOMPRESSED, frame_pointers.data(), frame_count, frames[0].size(), DELAY));
+        EXPECT_FALSE(qgf.empty());
+        return qp_load_image_mem(qgf.data());
+    }
+
+    // Compares the device against the frame decoded with the palette the device was last drawn with
+    void expect_frame(uint16_t frame) {
+        ASSERT_TRUE(painter_test_decode_bulk(reference_device, frames[frame].data(), frames[frame].size(), IMAGE_UNCOMPRESSED, 2, WIDTH, HEIGHT));
+        EXPECT_EQ(framebuffer, reference) << "frame " << frame;
+    }
+};
+
+TEST_F(PainterImage, AnimationPastTheFrameOffsetTableDrawsEveryFrame) {
+    constexpr uint16_t     frame_count = 20;
+    painter_image_handle_t image       = load(GRAYSCALE_2BPP, frame_count);
+    ASSERT_NE(image, nullptr);
+    painter_test_count_palette_converts(device);
+
+    deferred_token token = qp_animate(device, 0, 0, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    expect_frame(0);
+    for (uint16_t n = 1; n < frame_count * 2; n++) {
+        painter_test_advance_animations(DELAY);
+        expect_frame(n % frame_count);
+    }
+
+    // Every frame interpolates the same palette, so it's only converted the first time
+    EXPECT_EQ(painter_test_palette_converts(), 1u);
+    qp_stop_animation(token);
+    qp_close_image(image);
+}
+
+TEST_F(PainterImage, AnimationConvertsEachFramePaletteOnce) {
+    painter_image_handle_t image = load(PALETTE_2BPP, 2);
+    ASSERT_NE(image, nullptr);
+    painter_test_count_palette_converts(device);
+
+    deferred_token token = qp_animate(device, 0, 0, image);
+    ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+    expect_frame(0);
+    uint16_t first_color = painter_test_palette_color(0);
+    for (uint16_t n = 1; n < 6; n++) {
+        painter_test_advance_animations(DELAY);
+        expect_frame(n % 2);
+        if (n % 2 == 0) {
+            EXPECT_EQ(painter_test_palette_color(0), first_color);
+        } else {
+            EXPECT_NE(painter_test_palette_color(0), first_color);
+        }
+    }
+
+    EXPECT_EQ(painter_test_palette_converts(), 2u);
+    qp_stop_animation(token);
+    qp_close_image(image);
+}
+
+TEST_F(PainterImage, RecolorDeviceAndReloadEachGetTheirOwnPalette) {
+    painter_image_handle_t image = load(GRAYSCALE_2BPP, 1);
+    ASSERT_NE(image, nullptr);
+    painter_test_count_palette_converts(device);
+
+    // Two colorings fit in the cache, switching between them converts nothing new
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(qp_drawimage_recolor(device, 0, 0, image, 0, 255, 255, 0, 0, 0));
+        expect_frame(0);
+        ASSERT_TRUE(qp_drawimage_recolor(device, 0, 0, image, 128, 255, 255, 0, 0, 0));
+        expect_frame(0);
+    }
+    EXPECT_EQ(painter_test_palette_converts(), 2u);
+
+    // The same coloring on another device is converted for that device
+    painter_test_count_palette_converts(reference_device);
+    ASSERT_TRUE(qp_drawimage_recolor(reference_device, 0, 0, image, 128, 255, 255, 0, 0, 0));
+    EXPECT_EQ(painter_test_palette_converts(), 1u);
+
+    // Reloading starts the image's cache afresh
+    qp_close_image(image);
+    image = qp_load_image_mem(qgf.data());
+    ASSERT_NE(image, nullptr);
+    painter_test_count_palette_converts(device);
+    ASSERT_TRUE(qp_drawimage_recolor(device, 0, 0, image, 128, 255, 255, 0, 0, 0));
+    expect_frame(0);
+    EXPECT_EQ(painter_test_palette_converts(), 1u);
+    qp_close_image(image);
+}
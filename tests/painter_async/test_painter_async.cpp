@@ -0,0 +1,110 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "qp.h"
+#include "qp_surface.h"
+#include "gpio.h"
+#include "spi_master.h"
+#include "background_worker_sim.h"
+}
+
+constexpr pin_t DISPLAY_CS  = 1;
+constexpr pin_t DISPLAY_DC  = 2;
+constexpr pin_t DISPLAY_RST = 3;
+
+constexpr uint8_t ST7789_RAMWR = 0x2C;
+
+// Enough of an ST7789 to collect what gets written to its frame memory
+static struct {
+    bool                 writing_ram;
+    std::vector<uint8_t> ram;
+} panel;
+
+static void panel_write(pin_t slave_pin, const uint8_t *data, uint16_t length) {
+    if (slave_pin != DISPLAY_CS) {
+        return;
+    }
+    if (!gpio_sim_read_pin(DISPLAY_DC)) {
+        panel.writing_ram = data[length - 1] == ST7789_RAMWR;
+        panel.ram.clear();
+        return;
+    }
+    if (panel.writing_ram) {
+        panel.ram.insert(panel.ram.end(), data, data + length);
+    }
+}
+
+class PainterAsync : public ::testing::Test {
+   protected:
+    // Devices come from fixed size pools, so the display is shared by all tests
+    static painter_device_t display;
+
+    static void SetUpTestSuite() {
+        display = qp_st7789_make_spi_device(240, 240, DISPLAY_CS, DISPLAY_DC, DISPLAY_RST, 4, 3);
+    }
+
+    void SetUp() override {
+        spi_mock_set_write_callback(panel_write);
+        background_worker_sim_set_latency(0);
+        ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+
+        // Transfers now take a while, so anything that fails to wait for them sees stale or reordered bytes
+        background_worker_sim_set_latency(5);
+        panel = {};
+    }
+
+    void TearDown() override {
+        spi_mock_set_write_callback(NULL);
+    }
+};
+
+painter_device_t PainterAsync::display;
+
+TEST_F(PainterAsync, SurfaceArrivesIntact) {
+    constexpr uint16_t    SIZE = 64;
+    std::vector<uint16_t> framebuffer(SIZE * SIZE);
+    painter_device_t      surface = qp_make_rgb565_surface(SIZE, SIZE, framebuffer.data());
+    ASSERT_TRUE(qp_init(surface, QP_ROTATION_0));
+    ASSERT_TRUE(qp_rect(surface, 0, 0, SIZE - 1, SIZE - 1, 0, 0, 0, true));
+    for (uint32_t i = 0; i < framebuffer.size(); i++) {
+        framebuffer[i] = (i * 2654435761u) >> 16;
+    }
+
+    uint32_t jobs = background_worker_sim_jobs_run();
+    EXPECT_TRUE(qp_surface_draw(surface, display, 0, 0, true));
+
+    // Every buffer went out in the background, and had been sent by the time the draw returned
+    EXPECT_EQ(background_worker_sim_jobs_run() - jobs, SIZE * SIZE * sizeof(uint16_t) / QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE);
+    EXPECT_FALSE(background_worker_busy());
+
+    // Filling the next buffer never overwrote one still being sent
+    ASSERT_EQ(panel.ram.size(), framebuffer.size() * sizeof(uint16_t));
+    EXPECT_EQ(memcmp(panel.ram.data(), framebuffer.data(), panel.ram.size()), 0);
+}
+
+TEST_F(PainterAsync, FilledRectangleArrivesIntact) {
+    EXPECT_TRUE(qp_rect(display, 10, 10, 109, 109, 0, 255, 255, true));
+    EXPECT_FALSE(background_worker_busy());
+
+    // Pure red, as byte swapped RGB565
+    ASSERT_EQ(panel.ram.size(), 100 * 100 * sizeof(uint16_t));
+    for (size_t i = 0; i < panel.ram.size(); i += 2) {
+        ASSERT_EQ(panel.ram[i], 0xF8) << "at byte " << i;
+        ASSERT_EQ(panel.ram[i + 1], 0x00) << "at byte " << i;
+    }
+}
+
+TEST_F(PainterAsync, BusIsReleasedAfterEachCall) {
+    spi_mock_reset();
+    EXPECT_TRUE(qp_rect(display, 0, 0, 239, 239, 128, 255, 255, true));
+    EXPECT_TRUE(qp_line(display, 0, 0, 239, 0, 0, 0, 255));
+
+    // The bus has to be free again for anyone else, which it would not be with a transfer still queued
+    EXPECT_FALSE(background_worker_busy());
+    EXPECT_TRUE(spi_start(DISPLAY_CS, false, 0, 4));
+    spi_stop();
+}
@@ -0,0 +1,28 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+
+#include "surface_helpers.h"
+#include "qp_surface.h"
+#include "qp_surface_internal.h"
+
+static surface_painter_device_t test_surfaces[SURFACE_TEST_SURFACES];
+
+painter_device_t surface_test_make(uint8_t slot, uint16_t width, uint16_t height, uint16_t *buffer) {
+    memset(&test_surfaces[slot], 0, sizeof(surface_painter_device_t));
+    painter_device_t device = qp_make_rgb565_surface_advanced(&test_surfaces[slot], 1, width, height, buffer);
+    qp_init(device, QP_ROTATION_0);
+    return device;
+}
+
+uint8_t surface_test_dirty_rects(painter_device_t surface, uint16_t (*rects)[4], uint8_t max) {
+    surface_dirty_data_t *dirty = &((surface_painter_device_t *)surface)->dirty;
+    for (uint8_t i = 0; i < dirty->rect_count && i < max; i++) {
+        rects[i][0] = dirty->rects[i].l;
+        rects[i][1] = dirty->rects[i].t;
+        rects[i][2] = dirty->rects[i].r;
+        rects[i][3] = dirty->rects[i].b;
+    }
+    return dirty->rect_count;
+}
@@ -0,0 +1,22 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "qp.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SURFACE_TEST_SURFACES 2
+
+// A 16bpp surface over the caller's buffer, already initialised. Making another surface in the same slot replaces it.
+painter_device_t surface_test_make(uint8_t slot, uint16_t width, uint16_t height, uint16_t *buffer);
+
+// Copies out up to `max` of the surface's dirty rectangles as {l, t, r, b}, returns how many the surface has
+uint8_t surface_test_dirty_rects(painter_device_t surface, uint16_t (*rects)[4], uint8_t max);
+
+#ifdef __cplusplus
+}
+#endif
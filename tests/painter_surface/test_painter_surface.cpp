@@ -0,0 +1,202 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <functional>
+#include <iostream>
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "surface_helpers.h"
+#include "qp_surface.h"
+#include "gpio.h"
+#include "spi_master.h"
+}
+
+constexpr pin_t DISPLAY_CS  = 1;
+constexpr pin_t DISPLAY_DC  = 2;
+constexpr pin_t DISPLAY_RST = 3;
+
+constexpr uint16_t SIZE = 240;
+
+// Enough of an ST7789 to follow the address window and what gets written to its frame memory
+static struct {
+    uint8_t               command;
+    uint8_t               params[4];
+    uint8_t               param_count;
+    uint16_t              x0, x1, y0, y1, x, y;
+    uint8_t               half_pixel[2];
+    bool                  odd_byte;
+    std::vector<uint16_t> ram = std::vector<uint16_t>(SIZE * SIZE);
+} panel;
+
+static void panel_write(pin_t slave_pin, const uint8_t *data, uint16_t length) {
+    if (slave_pin != DISPLAY_CS) {
+        return;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        if (!gpio_sim_read_pin(DISPLAY_DC)) {
+            panel.command     = data[i];
+            panel.param_count = 0;
+            panel.odd_byte    = false;
+            panel.x           = panel.x0;
+            panel.y           = panel.y0;
+            continue;
+        }
+        if (panel.command == 0x2A || panel.command == 0x2B) { // CASET, RASET
+            if (panel.param_count < 4) {
+                panel.params[panel.param_count++] = data[i];
+            }
+            if (panel.param_count == 4) {
+                uint16_t start = panel.params[0] << 8 | panel.params[1];
+                uint16_t end   = panel.params[2] << 8 | panel.params[3];
+                (panel.command == 0x2A ? panel.x0 : panel.y0) = start;
+                (panel.command == 0x2A ? panel.x1 : panel.y1) = end;
+            }
+        } else if (panel.command == 0x2C) { // RAMWR
+            panel.half_pixel[panel.odd_byte] = data[i];
+            panel.odd_byte                   = !panel.odd_byte;
+            if (!panel.odd_byte) {
+                memcpy(&panel.ram[panel.y * SIZE + panel.x], panel.half_pixel, sizeof(uint16_t));
+                if (++panel.x > panel.x1) {
+                    panel.x = panel.x0;
+                    panel.y = panel.y >= panel.y1 ? panel.y0 : panel.y + 1;
+                }
+            }
+        }
+    }
+}
+
+class PainterSurface : public ::testing::Test {
+   protected:
+    // Devices come from fixed size pools, so the display is shared by all tests
+    static painter_device_t display;
+
+    static void SetUpTestSuite() {
+        display = qp_st7789_make_spi_device(SIZE, SIZE, DISPLAY_CS, DISPLAY_DC, DISPLAY_RST, 4, 3);
+    }
+
+    void SetUp() override {
+        spi_mock_set_write_callback(panel_write);
+        ASSERT_TRUE(qp_init(display, QP_ROTATION_0));
+    }
+
+    void TearDown() override {
+        spi_mock_set_write_callback(NULL);
+    }
+
+    uint32_t spi_bytes(std::function<void()> draw) {
+        spi_mock_stats_t stats;
+        spi_mock_reset();
+        draw();
+        spi_mock_get_stats(&stats);
+        return stats.bytes;
+    }
+};
+
+painter_device_t PainterSurface::display;
+
+TEST_F(PainterSurface, DrawsOnlyTheChangedCorners) {
+    std::vector<uint16_t> framebuffer(SIZE * SIZE);
+    painter_device_t      surface = surface_test_make(0, SIZE, SIZE, framebuffer.data());
+    ASSERT_TRUE(qp_rect(surface, 0, 0, SIZE - 1, SIZE - 1, 170, 255, 255, true));
+    ASSERT_TRUE(qp_surface_draw(surface, display, 0, 0, true));
+    ASSERT_EQ(panel.ram, framebuffer);
+
+    // A clock in one corner and a layer indicator in the other
+    ASSERT_TRUE(qp_rect(surface, 4, 4, 27, 19, 0, 255, 255, true));
+    ASSERT_TRUE(qp_rect(surface, 200, 220, 235, 231, 85, 255, 255, true));
+    uint32_t bytes = spi_bytes([&] { EXPECT_TRUE(qp_surface_draw(surface, display, 0, 0, false)); });
+    EXPECT_EQ(panel.ram, framebuffer);
+
+    uint32_t changed        = (24 * 16 + 36 * 12) * sizeof(uint16_t);
+    uint32_t bounding_box   = (235 - 4 + 1) * (231 - 4 + 1) * sizeof(uint16_t);
+    constexpr uint32_t SETUP = 32; // viewport commands and parameters, per rectangle
+    EXPECT_LE(bytes, changed + 2 * SETUP);
+    std::cout << "UI update: " << bytes << " SPI bytes, the bounding box would be " << bounding_box << std::endl;
+}
+
+TEST_F(PainterSurface, MergesOverlappingChanges) {
+    std::vector<uint16_t> framebuffer(SIZE * SIZE);
+    painter_device_t      surface = surface_test_make(0, SIZE, SIZE, framebuffer.data());
+    ASSERT_TRUE(qp_flush(surface));
+    uint16_t rects[SURFACE_DIRTY_RECTS][4];
+
+    ASSERT_TRUE(qp_rect(surface, 10, 10, 20, 20, 0, 255, 255, true));
+    ASSERT_TRUE(qp_rect(surface, 15, 15, 30, 30, 0, 255, 255, true));
+    ASSERT_EQ(surface_test_dirty_rects(surface, rects, SURFACE_DIRTY_RECTS), 1);
+    EXPECT_EQ(std::vector<uint16_t>(rects[0], rects[0] + 4), std::vector<uint16_t>({10, 10, 30, 30}));
+
+    ASSERT_TRUE(qp_rect(surface, 100, 100, 110, 110, 0, 255, 255, true));
+    ASSERT_EQ(surface_test_dirty_rects(surface, rects, SURFACE_DIRTY_RECTS), 2);
+}
+
+// More scattered changes than there are rectangles still all get covered, without any pixel being covered twice
+TEST_F(PainterSurface, ScatteredChangesStayCovered) {
+    std::vector<uint16_t> framebuffer(SIZE * SIZE);
+    painter_device_t      surface = surface_test_make(0, SIZE, SIZE, framebuffer.data());
+    ASSERT_TRUE(qp_surface_draw(surface, display, 0, 0, true));
+
+    std::vector<uint16_t> before = framebuffer;
+    for (uint16_t n = 0; n < 9; n++) {
+        uint16_t x = (n * 97) % 220, y = (n * 53) % 220;
+        ASSERT_TRUE(qp_rect(surface, x, y, x + 5, y + 3, n * 28, 255, 255, true));
+    }
+
+    uint16_t rects[SURFACE_DIRTY_RECTS][4];
+    uint8_t  count = surface_test_dirty_rects(surface, rects, SURFACE_DIRTY_RECTS);
+    ASSERT_LE(count, SURFACE_DIRTY_RECTS);
+    for (uint32_t i = 0; i < framebuffer.size(); i++) {
+        uint16_t x = i % SIZE, y = i / SIZE;
+        int      covered = 0;
+        for (uint8_t r = 0; r < count; r++) {
+            covered += x >= rects[r][0] && y >= rects[r][1] && x <= rects[r][2] && y <= rects[r][3];
+        }
+        EXPECT_LE(covered, 1) << "at " << x << "," << y;
+        if (framebuffer[i] != before[i]) {
+            ASSERT_EQ(covered, 1) << "at " << x << "," << y;
+        }
+    }
+
+    uint32_t bytes = spi_bytes([&] { EXPECT_TRUE(qp_surface_draw(surface, display, 0, 0, false)); });
+    EXPECT_EQ(panel.ram, framebuffer);
+    EXPECT_LT(bytes, SIZE * SIZE * sizeof(uint16_t) / 4);
+}
+
+TEST_F(PainterSurface, LayersComposite) {
+    constexpr uint16_t    OVERLAY = 40, OVERLAY_X = 210, OVERLAY_Y = 100; // hanging off the right edge of the display
+    std::vector<uint16_t> background(SIZE * SIZE), overlay(OVERLAY * OVERLAY);
+    painter_device_t      background_surface = surface_test_make(0, SIZE, SIZE, background.data());
+    painter_device_t      overlay_surface    = surface_test_make(1, OVERLAY, OVERLAY, overlay.data());
+    ASSERT_TRUE(qp_rect(background_surface, 0, 0, SIZE - 1, SIZE - 1, 170, 255, 255, true));
+    ASSERT_TRUE(qp_rect(overlay_surface, 5, 5, 14, 14, 0, 255, 255, true));
+
+    qp_surface_layer_t layers[] = {
+        {.surface = background_surface, .x = 0, .y = 0},
+        {.surface = overlay_surface, .x = OVERLAY_X, .y = OVERLAY_Y, .has_transparent_color = true, .transparent_color = {0, 0, 0}},
+    };
+    auto expected = [&] {
+        std::vector<uint16_t> composite = background;
+        for (uint16_t y = 0; y < OVERLAY; y++) {
+            for (uint16_t x = 0; x < OVERLAY && OVERLAY_X + x < SIZE; x++) {
+                if (overlay[y * OVERLAY + x] != 0) {
+                    composite[(OVERLAY_Y + y) * SIZE + OVERLAY_X + x] = overlay[y * OVERLAY + x];
+                }
+            }
+        }
+        return composite;
+    };
+
+    ASSERT_TRUE(qp_surface_draw_layers(display, layers, 2, true));
+    ASSERT_EQ(panel.ram, expected());
+
+    // Moving the square within the overlay only redraws the overlay's area, with the background showing around it
+    ASSERT_TRUE(qp_rect(overlay_surface, 5, 5, 14, 14, 0, 0, 0, true));
+    ASSERT_TRUE(qp_rect(overlay_surface, 20, 20, 29, 29, 0, 255, 255, true));
+    uint32_t bytes = spi_bytes([&] { EXPECT_TRUE(qp_surface_draw_layers(display, layers, 2, false)); });
+    EXPECT_EQ(panel.ram, expected());
+    EXPECT_LE(bytes, OVERLAY * OVERLAY * sizeof(uint16_t));
+
+    // Nothing changed, nothing sent
+    EXPECT_EQ(spi_bytes([&] { EXPECT_TRUE(qp_surface_draw_layers(display, layers, 2, false)); }), 0);
+}
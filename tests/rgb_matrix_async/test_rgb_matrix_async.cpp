@@ -0,0 +1,91 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "i2c_master.h"
+#include "is31fl3733.h"
+#include "is31fl3733_sim.h"
+#include "background_worker_sim.h"
+#include "timer.h"
+
+extern uint8_t g_pwm_buffer[IS31FL3733_DRIVER_COUNT][192];
+void           rgb_matrix_update_pwm_buffers(void);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+// How long the simulated transfer of a frame takes
+constexpr uint32_t FLUSH_LATENCY = 20;
+
+class RgbMatrixAsync : public TestFixture {
+   protected:
+    void SetUp() override {
+        is31fl3733_sim_attach();
+        background_worker_sim_set_latency(FLUSH_LATENCY);
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_BREATHING);
+    }
+};
+
+TEST_F(RgbMatrixAsync, ScanningIsNotBlockedByFlush) {
+    TestDriver driver;
+    idle_for(100);
+
+    uint32_t start = timer_read32();
+    uint32_t jobs  = background_worker_sim_jobs_run();
+    idle_for(200);
+
+    // Every scan took its own millisecond, none of it was spent waiting for the bus
+    EXPECT_EQ(timer_elapsed32(start), 200);
+    // A new frame is only started once the previous one is out
+    uint32_t frames = background_worker_sim_jobs_run() - jobs;
+    EXPECT_GE(frames, 200 / FLUSH_LATENCY / 2);
+    EXPECT_LE(frames, 200 / FLUSH_LATENCY + 1);
+}
+
+TEST_F(RgbMatrixAsync, KeysAreReportedWhileFrameIsInFlight) {
+    TestDriver driver;
+    KeymapKey  key{0, 1, 1, KC_A};
+    set_keymap({key});
+    idle_for(100);
+
+    // Catch a frame right after it was handed to the worker
+    uint32_t jobs = background_worker_sim_jobs_run();
+    while (background_worker_sim_jobs_run() == jobs) {
+        run_one_scan_loop();
+    }
+    run_one_scan_loop();
+    EXPECT_TRUE(background_worker_busy());
+
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(background_worker_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(RgbMatrixAsync, UpdatePwmBuffersIsSynchronous) {
+    TestDriver driver;
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    idle_for(100);
+
+    rgb_matrix_set_color(5, 1, 2, 3);
+    rgb_matrix_update_pwm_buffers();
+
+    EXPECT_FALSE(background_worker_busy());
+    EXPECT_EQ(is31fl3733_sim_read_pwm(g_is31fl3733_leds[5].r), 1);
+    EXPECT_EQ(is31fl3733_sim_read_pwm(g_is31fl3733_leds[5].g), 2);
+    EXPECT_EQ(is31fl3733_sim_read_pwm(g_is31fl3733_leds[5].b), 3);
+    EXPECT_TRUE(is31fl3733_sim_pwm_matches(g_pwm_buffer[0]));
+}
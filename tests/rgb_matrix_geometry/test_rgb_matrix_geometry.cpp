@@ -0,0 +1,133 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include "test_common.hpp"
+
+extern "C" {
+#include "rgb_matrix.h"
+#include "lib/lib8tion/lib8tion.h"
+
+extern const led_point_t k_rgb_matrix_center;
+extern last_hit_t        g_last_hit_tracker;
+bool                     CYCLE_SPIRAL(effect_params_t *params);
+bool                     SOLID_MULTISPLASH(effect_params_t *params);
+HSV                      SOLID_SPLASH_math(HSV hsv, int16_t dx, int16_t dy, uint8_t dist, uint16_t tick);
+}
+
+static std::array<RGB, RGB_MATRIX_LED_COUNT> leds;
+
+static void set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    leds[index].r = r;
+    leds[index].g = g;
+    leds[index].b = b;
+}
+
+static void set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        set_color(i, r, g, b);
+    }
+}
+
+static void noop(void) {}
+
+extern "C" {
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = noop,
+    .set_color     = set_color,
+    .set_color_all = set_color_all,
+    .flush         = noop,
+};
+
+// Unevenly spaced, so that LEDs land on both sides of cell boundaries. Nothing is further apart
+// than sqrt16() can measure.
+led_config_t g_led_config = {
+    {
+        {0, 1, 2, 3, 4, 5, 6, 7, 8, 9},
+        {10, 11, 12, 13, 14, 15, 16, 17, 18, 19},
+        {20, 21, 22, 23, 24, 25, 26, 27, 28, 29},
+        {30, 31, 32, 33, 34, 35, 36, 37, 38, 39},
+    },
+    {
+        {0, 0},  {20, 3},  {31, 0},  {33, 5},  {64, 0},  {100, 7},  {127, 0},  {128, 2},  {190, 0},  {224, 0},
+        {5, 21}, {24, 30}, {48, 31}, {72, 32}, {96, 33}, {112, 32}, {144, 21}, {168, 25}, {200, 21}, {240, 21},
+        {0, 42}, {30, 42}, {48, 47}, {63, 42}, {96, 64}, {120, 42}, {159, 42}, {160, 42}, {192, 42}, {224, 42},
+        {3, 64}, {24, 64}, {48, 63}, {72, 64}, {95, 60}, {120, 64}, {144, 64}, {168, 64}, {192, 64}, {224, 64},
+    },
+    {
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+    },
+};
+}
+
+class RgbMatrixGeometry : public TestFixture {
+   protected:
+    effect_params_t params = {.iter = 0, .flags = LED_FLAG_ALL, .init = false};
+
+    void SetUp() override {
+        rgb_matrix_sethsv_noeeprom(170, 200, 255);
+        rgb_matrix_set_speed_noeeprom(128);
+    }
+};
+
+TEST_F(RgbMatrixGeometry, MatchesDirectCalculation) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        EXPECT_EQ(rgb_matrix_led_distance(i), sqrt16(dx * dx + dy * dy)) << "LED " << +i;
+        EXPECT_EQ(rgb_matrix_led_angle(i), atan2_8(dy, dx)) << "LED " << +i;
+    }
+}
+
+TEST_F(RgbMatrixGeometry, SpiralIsUnchanged) {
+    for (g_rgb_timer = 0; g_rgb_timer < 5000; g_rgb_timer += 97) {
+        CYCLE_SPIRAL(&params);
+
+        uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            int16_t dx  = g_led_config.point[i].x - k_rgb_matrix_center.x;
+            int16_t dy  = g_led_config.point[i].y - k_rgb_matrix_center.y;
+            HSV     hsv = rgb_matrix_config.hsv;
+            hsv.h       = sqrt16(dx * dx + dy * dy) - time - atan2_8(dy, dx);
+            RGB rgb     = hsv_to_rgb(hsv);
+            ASSERT_EQ(leds[i].r, rgb.r) << "LED " << +i << " at " << g_rgb_timer;
+            ASSERT_EQ(leds[i].g, rgb.g) << "LED " << +i << " at " << g_rgb_timer;
+            ASSERT_EQ(leds[i].b, rgb.b) << "LED " << +i << " at " << g_rgb_timer;
+        }
+    }
+}
+
+TEST_F(RgbMatrixGeometry, SplashOnlyVisitsLedsInReachButLooksTheSame) {
+    const uint8_t hits[][2] = {{0, 0}, {112, 32}, {224, 64}, {31, 33}, {200, 10}, {96, 60}, {240, 64}, {64, 0}};
+
+    for (uint16_t start = 0; start < 800; start += 13) {
+        g_last_hit_tracker.count = LED_HITS_TO_REMEMBER;
+        for (uint8_t j = 0; j < LED_HITS_TO_REMEMBER; j++) {
+            g_last_hit_tracker.x[j]    = hits[j][0];
+            g_last_hit_tracker.y[j]    = hits[j][1];
+            g_last_hit_tracker.tick[j] = start + j * 37;
+        }
+        SOLID_MULTISPLASH(&params);
+
+        // What the runner did before, visiting every LED for every hit
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            HSV hsv = rgb_matrix_config.hsv;
+            hsv.v   = 0;
+            for (uint8_t j = 0; j < g_last_hit_tracker.count; j++) {
+                int16_t  dx   = g_led_config.point[i].x - g_last_hit_tracker.x[j];
+                int16_t  dy   = g_led_config.point[i].y - g_last_hit_tracker.y[j];
+                uint8_t  dist = sqrt16(dx * dx + dy * dy);
+                uint16_t tick = scale16by8(g_last_hit_tracker.tick[j], qadd8(rgb_matrix_config.speed, 1));
+                hsv           = SOLID_SPLASH_math(hsv, dx, dy, dist, tick);
+            }
+            hsv.v   = scale8(hsv.v, rgb_matrix_config.hsv.v);
+            RGB rgb = hsv_to_rgb(hsv);
+            ASSERT_EQ(leds[i].r, rgb.r) << "LED " << +i << " at tick " << start;
+            ASSERT_EQ(leds[i].g, rgb.g) << "LED " << +i << " at tick " << start;
+            ASSERT_EQ(leds[i].b, rgb.b) << "LED " << +i << " at tick " << start;
+        }
+    }
+}
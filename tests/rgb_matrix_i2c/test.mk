@@ -0,0 +1,7 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = is31fl3733
+
+SRC += $(PLATFORM_PATH)/test/drivers/is31fl3733_sim.c
@@ -0,0 +1,135 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <iostream>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "i2c_master.h"
+#include "is31fl3733.h"
+#include "is31fl3733_sim.h"
+
+extern uint8_t g_pwm_buffer[IS31FL3733_DRIVER_COUNT][192];
+void           rgb_matrix_update_pwm_buffers(void);
+}
+
+using testing::_;
+using testing::AnyNumber;
+
+// What a flush cost before dirty tracking: unlocking and selecting the page, then the whole page in 16 byte transfers
+constexpr uint32_t FULL_PAGE_FLUSH_BYTES = 2 * 3 + (192 / 16) * (1 + 1 + 16);
+
+class RgbMatrixI2c : public TestFixture {
+   protected:
+    // The chip keeps its registers between tests, as does the driver's buffer
+    void SetUp() override {
+        is31fl3733_sim_attach();
+        rgb_matrix_sethsv_noeeprom(0, 255, 255);
+    }
+
+    // Runs the effect for a while, returning the bus bytes spent on each frame that was flushed
+    uint32_t bytes_per_frame(const char *name, uint8_t mode, uint32_t ms, KeymapKey *key = nullptr) {
+        rgb_matrix_mode_noeeprom(mode);
+        idle_for(100);
+        rgb_matrix_update_pwm_buffers();
+
+        i2c_mock_reset();
+        is31fl3733_sim_reset_flushes();
+        for (uint32_t t = 0; t < ms; t++) {
+            if (key && t % 250 == 0) {
+                key->press();
+            } else if (key && t % 250 == 50) {
+                key->release();
+            }
+            run_one_scan_loop();
+        }
+        rgb_matrix_update_pwm_buffers();
+
+        i2c_mock_stats_t stats;
+        i2c_mock_get_stats(&stats);
+        EXPECT_TRUE(is31fl3733_sim_pwm_matches(g_pwm_buffer[0])) << "Chip registers do not match the PWM buffer";
+
+        uint32_t flushes   = is31fl3733_sim_flushes();
+        uint32_t per_frame = flushes ? stats.bytes / flushes : 0;
+        std::cout << name << ": " << flushes << " frames, " << stats.transactions << " transactions, " << per_frame << " bytes/frame (full page " << FULL_PAGE_FLUSH_BYTES << ")" << std::endl;
+        return per_frame;
+    }
+};
+
+TEST_F(RgbMatrixI2c, UnchangedFrameIsNotWritten) {
+    TestDriver driver;
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    idle_for(100);
+    rgb_matrix_update_pwm_buffers();
+
+    i2c_mock_reset();
+    idle_for(500);
+    rgb_matrix_update_pwm_buffers();
+
+    i2c_mock_stats_t stats;
+    i2c_mock_get_stats(&stats);
+    EXPECT_EQ(stats.transactions, 0) << "A static effect should not touch the bus";
+}
+
+TEST_F(RgbMatrixI2c, OnlyChangedRegistersAreWritten) {
+    TestDriver driver;
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    idle_for(100);
+    rgb_matrix_update_pwm_buffers();
+    i2c_mock_reset();
+
+    // One LED in the middle of the page, the flush is the page select plus a single 3 register span
+    is31fl3733_set_color(17, 1, 2, 3);
+    rgb_matrix_update_pwm_buffers();
+
+    i2c_mock_stats_t stats;
+    i2c_mock_get_stats(&stats);
+    EXPECT_EQ(stats.transactions, 2 + 3);
+    EXPECT_EQ(stats.bytes, 2 * 3 + 3 * (1 + 1 + 1));
+    EXPECT_EQ(is31fl3733_sim_read_pwm(g_is31fl3733_leds[17].r), 1);
+    EXPECT_EQ(is31fl3733_sim_read_pwm(g_is31fl3733_leds[17].g), 2);
+    EXPECT_EQ(is31fl3733_sim_read_pwm(g_is31fl3733_leds[17].b), 3);
+
+    // Neighbouring LEDs on the same SW lines are merged into one transfer per line
+    i2c_mock_reset();
+    is31fl3733_set_color(20, 4, 5, 6);
+    is31fl3733_set_color(22, 4, 5, 6);
+    rgb_matrix_update_pwm_buffers();
+    i2c_mock_get_stats(&stats);
+    EXPECT_EQ(stats.transactions, 2 + 3);
+    EXPECT_TRUE(is31fl3733_sim_pwm_matches(g_pwm_buffer[0]));
+}
+
+TEST_F(RgbMatrixI2c, FailedFlushIsRetried) {
+    TestDriver driver;
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    idle_for(100);
+    rgb_matrix_update_pwm_buffers();
+
+    // Two separate spans that never reach the chip
+    is31fl3733_set_color(1, 7, 8, 9);
+    is31fl3733_set_color(35, 7, 8, 9);
+    i2c_mock_set_failing(true);
+    rgb_matrix_update_pwm_buffers();
+    i2c_mock_set_failing(false);
+    EXPECT_FALSE(is31fl3733_sim_pwm_matches(g_pwm_buffer[0]));
+
+    // The next flush sends whatever was left unwritten
+    rgb_matrix_update_pwm_buffers();
+    EXPECT_TRUE(is31fl3733_sim_pwm_matches(g_pwm_buffer[0]));
+}
+
+TEST_F(RgbMatrixI2c, Benchmark) {
+    TestDriver driver;
+    KeymapKey  key{0, 3, 1, KC_A};
+    set_keymap({key});
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+
+    EXPECT_LE(bytes_per_frame("breathing", RGB_MATRIX_BREATHING, 1000), FULL_PAGE_FLUSH_BYTES);
+    EXPECT_LE(bytes_per_frame("cycle_left_right", RGB_MATRIX_CYCLE_LEFT_RIGHT, 1000), FULL_PAGE_FLUSH_BYTES);
+    EXPECT_LE(bytes_per_frame("rainbow_beacon", RGB_MATRIX_RAINBOW_BEACON, 1000), FULL_PAGE_FLUSH_BYTES);
+    EXPECT_LT(bytes_per_frame("solid_reactive_simple", RGB_MATRIX_SOLID_REACTIVE_SIMPLE, 1000, &key), FULL_PAGE_FLUSH_BYTES / 4);
+}
@@ -0,0 +1,7 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SPLIT_KEYBOARD = yes
+
+# Rooted at TEST_PATH so the object isn't shared with the other sub-suites
+SRC += $(TEST_PATH)/../test_split_transport.cpp
@@ -0,0 +1,269 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <iostream>
+#include "keyboard_report_util.hpp"
+#include "keycode.h"
+#include "test_common.hpp"
+#include "test_keymap_key.hpp"
+
+extern "C" {
+#include "split_sim.h"
+#include "transactions.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InvokeWithoutArgs;
+
+// Rows 0 and 1 are the master half, rows 2 and 3 the slave half.
+class SplitTransport : public TestFixture {
+   protected:
+    void SetUp() override {
+        split_sim_reset();
+    }
+
+    // The fixture releases every key on destruction, which needs a working link
+    void TearDown() override {
+        split_sim_reset();
+    }
+
+    // Runs scans until the key's press report reaches the host and returns how many
+    // milliseconds that took, or UINT32_MAX if it never arrived.
+    uint32_t press_until_reported(TestDriver &driver, KeymapKey &key, uint16_t max_scans = 100) {
+        uint32_t start    = timer_read32();
+        uint32_t reported = UINT32_MAX;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport(key.code))).WillOnce(InvokeWithoutArgs([&] { reported = timer_read32(); }));
+        key.press();
+        for (uint16_t i = 0; i < max_scans && reported == UINT32_MAX; i++) {
+            run_one_scan_loop();
+        }
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return reported == UINT32_MAX ? reported : reported - start;
+    }
+
+    uint32_t release_until_reported(TestDriver &driver, KeymapKey &key, uint16_t max_scans = 100) {
+        uint32_t start    = timer_read32();
+        uint32_t reported = UINT32_MAX;
+        EXPECT_CALL(driver, send_keyboard_mock(KeyboardReport())).WillOnce(InvokeWithoutArgs([&] { reported = timer_read32(); }));
+        key.release();
+        for (uint16_t i = 0; i < max_scans && reported == UINT32_MAX; i++) {
+            run_one_scan_loop();
+        }
+        testing::Mock::VerifyAndClearExpectations(&driver);
+        return reported == UINT32_MAX ? reported : reported - start;
+    }
+};
+
+TEST_F(SplitTransport, SlaveKeyArrivesOnTheNextScan) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 2, KC_A);
+    set_keymap({key_a});
+
+    // The slave picks up the press after the master has already polled it this scan
+    key_a.press();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_A));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_a.release();
+    EXPECT_NO_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitTransport, MasterKeyIsNotDelayed) {
+    TestDriver driver;
+    KeymapKey  key_b(0, 1, 0, KC_B);
+    set_keymap({key_b});
+
+    key_b.press();
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_b.release();
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitTransport, KeysFromBothHalves) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 2, KC_A);
+    KeymapKey  key_b(0, 1, 1, KC_B);
+    KeymapKey  key_c(0, 9, 3, KC_C);
+    set_keymap({key_a, key_b, key_c});
+
+    key_a.press();
+    key_b.press();
+    key_c.press();
+    EXPECT_REPORT(driver, (KC_B));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_A, KC_B));
+    EXPECT_REPORT(driver, (KC_A, KC_B, KC_C));
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    key_a.release();
+    key_b.release();
+    key_c.release();
+    EXPECT_REPORT(driver, (KC_A, KC_C));
+    run_one_scan_loop();
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitTransport, LayerStateReachesTheSlave) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    layer_on(1);
+    run_one_scan_loop();
+    EXPECT_EQ(split_sim_slave_shmem()->layers.layer_state, (layer_state_t)1 << 1);
+
+    layer_clear();
+    run_one_scan_loop();
+    EXPECT_EQ(split_sim_slave_shmem()->layers.layer_state, (layer_state_t)0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitTransport, LinkTimeAdvancesTheClock) {
+    TestDriver             driver;
+    const split_sim_link_t slow = {.latency_us = 1000};
+    split_sim_stats_t      before, after;
+
+    EXPECT_NO_REPORT(driver);
+    split_sim_set_link(&slow);
+    split_sim_get_stats(&before);
+    uint32_t start = timer_read32();
+    idle_for(50);
+    split_sim_get_stats(&after);
+
+    // Every scan advances the clock by a millisecond, and every transaction by one more
+    EXPECT_GT(after.transactions, before.transactions);
+    EXPECT_EQ(timer_read32() - start, 50 + after.transactions - before.transactions);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SplitTransport, LostBytesAreRetried) {
+    TestDriver             driver;
+    KeymapKey              key_a(0, 0, 2, KC_A);
+    const split_sim_link_t lossy = {.drop_ppm = 50000, .timeout_us = 100, .seed = 12345};
+    split_sim_stats_t      stats;
+    set_keymap({key_a});
+
+    split_sim_set_link(&lossy);
+    uint32_t retries = transactions_master_retries();
+    for (int i = 0; i < 20; i++) {
+        EXPECT_NE(press_until_reported(driver, key_a), UINT32_MAX);
+        EXPECT_NE(release_until_reported(driver, key_a), UINT32_MAX);
+    }
+
+    split_sim_get_stats(&stats);
+    EXPECT_GT(stats.dropped, 0u);
+    EXPECT_GT(transactions_master_retries(), retries);
+}
+
+TEST_F(SplitTransport, CorruptedMatrixIsRejected) {
+    TestDriver             driver;
+    KeymapKey              key_a(0, 0, 2, KC_A);
+    const split_sim_link_t noisy = {.corrupt_ppm = 20000, .seed = 4242};
+    split_sim_stats_t      stats;
+    set_keymap({key_a});
+
+    // Flipped bits must never turn into phantom key presses
+    split_sim_set_link(&noisy);
+    EXPECT_NO_REPORT(driver);
+    idle_for(1000);
+    VERIFY_AND_CLEAR(driver);
+
+    for (int i = 0; i < 20; i++) {
+        EXPECT_NE(press_until_reported(driver, key_a), UINT32_MAX);
+        EXPECT_NE(release_until_reported(driver, key_a), UINT32_MAX);
+    }
+
+    split_sim_get_stats(&stats);
+    EXPECT_GT(stats.corrupted, 0u);
+}
+
+#ifdef SPLIT_SLAVE_MATRIX_EVENTS
+TEST_F(SplitTransport, IdleScansOnlyPollTheEventHeader) {
+    TestDriver        driver;
+    split_sim_stats_t before, after;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    split_sim_get_stats(&before);
+    uint32_t start = timer_read32();
+    idle_for(500);
+    split_sim_get_stats(&after);
+    VERIFY_AND_CLEAR(driver);
+
+    // Without key changes the event queue is never read, only its one byte header
+    EXPECT_LT((after.bytes - before.bytes) / (timer_read32() - start), sizeof(split_slave_matrix_events_sync_t));
+}
+#endif // SPLIT_SLAVE_MATRIX_EVENTS
+
+// Typing on the slave half over links of different quality. Reports bus traffic per scan
+// and how long slave key changes take to reach the host.
+TEST_F(SplitTransport, Benchmark) {
+    TestDriver driver;
+    KeymapKey  key_a(0, 0, 2, KC_A);
+    set_keymap({key_a});
+
+    struct profile {
+        const char      *name;
+        split_sim_link_t link;
+    };
+    const profile profiles[] = {
+        {"ideal", {}},
+        {"usart 460800", {.latency_us = 20, .bytes_per_second = 46080, .timeout_us = 500}},
+        {"bitbang 115200", {.latency_us = 50, .bytes_per_second = 11520, .timeout_us = 500}},
+        {"noisy 115200", {.latency_us = 50, .bytes_per_second = 11520, .drop_ppm = 2000, .corrupt_ppm = 2000, .timeout_us = 500, .seed = 99}},
+    };
+
+    const uint16_t taps = 100, idle = 20;
+    for (const profile &p : profiles) {
+        split_sim_stats_t before, after;
+        uint64_t          latency = 0;
+        uint32_t          worst = 0, lost = 0;
+
+        split_sim_set_link(&p.link);
+        split_sim_get_stats(&before);
+        uint32_t retries = transactions_master_retries();
+        uint32_t start   = timer_read32();
+        for (uint16_t i = 0; i < taps; i++) {
+            uint32_t press   = press_until_reported(driver, key_a);
+            uint32_t release = release_until_reported(driver, key_a);
+            for (uint32_t t : {press, release}) {
+                if (t == UINT32_MAX) {
+                    lost++;
+                } else {
+                    latency += t;
+                    worst = t > worst ? t : worst;
+                }
+            }
+            EXPECT_NO_REPORT(driver);
+            idle_for(idle);
+            VERIFY_AND_CLEAR(driver);
+        }
+        split_sim_get_stats(&after);
+        uint32_t elapsed = timer_read32() - start;
+
+        uint32_t transactions = after.transactions - before.transactions;
+        uint32_t events       = taps * 2 - lost;
+        std::cout << p.name << ": " << (after.bytes - before.bytes) * 1000 / elapsed << " bytes/s, " << transactions * 1000 / elapsed << " transactions/s, " << (after.failed - before.failed) << " failed, " << (transactions_master_retries() - retries) << " retries, key latency avg " << (events ? latency / events : 0) << " ms max " << worst << " ms" << std::endl;
+        EXPECT_EQ(lost, 0u);
+    }
+}
@@ -224,3 +224,63 @@ TEST_F(DefaultTapHold, tap_and_hold_mod_tap_hold_key) {
     run_one_scan_loop();
     VERIFY_AND_CLEAR(driver);
 }
+
+TEST_F(DefaultTapHold, latency_of_tapped_mod_tap_key_within_budget) {
+    TestDriver driver;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       regular_key      = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({mod_tap_hold_key, regular_key});
+
+    /* Regular keys are reported in the scan that saw them. */
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(regular_key);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_LATENCY_WITHIN(LATENCY_PATH_DIRECT, 0);
+
+    /* A tap is only reported once the mod-tap key is released. */
+    EXPECT_REPORT(driver, (KC_P));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(mod_tap_hold_key, TAPPING_TERM / 2);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_LATENCY_WITHIN(LATENCY_PATH_TAP_HOLD, TAPPING_TERM);
+    EXPECT_FALSE(LatencyWithinBudget(LATENCY_PATH_TAP_HOLD, TAPPING_TERM / 2 - 1));
+}
+
+TEST_F(DefaultTapHold, latency_of_key_held_back_by_mod_tap_key_within_budget) {
+    TestDriver driver;
+    InSequence s;
+    auto       mod_tap_hold_key = KeymapKey(0, 1, 0, SFT_T(KC_P));
+    auto       regular_key      = KeymapKey(0, 2, 0, KC_A);
+
+    set_keymap({mod_tap_hold_key, regular_key});
+
+    /* Press mod-tap-hold key, then regular key. */
+    EXPECT_NO_REPORT(driver);
+    mod_tap_hold_key.press();
+    run_one_scan_loop();
+    regular_key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* Both are resolved once the tapping term expires. */
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+    idle_for(TAPPING_TERM);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    regular_key.release();
+    run_one_scan_loop();
+    mod_tap_hold_key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    /* The regular key waited on the mod-tap key, so it is charged to tap-hold. */
+    EXPECT_LATENCY_WITHIN(LATENCY_PATH_TAP_HOLD, TAPPING_TERM);
+    latency_stats_t direct;
+    latency_tracing_get_stats(LATENCY_PATH_DIRECT, &direct);
+    EXPECT_EQ(direct.count, 0);
+}
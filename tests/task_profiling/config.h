@@ -0,0 +1,9 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// The simulated millisecond clock stands in for a cycle counter
+#define TIMESTAMP_GETTER timer_read32()
@@ -0,0 +1,97 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "task_profiling.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+static uint32_t process_record_delay = 0;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    advance_time(process_record_delay);
+    return true;
+}
+
+static uint32_t total_samples(profiled_task_t task) {
+    uint32_t total = 0;
+    for (uint8_t bucket = 0; bucket < TASK_PROFILING_BUCKETS; bucket++) {
+        total += task_profiling_get_bucket(task, bucket);
+    }
+    return total;
+}
+
+class TaskProfiling : public TestFixture {
+   protected:
+    void SetUp() override {
+        process_record_delay = 0;
+        task_profiling_reset();
+    }
+};
+
+TEST_F(TaskProfiling, DurationsAreBucketedByPowersOfTwo) {
+    task_profiling_record(PROFILED_TASK_COMBO, 0);
+    task_profiling_record(PROFILED_TASK_COMBO, 1);
+    task_profiling_record(PROFILED_TASK_COMBO, 2);
+    task_profiling_record(PROFILED_TASK_COMBO, 3);
+    task_profiling_record(PROFILED_TASK_COMBO, 1000);
+
+    EXPECT_EQ(task_profiling_get_bucket(PROFILED_TASK_COMBO, 0), 1);
+    EXPECT_EQ(task_profiling_get_bucket(PROFILED_TASK_COMBO, 1), 1);
+    EXPECT_EQ(task_profiling_get_bucket(PROFILED_TASK_COMBO, 2), 2);
+    EXPECT_EQ(task_profiling_get_bucket(PROFILED_TASK_COMBO, 10), 1);
+    EXPECT_EQ(task_profiling_get_worst(PROFILED_TASK_COMBO), 1000);
+    EXPECT_EQ(total_samples(PROFILED_TASK_TAP_DANCE), 0);
+}
+
+TEST_F(TaskProfiling, LastBucketCollectsLongDurations) {
+    task_profiling_record(PROFILED_TASK_RGB_MATRIX, UINT32_MAX);
+    EXPECT_EQ(task_profiling_get_bucket(PROFILED_TASK_RGB_MATRIX, TASK_PROFILING_BUCKETS - 1), 1);
+    EXPECT_EQ(task_profiling_get_worst(PROFILED_TASK_RGB_MATRIX), UINT32_MAX);
+}
+
+TEST_F(TaskProfiling, ResetClearsHistogramsAndWorstCase) {
+    task_profiling_record(PROFILED_TASK_MATRIX, 42);
+    task_profiling_reset();
+    EXPECT_EQ(total_samples(PROFILED_TASK_MATRIX), 0);
+    EXPECT_EQ(task_profiling_get_worst(PROFILED_TASK_MATRIX), 0);
+}
+
+TEST_F(TaskProfiling, ScanLoopRecordsEachIteration) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+    EXPECT_EQ(total_samples(PROFILED_TASK_MATRIX), 10);
+    EXPECT_EQ(total_samples(PROFILED_TASK_QUANTUM), 10);
+    EXPECT_EQ(task_profiling_get_worst(PROFILED_TASK_MATRIX), 0);
+}
+
+TEST_F(TaskProfiling, SlowKeyProcessingIsChargedToMatrixTask) {
+    TestDriver driver;
+    KeymapKey  key = KeymapKey(0, 0, 0, KC_A);
+    set_keymap({key});
+
+    process_record_delay = 5;
+    EXPECT_REPORT(driver, (KC_A));
+    key.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // 5 ticks fall into [4, 8)
+    EXPECT_EQ(task_profiling_get_bucket(PROFILED_TASK_MATRIX, 3), 1);
+    EXPECT_EQ(task_profiling_get_worst(PROFILED_TASK_MATRIX), 5);
+
+    process_record_delay = 0;
+    EXPECT_EMPTY_REPORT(driver);
+    key.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,25 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gtest/gtest.h"
+
+extern "C" {
+#include "latency_tracing.h"
+}
+
+/* Passes when keys of the given feature path reached the host, all within budget_ms of their scan. */
+inline testing::AssertionResult LatencyWithinBudget(latency_path_t path, uint16_t budget_ms) {
+    latency_stats_t stats;
+    latency_tracing_get_stats(path, &stats);
+    if (stats.count == 0) {
+        return testing::AssertionFailure() << "no key of latency path " << +path << " reached the host";
+    }
+    if (stats.max > budget_ms) {
+        return testing::AssertionFailure() << "latency path " << +path << " took up to " << stats.max << "ms (min " << stats.min << "ms, avg " << stats.avg << "ms, p99 " << stats.p99 << "ms, " << stats.count << " samples), budget is " << budget_ms << "ms";
+    }
+    return testing::AssertionSuccess();
+}
+
+#define EXPECT_LATENCY_WITHIN(path, budget_ms) EXPECT_TRUE(LatencyWithinBudget((path), (budget_ms)))
@@ -18,19 +18,42 @@
 #include "test_matrix.h"
 #include <string.h>
 
+#ifdef SPLIT_KEYBOARD
+#    include "split_util.h"
+#    include "split_sim.h"
+
+#    define ROWS_PER_HAND (MATRIX_ROWS / 2)
+#endif
+
+// Physical key state. On split keyboards the second half of the rows belongs to the slave.
 static matrix_row_t matrix[MATRIX_ROWS] = {};
 
+#ifdef SPLIT_KEYBOARD
+// The slave half as last received by the master
+static matrix_row_t slave_rows[ROWS_PER_HAND] = {};
+#endif
+
 void matrix_init(void) {
     clear_all_keys();
     matrix_init_kb();
 }
 
 uint8_t matrix_scan(void) {
+#ifdef SPLIT_KEYBOARD
+    // The slave scans on its own, so what it publishes now is picked up by the master's next scan
+    transport_master_if_connected(matrix, slave_rows);
+    split_sim_slave_task(&matrix[ROWS_PER_HAND]);
+#endif
     matrix_scan_kb();
     return 1;
 }
 
 matrix_row_t matrix_get_row(uint8_t row) {
+#ifdef SPLIT_KEYBOARD
+    if (row >= ROWS_PER_HAND) {
+        return slave_rows[row - ROWS_PER_HAND];
+    }
+#endif
     return matrix[row];
 }
 
@@ -52,6 +75,19 @@ bool matrix_is_on(uint8_t row, uint8_t col) {
     return (matrix[row] & ((matrix_row_t)1 << col));
 }
 
+#ifdef IDLE_SLEEP_ENABLE
+bool matrix_wakeup_arm(void) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        if (matrix[row]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void matrix_wakeup_disarm(void) {}
+#endif
+
 void clear_all_keys(void) {
     memset(matrix, 0, sizeof(matrix));
 }
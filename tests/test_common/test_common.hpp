@@ -25,3 +25,6 @@ extern "C" {
 #include "test_keymap_key.hpp"
 #include "keyboard_report_util.hpp"
 #include "test_fixture.hpp"
+#ifdef LATENCY_TRACING_ENABLE
+#    include "latency_util.hpp"
+#endif
@@ -22,6 +22,7 @@ extern "C" {
 #include "debug.h"
 #include "eeconfig.h"
 #include "keyboard.h"
+#include "latency_tracing.h"
 
 void set_time(uint32_t t);
 void advance_time(uint32_t ms);
@@ -58,7 +59,11 @@ void TestFixture::TearDownTestCase() {}
 TestFixture::TestFixture() {
     m_this = this;
     timer_clear();
-    test_logger.info() << "tapping term is " << +GET_TAPPING_TERM(KC_TRANSPARENT, &(keyrecord_t){}) << "ms" << std::endl;
+#ifdef LATENCY_TRACING_ENABLE
+    latency_tracing_reset();
+#endif
+    keyrecord_t record = {};
+    test_logger.info() << "tapping term is " << +GET_TAPPING_TERM(KC_TRANSPARENT, &record) << "ms" << std::endl;
 }
 
 TestFixture::~TestFixture() {
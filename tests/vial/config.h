@@ -0,0 +1,12 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+#define EEPROM_SIZE 2048
+#define VIAL_KEYBOARD_UID {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77}
+
+// The simulated millisecond clock stands in for a cycle counter
+#define TIMESTAMP_GETTER timer_read32()
@@ -0,0 +1,13 @@
+# Copyright 2024 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+DYNAMIC_KEYMAP_ENABLE = yes
+VIAL_ENABLE = yes
+VIAL_INSECURE = yes
+TASK_PROFILING_ENABLE = yes
+
+# vial.c includes a header generated from vial.json
+KEYMAP_PATH := $(TEST_PATH)
+INTERMEDIATE_OUTPUT := $(BUILD_DIR)/test_obj/$(TEST_OUTPUT)
+VPATH += $(INTERMEDIATE_OUTPUT)/src
+$(shell mkdir -p $(INTERMEDIATE_OUTPUT)/src)
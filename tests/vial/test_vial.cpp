@@ -0,0 +1,288 @@
+// Copyright 2024 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include "gtest/gtest.h"
+
+extern "C" {
+// vial.h asserts on its entry layouts with the C11 keyword
+#define _Static_assert static_assert
+#include "crc.h"
+#include "dynamic_keymap.h"
+#include "eeconfig.h"
+#include "keycodes.h"
+#include "qmk_settings.h"
+#include "quantum_keycodes.h"
+#include "task_profiling.h"
+#include "vial.h"
+#undef _Static_assert
+}
+
+static std::vector<std::vector<uint8_t>> sent_packets;
+
+extern "C" void raw_hid_send(uint8_t *data, uint8_t length) {
+    sent_packets.emplace_back(data, data + length);
+}
+
+class VialSnapshot : public testing::Test {
+   protected:
+    void SetUp() override {
+        eeconfig_init_quantum();
+        dynamic_keymap_reset();
+        dynamic_keymap_init();
+        vial_unlocked = 1;
+        sent_packets.clear();
+    }
+
+    // Sends one command the way via.c does: the handler's reply is sent after it returns
+    void command(uint8_t *msg) {
+        vial_handle_cmd(msg, VIAL_RAW_EPSIZE);
+        raw_hid_send(msg, VIAL_RAW_EPSIZE);
+    }
+
+    std::vector<uint8_t> state() {
+        std::vector<uint8_t> data(dynamic_keymap_get_state_buffer_size());
+        dynamic_keymap_get_state_buffer(0, data.size(), data.data());
+        return data;
+    }
+
+    // Returns the encoded stream, checking sequence numbers and checksums on the way
+    std::vector<uint8_t> read_snapshot() {
+        uint8_t msg[VIAL_RAW_EPSIZE] = {0xFE, vial_snapshot_op, vial_snapshot_read};
+        sent_packets.clear();
+        command(msg);
+
+        std::vector<uint8_t> stream;
+        for (size_t i = 0; i < sent_packets.size(); i++) {
+            const std::vector<uint8_t> &packet = sent_packets[i];
+            bool                        last   = i == sent_packets.size() - 1;
+            EXPECT_EQ(packet[0] | (packet[1] << 8), i);
+            EXPECT_EQ(!!(packet[2] & VIAL_SNAPSHOT_LAST), last);
+            EXPECT_EQ(packet[VIAL_RAW_EPSIZE - 1], crc8(packet.data(), VIAL_RAW_EPSIZE - 1));
+            uint8_t length = packet[2] & ~VIAL_SNAPSHOT_LAST;
+            stream.insert(stream.end(), packet.begin() + 3, packet.begin() + 3 + length);
+        }
+        return stream;
+    }
+
+    // The stream is made of 16-bit words in stored byte order, an odd trailing byte is padded
+    static std::vector<uint8_t> decode(const std::vector<uint8_t> &stream) {
+        std::vector<uint8_t> data;
+        for (size_t i = 2; i < stream.size();) {
+            uint8_t token = stream[i++];
+            if (token & 0x80) {
+                for (int n = 0; n < (token & 0x7F) + 2; n++) {
+                    data.insert(data.end(), stream.begin() + i, stream.begin() + i + 2);
+                }
+                i += 2;
+            } else {
+                data.insert(data.end(), stream.begin() + i, stream.begin() + i + (token + 1) * 2);
+                i += (token + 1) * 2;
+            }
+        }
+        size_t size = stream[0] | (stream[1] << 8);
+        EXPECT_EQ((size + 1) / 2 * 2, data.size());
+        data.resize(size);
+        return data;
+    }
+
+    static std::vector<uint8_t> encode(std::vector<uint8_t> data) {
+        std::vector<uint8_t> stream = {(uint8_t)(data.size() & 0xFF), (uint8_t)(data.size() >> 8)};
+        if (data.size() % 2) {
+            data.push_back(0);
+        }
+        auto word = [&](size_t w) { return data[w * 2] | (data[w * 2 + 1] << 8); };
+        for (size_t pos = 0, words = data.size() / 2; pos < words;) {
+            size_t run = 1;
+            while (pos + run < words && run < 129 && word(pos + run) == word(pos)) run++;
+            if (run >= 2) {
+                stream.push_back(0x80 | (run - 2));
+                stream.insert(stream.end(), data.begin() + pos * 2, data.begin() + pos * 2 + 2);
+            } else {
+                stream.push_back(0);
+                stream.insert(stream.end(), data.begin() + pos * 2, data.begin() + pos * 2 + 2);
+            }
+            pos += run;
+        }
+        return stream;
+    }
+
+    static std::vector<std::vector<uint8_t>> write_packets(const std::vector<uint8_t> &stream) {
+        const size_t                      payload = VIAL_RAW_EPSIZE - 7;
+        std::vector<std::vector<uint8_t>> packets;
+        for (size_t pos = 0, seq = 0; pos < stream.size(); pos += payload, seq++) {
+            size_t               length = std::min(payload, stream.size() - pos);
+            std::vector<uint8_t> packet(VIAL_RAW_EPSIZE, 0);
+            packet[0] = 0xFE;
+            packet[1] = vial_snapshot_op;
+            packet[2] = vial_snapshot_write_data;
+            packet[3] = seq & 0xFF;
+            packet[4] = seq >> 8;
+            packet[5] = length | (pos + length == stream.size() ? VIAL_SNAPSHOT_LAST : 0);
+            std::copy(stream.begin() + pos, stream.begin() + pos + length, packet.begin() + 6);
+            packet[VIAL_RAW_EPSIZE - 1] = crc8(packet.data(), VIAL_RAW_EPSIZE - 1);
+            packets.push_back(packet);
+        }
+        return packets;
+    }
+
+    uint8_t simple_command(uint8_t op) {
+        uint8_t msg[VIAL_RAW_EPSIZE] = {0xFE, vial_snapshot_op, op};
+        command(msg);
+        return msg[0];
+    }
+
+    // Returns the status of the commit, or of the first rejected packet
+    uint8_t write_snapshot(std::vector<std::vector<uint8_t>> packets) {
+        uint8_t status = simple_command(vial_snapshot_write_begin);
+        for (auto &packet : packets) {
+            if (status != 0) break;
+            command(packet.data());
+            status = packet[0];
+        }
+        uint8_t commit = simple_command(vial_snapshot_write_commit);
+        return status != 0 ? status : commit;
+    }
+};
+
+TEST_F(VialSnapshot, ReadStreamsWholeStateInFewPackets) {
+    dynamic_keymap_set_keycode(1, 2, 3, LT(1, KC_A));
+    std::vector<uint8_t> expected = state();
+
+    std::vector<uint8_t> stream = read_snapshot();
+    EXPECT_EQ(decode(stream), expected);
+
+    // One request, versus one round trip per 28 bytes with the buffer commands
+    size_t buffer_round_trips = (expected.size() + 27) / 28;
+    EXPECT_LT(sent_packets.size(), buffer_round_trips / 3);
+}
+
+TEST_F(VialSnapshot, WriteAppliesWholeState) {
+    std::vector<uint8_t> data = decode(read_snapshot());
+
+    // Layer 1, row 2, column 3, stored big-endian
+    size_t offset    = (1 * MATRIX_ROWS * MATRIX_COLS + 2 * MATRIX_COLS + 3) * 2;
+    data[offset]     = LT(1, KC_A) >> 8;
+    data[offset + 1] = LT(1, KC_A) & 0xFF;
+    // First macro spells "ab", the buffer stays zero terminated
+    size_t macros = data.size() - dynamic_keymap_macro_get_buffer_size();
+    data[macros]     = 'a';
+    data[macros + 1] = 'b';
+
+    EXPECT_EQ(write_snapshot(write_packets(encode(data))), 0);
+    EXPECT_EQ(state(), data);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, 3), LT(1, KC_A));
+}
+
+TEST_F(VialSnapshot, WriteAppliesTapDance) {
+    std::vector<uint8_t>   data = decode(read_snapshot());
+    vial_tap_dance_entry_t td   = {KC_A, KC_B, KC_C, KC_D, 150};
+
+    // Tap dance entries follow the keymap and the QMK settings
+    size_t offset = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2 + sizeof(qmk_settings_t);
+    memcpy(&data[offset], &td, sizeof(td));
+    EXPECT_EQ(write_snapshot(write_packets(encode(data))), 0);
+
+    vial_tap_dance_entry_t stored;
+    EXPECT_EQ(dynamic_keymap_get_tap_dance(0, &stored), 0);
+    EXPECT_EQ(memcmp(&stored, &td, sizeof(td)), 0);
+}
+
+TEST_F(VialSnapshot, TransparentLayersCompressAsWords) {
+    size_t empty_size = read_snapshot().size();
+    for (uint8_t layer = 1; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                dynamic_keymap_set_keycode(layer, row, col, KC_TRANSPARENT);
+            }
+        }
+    }
+
+    // KC_TRNS is 00 01 in EEPROM, the layers are a handful of word runs rather than literal bytes
+    std::vector<uint8_t> stream = read_snapshot();
+    EXPECT_EQ(decode(stream), state());
+    EXPECT_LT(stream.size(), empty_size + 32);
+}
+
+TEST_F(VialSnapshot, WriteFitsKeymapThatDoesNotCompress) {
+    std::vector<uint8_t> data = decode(read_snapshot());
+
+    // Every key on every layer differs from its neighbours
+    for (size_t i = 0; i < DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS; i++) {
+        uint16_t keycode = KC_A + i % 26 + (i / 26) * 0x100;
+        data[i * 2]      = keycode >> 8;
+        data[i * 2 + 1]  = keycode & 0xFF;
+    }
+
+    std::vector<uint8_t> stream = encode(data);
+    EXPECT_GT(stream.size(), DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2);
+    EXPECT_EQ(write_snapshot(write_packets(stream)), 0);
+    EXPECT_EQ(state(), data);
+}
+
+TEST_F(VialSnapshot, CorruptPacketAbortsWrite) {
+    std::vector<uint8_t> before = state();
+    std::vector<uint8_t> data   = before;
+    data[0]                     = 0xAA;
+
+    std::vector<std::vector<uint8_t>> packets = write_packets(encode(data));
+    packets[0][6] ^= 0x01;
+    EXPECT_NE(write_snapshot(packets), 0);
+    EXPECT_EQ(state(), before);
+}
+
+TEST_F(VialSnapshot, MissingPacketAbortsWrite) {
+    std::vector<uint8_t> before = state();
+    std::vector<uint8_t> data   = before;
+    data[0]                     = 0xAA;
+
+    std::vector<std::vector<uint8_t>> packets = write_packets(encode(data));
+    ASSERT_GT(packets.size(), 2u);
+    packets.erase(packets.begin() + 1);
+    EXPECT_NE(write_snapshot(packets), 0);
+    EXPECT_EQ(state(), before);
+}
+
+TEST_F(VialSnapshot, TruncatedStreamIsNotApplied) {
+    std::vector<uint8_t> before = state();
+    std::vector<uint8_t> data   = before;
+    data[0]                     = 0xAA;
+    data.resize(data.size() - 2);
+
+    // The header still announces the full size, the tokens come up one word short
+    std::vector<uint8_t> stream = encode(data);
+    stream[0]                   = before.size() & 0xFF;
+    stream[1]                   = before.size() >> 8;
+    EXPECT_NE(write_snapshot(write_packets(stream)), 0);
+    EXPECT_EQ(state(), before);
+}
+
+TEST_F(VialSnapshot, LockedKeyboardRejectsWrite) {
+    std::vector<uint8_t> before = state();
+    std::vector<uint8_t> data   = before;
+    data[0]                     = 0xAA;
+
+    vial_unlocked = 0;
+    EXPECT_NE(write_snapshot(write_packets(encode(data))), 0);
+    vial_unlocked = 1;
+    EXPECT_EQ(state(), before);
+}
+
+TEST(VialTaskProfiling, QueryReturnsHistogram) {
+    task_profiling_reset();
+    task_profiling_record(PROFILED_TASK_COMBO, 300);
+    task_profiling_record(PROFILED_TASK_COMBO, 5);
+
+    uint8_t info[VIAL_RAW_EPSIZE] = {0xFE, vial_task_profiling_op, vial_task_profiling_get_info};
+    vial_handle_cmd(info, VIAL_RAW_EPSIZE);
+    EXPECT_EQ(info[0], PROFILED_TASK_COUNT);
+    EXPECT_EQ(info[1], TASK_PROFILING_BUCKETS);
+
+    // 5 ticks land in bucket 3, 300 ticks in bucket 9
+    uint8_t msg[VIAL_RAW_EPSIZE] = {0xFE, vial_task_profiling_op, vial_task_profiling_get, PROFILED_TASK_COMBO, 2};
+    vial_handle_cmd(msg, VIAL_RAW_EPSIZE);
+    EXPECT_EQ(msg[0] | (msg[1] << 8) | (msg[2] << 16) | (msg[3] << 24), 300);
+    EXPECT_EQ(msg[4] | (msg[5] << 8), 0);
+    EXPECT_EQ(msg[6] | (msg[7] << 8), 1);
+    EXPECT_EQ(msg[18] | (msg[19] << 8), 1);
+}
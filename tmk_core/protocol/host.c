@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "host.h"
 #include "util.h"
 #include "debug.h"
+#include "latency_tracing.h"
 
 #ifdef DIGITIZER_ENABLE
 #    include "digitizer.h"
@@ -73,6 +74,10 @@ led_t host_keyboard_led_state(void) {
 
 /* send report */
 void host_keyboard_send(report_keyboard_t *report) {
+#ifdef LATENCY_TRACING_ENABLE
+    latency_tracing_report_sent(report->mods);
+#endif
+
 #ifdef BLUETOOTH_ENABLE
     if (where_to_send() == OUTPUT_BLUETOOTH) {
         bluetooth_send_keyboard(report);
@@ -96,6 +101,10 @@ void host_keyboard_send(report_keyboard_t *report) {
 }
 
 void host_nkro_send(report_nkro_t *report) {
+#ifdef LATENCY_TRACING_ENABLE
+    latency_tracing_report_sent(report->mods);
+#endif
+
     if (!driver) return;
     report->report_id = REPORT_ID_NKRO;
     (*driver->send_nkro)(report);
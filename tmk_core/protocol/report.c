@@ -19,6 +19,7 @@
 #include "host.h"
 #include "keycode_config.h"
 #include "debug.h"
+#include "latency_tracing.h"
 #include "util.h"
 #include <string.h>
 
@@ -242,6 +243,9 @@ void del_key_bit(report_nkro_t* nkro_report, uint8_t code) {
  * FIXME: Needs doc
  */
 void add_key_to_report(uint8_t key) {
+#ifdef LATENCY_TRACING_ENABLE
+    latency_tracing_key_added(key);
+#endif
 #ifdef NKRO_ENABLE
     if (keyboard_protocol && keymap_config.nkro) {
         add_key_bit(nkro_report, key);